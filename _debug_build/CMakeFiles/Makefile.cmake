@@ -0,0 +1,127 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/repo/CMakeLists.txt"
+  "CMakeFiles/3.25.1/CMakeCCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "/root/repo/example/CMakeLists.txt"
+  "/root/repo/gg_lib/CMakeLists.txt"
+  "/root/repo/test/CMakeLists.txt"
+  "/usr/lib/x86_64-linux-gnu/cmake/GTest/GMockTargets-none.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/GTest/GMockTargets.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/GTest/GTestConfig.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/GTest/GTestConfigVersion.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/GTest/GTestTargets-none.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/GTest/GTestTargets.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/benchmark/benchmarkConfig.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/benchmark/benchmarkConfigVersion.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/benchmark/benchmarkTargets-none.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/benchmark/benchmarkTargets.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeFindDependencyMacro.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFile.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckLibraryExists.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/FindGTest.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageHandleStandardArgs.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageMessage.cmake"
+  "/usr/share/cmake-3.25/Modules/FindThreads.cmake"
+  "/usr/share/cmake-3.25/Modules/GoogleTest.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  "gg_lib/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "example/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "gg_lib/CMakeFiles/gg_lib.dir/DependInfo.cmake"
+  "example/CMakeFiles/LoggingExample.dir/DependInfo.cmake"
+  "example/CMakeFiles/AsyncLogging.dir/DependInfo.cmake"
+  "example/CMakeFiles/EchoServerExample.dir/DependInfo.cmake"
+  "example/CMakeFiles/TimerQueueExample.dir/DependInfo.cmake"
+  "example/CMakeFiles/HttpServerExample.dir/DependInfo.cmake"
+  "test/CMakeFiles/NumStringBench.dir/DependInfo.cmake"
+  "test/CMakeFiles/FixedBufferBench.dir/DependInfo.cmake"
+  "test/CMakeFiles/TimestampBench.dir/DependInfo.cmake"
+  "test/CMakeFiles/ConnectionRateBench.dir/DependInfo.cmake"
+  "test/CMakeFiles/FunctorBench.dir/DependInfo.cmake"
+  "test/CMakeFiles/IdleMemoryBench.dir/DependInfo.cmake"
+  "test/CMakeFiles/LocalRpcBench.dir/DependInfo.cmake"
+  "test/CMakeFiles/PlacementBench.dir/DependInfo.cmake"
+  "test/CMakeFiles/QueueInLoopBench.dir/DependInfo.cmake"
+  "test/CMakeFiles/ShmRingBench.dir/DependInfo.cmake"
+  "test/CMakeFiles/ReadBudgetBench.dir/DependInfo.cmake"
+  "test/CMakeFiles/PollerBench.dir/DependInfo.cmake"
+  "test/CMakeFiles/TimerQueueBench.dir/DependInfo.cmake"
+  "test/CMakeFiles/UdpBench.dir/DependInfo.cmake"
+  "test/CMakeFiles/ZeroCopyBench.dir/DependInfo.cmake"
+  "test/CMakeFiles/AnyTest.dir/DependInfo.cmake"
+  "test/CMakeFiles/BlockingQueueTest.dir/DependInfo.cmake"
+  "test/CMakeFiles/CpuAffinityTest.dir/DependInfo.cmake"
+  "test/CMakeFiles/DateTest.dir/DependInfo.cmake"
+  "test/CMakeFiles/FixedBufferTest.dir/DependInfo.cmake"
+  "test/CMakeFiles/LogStreamTest.dir/DependInfo.cmake"
+  "test/CMakeFiles/MpscQueueTest.dir/DependInfo.cmake"
+  "test/CMakeFiles/ShmRingTest.dir/DependInfo.cmake"
+  "test/CMakeFiles/SlabPoolTest.dir/DependInfo.cmake"
+  "test/CMakeFiles/SlotMapTest.dir/DependInfo.cmake"
+  "test/CMakeFiles/SmallFunctionTest.dir/DependInfo.cmake"
+  "test/CMakeFiles/TimestampTest.dir/DependInfo.cmake"
+  "test/CMakeFiles/BufferTest.dir/DependInfo.cmake"
+  "test/CMakeFiles/BusyPollTest.dir/DependInfo.cmake"
+  "test/CMakeFiles/ChainBufferTest.dir/DependInfo.cmake"
+  "test/CMakeFiles/ChannelTableTest.dir/DependInfo.cmake"
+  "test/CMakeFiles/HttpServerTest.dir/DependInfo.cmake"
+  "test/CMakeFiles/IoUringPollerTest.dir/DependInfo.cmake"
+  "test/CMakeFiles/KeepAlivePoolTest.dir/DependInfo.cmake"
+  "test/CMakeFiles/ShmRingReaderTest.dir/DependInfo.cmake"
+  "test/CMakeFiles/TcpClientTest.dir/DependInfo.cmake"
+  "test/CMakeFiles/TcpConnectionTest.dir/DependInfo.cmake"
+  "test/CMakeFiles/TcpServerTest.dir/DependInfo.cmake"
+  "test/CMakeFiles/UdpSocketTest.dir/DependInfo.cmake"
+  "test/CMakeFiles/UnixSocketTest.dir/DependInfo.cmake"
+  "test/CMakeFiles/WheelTimerQueueTest.dir/DependInfo.cmake"
+  "test/CMakeFiles/ThreadTest.dir/DependInfo.cmake"
+  "test/CMakeFiles/ThreadPoolTest.dir/DependInfo.cmake"
+  "test/CMakeFiles/WeakCallbackTest.dir/DependInfo.cmake"
+  "test/CMakeFiles/AcceptorTest.dir/DependInfo.cmake"
+  "test/CMakeFiles/EventLoopTest.dir/DependInfo.cmake"
+  "test/CMakeFiles/EventLoopThreadPoolTest.dir/DependInfo.cmake"
+  "test/CMakeFiles/EventLoopThreadTest.dir/DependInfo.cmake"
+  "test/CMakeFiles/TimerQueueTest.dir/DependInfo.cmake"
+  )
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "AsyncLogging"
+  "AsyncLogging.pdb"
+  "CMakeFiles/AsyncLogging.dir/simple/AsyncLogging.cc.o"
+  "CMakeFiles/AsyncLogging.dir/simple/AsyncLogging.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/AsyncLogging.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/EchoServerExample.dir/simple/EchoServerExample.cc.o"
+  "CMakeFiles/EchoServerExample.dir/simple/EchoServerExample.cc.o.d"
+  "EchoServerExample"
+  "EchoServerExample.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/EchoServerExample.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/HttpServerExample.dir/simple/HttpServerExample.cc.o"
+  "CMakeFiles/HttpServerExample.dir/simple/HttpServerExample.cc.o.d"
+  "HttpServerExample"
+  "HttpServerExample.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/HttpServerExample.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/LoggingExample.dir/simple/LoggingExample.cc.o"
+  "CMakeFiles/LoggingExample.dir/simple/LoggingExample.cc.o.d"
+  "LoggingExample"
+  "LoggingExample.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/LoggingExample.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/TimerQueueExample.dir/simple/TimerQueueExample.cc.o"
+  "CMakeFiles/TimerQueueExample.dir/simple/TimerQueueExample.cc.o.d"
+  "TimerQueueExample"
+  "TimerQueueExample.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/TimerQueueExample.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,60 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/gg_lib/AsyncLogging.cc" "gg_lib/CMakeFiles/gg_lib.dir/AsyncLogging.cc.o" "gcc" "gg_lib/CMakeFiles/gg_lib.dir/AsyncLogging.cc.o.d"
+  "/root/repo/gg_lib/CountDownLatch.cc" "gg_lib/CMakeFiles/gg_lib.dir/CountDownLatch.cc.o" "gcc" "gg_lib/CMakeFiles/gg_lib.dir/CountDownLatch.cc.o.d"
+  "/root/repo/gg_lib/CpuAffinity.cc" "gg_lib/CMakeFiles/gg_lib.dir/CpuAffinity.cc.o" "gcc" "gg_lib/CMakeFiles/gg_lib.dir/CpuAffinity.cc.o.d"
+  "/root/repo/gg_lib/Date.cc" "gg_lib/CMakeFiles/gg_lib.dir/Date.cc.o" "gcc" "gg_lib/CMakeFiles/gg_lib.dir/Date.cc.o.d"
+  "/root/repo/gg_lib/FileUtil.cc" "gg_lib/CMakeFiles/gg_lib.dir/FileUtil.cc.o" "gcc" "gg_lib/CMakeFiles/gg_lib.dir/FileUtil.cc.o.d"
+  "/root/repo/gg_lib/LogStream.cc" "gg_lib/CMakeFiles/gg_lib.dir/LogStream.cc.o" "gcc" "gg_lib/CMakeFiles/gg_lib.dir/LogStream.cc.o.d"
+  "/root/repo/gg_lib/Logging.cc" "gg_lib/CMakeFiles/gg_lib.dir/Logging.cc.o" "gcc" "gg_lib/CMakeFiles/gg_lib.dir/Logging.cc.o.d"
+  "/root/repo/gg_lib/ShmRing.cc" "gg_lib/CMakeFiles/gg_lib.dir/ShmRing.cc.o" "gcc" "gg_lib/CMakeFiles/gg_lib.dir/ShmRing.cc.o.d"
+  "/root/repo/gg_lib/SlabPool.cc" "gg_lib/CMakeFiles/gg_lib.dir/SlabPool.cc.o" "gcc" "gg_lib/CMakeFiles/gg_lib.dir/SlabPool.cc.o.d"
+  "/root/repo/gg_lib/ThreadHelper.cc" "gg_lib/CMakeFiles/gg_lib.dir/ThreadHelper.cc.o" "gcc" "gg_lib/CMakeFiles/gg_lib.dir/ThreadHelper.cc.o.d"
+  "/root/repo/gg_lib/ThreadPool.cc" "gg_lib/CMakeFiles/gg_lib.dir/ThreadPool.cc.o" "gcc" "gg_lib/CMakeFiles/gg_lib.dir/ThreadPool.cc.o.d"
+  "/root/repo/gg_lib/TimeZone.cc" "gg_lib/CMakeFiles/gg_lib.dir/TimeZone.cc.o" "gcc" "gg_lib/CMakeFiles/gg_lib.dir/TimeZone.cc.o.d"
+  "/root/repo/gg_lib/Timestamp.cc" "gg_lib/CMakeFiles/gg_lib.dir/Timestamp.cc.o" "gcc" "gg_lib/CMakeFiles/gg_lib.dir/Timestamp.cc.o.d"
+  "/root/repo/gg_lib/net/Acceptor.cc" "gg_lib/CMakeFiles/gg_lib.dir/net/Acceptor.cc.o" "gcc" "gg_lib/CMakeFiles/gg_lib.dir/net/Acceptor.cc.o.d"
+  "/root/repo/gg_lib/net/Buffer.cc" "gg_lib/CMakeFiles/gg_lib.dir/net/Buffer.cc.o" "gcc" "gg_lib/CMakeFiles/gg_lib.dir/net/Buffer.cc.o.d"
+  "/root/repo/gg_lib/net/ChainBuffer.cc" "gg_lib/CMakeFiles/gg_lib.dir/net/ChainBuffer.cc.o" "gcc" "gg_lib/CMakeFiles/gg_lib.dir/net/ChainBuffer.cc.o.d"
+  "/root/repo/gg_lib/net/Channel.cc" "gg_lib/CMakeFiles/gg_lib.dir/net/Channel.cc.o" "gcc" "gg_lib/CMakeFiles/gg_lib.dir/net/Channel.cc.o.d"
+  "/root/repo/gg_lib/net/Connector.cc" "gg_lib/CMakeFiles/gg_lib.dir/net/Connector.cc.o" "gcc" "gg_lib/CMakeFiles/gg_lib.dir/net/Connector.cc.o.d"
+  "/root/repo/gg_lib/net/EventLoop.cc" "gg_lib/CMakeFiles/gg_lib.dir/net/EventLoop.cc.o" "gcc" "gg_lib/CMakeFiles/gg_lib.dir/net/EventLoop.cc.o.d"
+  "/root/repo/gg_lib/net/EventLoopThread.cc" "gg_lib/CMakeFiles/gg_lib.dir/net/EventLoopThread.cc.o" "gcc" "gg_lib/CMakeFiles/gg_lib.dir/net/EventLoopThread.cc.o.d"
+  "/root/repo/gg_lib/net/EventLoopThreadPool.cc" "gg_lib/CMakeFiles/gg_lib.dir/net/EventLoopThreadPool.cc.o" "gcc" "gg_lib/CMakeFiles/gg_lib.dir/net/EventLoopThreadPool.cc.o.d"
+  "/root/repo/gg_lib/net/IdleReaper.cc" "gg_lib/CMakeFiles/gg_lib.dir/net/IdleReaper.cc.o" "gcc" "gg_lib/CMakeFiles/gg_lib.dir/net/IdleReaper.cc.o.d"
+  "/root/repo/gg_lib/net/KeepAlivePool.cc" "gg_lib/CMakeFiles/gg_lib.dir/net/KeepAlivePool.cc.o" "gcc" "gg_lib/CMakeFiles/gg_lib.dir/net/KeepAlivePool.cc.o.d"
+  "/root/repo/gg_lib/net/Poller.cc" "gg_lib/CMakeFiles/gg_lib.dir/net/Poller.cc.o" "gcc" "gg_lib/CMakeFiles/gg_lib.dir/net/Poller.cc.o.d"
+  "/root/repo/gg_lib/net/ShmRingReader.cc" "gg_lib/CMakeFiles/gg_lib.dir/net/ShmRingReader.cc.o" "gcc" "gg_lib/CMakeFiles/gg_lib.dir/net/ShmRingReader.cc.o.d"
+  "/root/repo/gg_lib/net/ShmRingWriter.cc" "gg_lib/CMakeFiles/gg_lib.dir/net/ShmRingWriter.cc.o" "gcc" "gg_lib/CMakeFiles/gg_lib.dir/net/ShmRingWriter.cc.o.d"
+  "/root/repo/gg_lib/net/SocketsHelper.cc" "gg_lib/CMakeFiles/gg_lib.dir/net/SocketsHelper.cc.o" "gcc" "gg_lib/CMakeFiles/gg_lib.dir/net/SocketsHelper.cc.o.d"
+  "/root/repo/gg_lib/net/TcpClient.cc" "gg_lib/CMakeFiles/gg_lib.dir/net/TcpClient.cc.o" "gcc" "gg_lib/CMakeFiles/gg_lib.dir/net/TcpClient.cc.o.d"
+  "/root/repo/gg_lib/net/TcpConnection.cc" "gg_lib/CMakeFiles/gg_lib.dir/net/TcpConnection.cc.o" "gcc" "gg_lib/CMakeFiles/gg_lib.dir/net/TcpConnection.cc.o.d"
+  "/root/repo/gg_lib/net/TcpServer.cc" "gg_lib/CMakeFiles/gg_lib.dir/net/TcpServer.cc.o" "gcc" "gg_lib/CMakeFiles/gg_lib.dir/net/TcpServer.cc.o.d"
+  "/root/repo/gg_lib/net/TimerQueue.cc" "gg_lib/CMakeFiles/gg_lib.dir/net/TimerQueue.cc.o" "gcc" "gg_lib/CMakeFiles/gg_lib.dir/net/TimerQueue.cc.o.d"
+  "/root/repo/gg_lib/net/UdpServer.cc" "gg_lib/CMakeFiles/gg_lib.dir/net/UdpServer.cc.o" "gcc" "gg_lib/CMakeFiles/gg_lib.dir/net/UdpServer.cc.o.d"
+  "/root/repo/gg_lib/net/UdpSocket.cc" "gg_lib/CMakeFiles/gg_lib.dir/net/UdpSocket.cc.o" "gcc" "gg_lib/CMakeFiles/gg_lib.dir/net/UdpSocket.cc.o.d"
+  "/root/repo/gg_lib/net/http/HttpContext.cc" "gg_lib/CMakeFiles/gg_lib.dir/net/http/HttpContext.cc.o" "gcc" "gg_lib/CMakeFiles/gg_lib.dir/net/http/HttpContext.cc.o.d"
+  "/root/repo/gg_lib/net/http/HttpResponse.cc" "gg_lib/CMakeFiles/gg_lib.dir/net/http/HttpResponse.cc.o" "gcc" "gg_lib/CMakeFiles/gg_lib.dir/net/http/HttpResponse.cc.o.d"
+  "/root/repo/gg_lib/net/http/HttpServer.cc" "gg_lib/CMakeFiles/gg_lib.dir/net/http/HttpServer.cc.o" "gcc" "gg_lib/CMakeFiles/gg_lib.dir/net/http/HttpServer.cc.o.d"
+  "/root/repo/gg_lib/net/poller/DefaultPoller.cc" "gg_lib/CMakeFiles/gg_lib.dir/net/poller/DefaultPoller.cc.o" "gcc" "gg_lib/CMakeFiles/gg_lib.dir/net/poller/DefaultPoller.cc.o.d"
+  "/root/repo/gg_lib/net/poller/EPollPoller.cc" "gg_lib/CMakeFiles/gg_lib.dir/net/poller/EPollPoller.cc.o" "gcc" "gg_lib/CMakeFiles/gg_lib.dir/net/poller/EPollPoller.cc.o.d"
+  "/root/repo/gg_lib/net/poller/IoUringPoller.cc" "gg_lib/CMakeFiles/gg_lib.dir/net/poller/IoUringPoller.cc.o" "gcc" "gg_lib/CMakeFiles/gg_lib.dir/net/poller/IoUringPoller.cc.o.d"
+  "/root/repo/gg_lib/net/poller/PollPoller.cc" "gg_lib/CMakeFiles/gg_lib.dir/net/poller/PollPoller.cc.o" "gcc" "gg_lib/CMakeFiles/gg_lib.dir/net/poller/PollPoller.cc.o.d"
+  "/root/repo/gg_lib/net/timer/HeapTimerQueue.cc" "gg_lib/CMakeFiles/gg_lib.dir/net/timer/HeapTimerQueue.cc.o" "gcc" "gg_lib/CMakeFiles/gg_lib.dir/net/timer/HeapTimerQueue.cc.o.d"
+  "/root/repo/gg_lib/net/timer/WheelTimerQueue.cc" "gg_lib/CMakeFiles/gg_lib.dir/net/timer/WheelTimerQueue.cc.o" "gcc" "gg_lib/CMakeFiles/gg_lib.dir/net/timer/WheelTimerQueue.cc.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,93 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/gg_lib.dir/AsyncLogging.cc.o"
+  "CMakeFiles/gg_lib.dir/AsyncLogging.cc.o.d"
+  "CMakeFiles/gg_lib.dir/CountDownLatch.cc.o"
+  "CMakeFiles/gg_lib.dir/CountDownLatch.cc.o.d"
+  "CMakeFiles/gg_lib.dir/CpuAffinity.cc.o"
+  "CMakeFiles/gg_lib.dir/CpuAffinity.cc.o.d"
+  "CMakeFiles/gg_lib.dir/Date.cc.o"
+  "CMakeFiles/gg_lib.dir/Date.cc.o.d"
+  "CMakeFiles/gg_lib.dir/FileUtil.cc.o"
+  "CMakeFiles/gg_lib.dir/FileUtil.cc.o.d"
+  "CMakeFiles/gg_lib.dir/LogStream.cc.o"
+  "CMakeFiles/gg_lib.dir/LogStream.cc.o.d"
+  "CMakeFiles/gg_lib.dir/Logging.cc.o"
+  "CMakeFiles/gg_lib.dir/Logging.cc.o.d"
+  "CMakeFiles/gg_lib.dir/ShmRing.cc.o"
+  "CMakeFiles/gg_lib.dir/ShmRing.cc.o.d"
+  "CMakeFiles/gg_lib.dir/SlabPool.cc.o"
+  "CMakeFiles/gg_lib.dir/SlabPool.cc.o.d"
+  "CMakeFiles/gg_lib.dir/ThreadHelper.cc.o"
+  "CMakeFiles/gg_lib.dir/ThreadHelper.cc.o.d"
+  "CMakeFiles/gg_lib.dir/ThreadPool.cc.o"
+  "CMakeFiles/gg_lib.dir/ThreadPool.cc.o.d"
+  "CMakeFiles/gg_lib.dir/TimeZone.cc.o"
+  "CMakeFiles/gg_lib.dir/TimeZone.cc.o.d"
+  "CMakeFiles/gg_lib.dir/Timestamp.cc.o"
+  "CMakeFiles/gg_lib.dir/Timestamp.cc.o.d"
+  "CMakeFiles/gg_lib.dir/net/Acceptor.cc.o"
+  "CMakeFiles/gg_lib.dir/net/Acceptor.cc.o.d"
+  "CMakeFiles/gg_lib.dir/net/Buffer.cc.o"
+  "CMakeFiles/gg_lib.dir/net/Buffer.cc.o.d"
+  "CMakeFiles/gg_lib.dir/net/ChainBuffer.cc.o"
+  "CMakeFiles/gg_lib.dir/net/ChainBuffer.cc.o.d"
+  "CMakeFiles/gg_lib.dir/net/Channel.cc.o"
+  "CMakeFiles/gg_lib.dir/net/Channel.cc.o.d"
+  "CMakeFiles/gg_lib.dir/net/Connector.cc.o"
+  "CMakeFiles/gg_lib.dir/net/Connector.cc.o.d"
+  "CMakeFiles/gg_lib.dir/net/EventLoop.cc.o"
+  "CMakeFiles/gg_lib.dir/net/EventLoop.cc.o.d"
+  "CMakeFiles/gg_lib.dir/net/EventLoopThread.cc.o"
+  "CMakeFiles/gg_lib.dir/net/EventLoopThread.cc.o.d"
+  "CMakeFiles/gg_lib.dir/net/EventLoopThreadPool.cc.o"
+  "CMakeFiles/gg_lib.dir/net/EventLoopThreadPool.cc.o.d"
+  "CMakeFiles/gg_lib.dir/net/IdleReaper.cc.o"
+  "CMakeFiles/gg_lib.dir/net/IdleReaper.cc.o.d"
+  "CMakeFiles/gg_lib.dir/net/KeepAlivePool.cc.o"
+  "CMakeFiles/gg_lib.dir/net/KeepAlivePool.cc.o.d"
+  "CMakeFiles/gg_lib.dir/net/Poller.cc.o"
+  "CMakeFiles/gg_lib.dir/net/Poller.cc.o.d"
+  "CMakeFiles/gg_lib.dir/net/ShmRingReader.cc.o"
+  "CMakeFiles/gg_lib.dir/net/ShmRingReader.cc.o.d"
+  "CMakeFiles/gg_lib.dir/net/ShmRingWriter.cc.o"
+  "CMakeFiles/gg_lib.dir/net/ShmRingWriter.cc.o.d"
+  "CMakeFiles/gg_lib.dir/net/SocketsHelper.cc.o"
+  "CMakeFiles/gg_lib.dir/net/SocketsHelper.cc.o.d"
+  "CMakeFiles/gg_lib.dir/net/TcpClient.cc.o"
+  "CMakeFiles/gg_lib.dir/net/TcpClient.cc.o.d"
+  "CMakeFiles/gg_lib.dir/net/TcpConnection.cc.o"
+  "CMakeFiles/gg_lib.dir/net/TcpConnection.cc.o.d"
+  "CMakeFiles/gg_lib.dir/net/TcpServer.cc.o"
+  "CMakeFiles/gg_lib.dir/net/TcpServer.cc.o.d"
+  "CMakeFiles/gg_lib.dir/net/TimerQueue.cc.o"
+  "CMakeFiles/gg_lib.dir/net/TimerQueue.cc.o.d"
+  "CMakeFiles/gg_lib.dir/net/UdpServer.cc.o"
+  "CMakeFiles/gg_lib.dir/net/UdpServer.cc.o.d"
+  "CMakeFiles/gg_lib.dir/net/UdpSocket.cc.o"
+  "CMakeFiles/gg_lib.dir/net/UdpSocket.cc.o.d"
+  "CMakeFiles/gg_lib.dir/net/http/HttpContext.cc.o"
+  "CMakeFiles/gg_lib.dir/net/http/HttpContext.cc.o.d"
+  "CMakeFiles/gg_lib.dir/net/http/HttpResponse.cc.o"
+  "CMakeFiles/gg_lib.dir/net/http/HttpResponse.cc.o.d"
+  "CMakeFiles/gg_lib.dir/net/http/HttpServer.cc.o"
+  "CMakeFiles/gg_lib.dir/net/http/HttpServer.cc.o.d"
+  "CMakeFiles/gg_lib.dir/net/poller/DefaultPoller.cc.o"
+  "CMakeFiles/gg_lib.dir/net/poller/DefaultPoller.cc.o.d"
+  "CMakeFiles/gg_lib.dir/net/poller/EPollPoller.cc.o"
+  "CMakeFiles/gg_lib.dir/net/poller/EPollPoller.cc.o.d"
+  "CMakeFiles/gg_lib.dir/net/poller/IoUringPoller.cc.o"
+  "CMakeFiles/gg_lib.dir/net/poller/IoUringPoller.cc.o.d"
+  "CMakeFiles/gg_lib.dir/net/poller/PollPoller.cc.o"
+  "CMakeFiles/gg_lib.dir/net/poller/PollPoller.cc.o.d"
+  "CMakeFiles/gg_lib.dir/net/timer/HeapTimerQueue.cc.o"
+  "CMakeFiles/gg_lib.dir/net/timer/HeapTimerQueue.cc.o.d"
+  "CMakeFiles/gg_lib.dir/net/timer/WheelTimerQueue.cc.o"
+  "CMakeFiles/gg_lib.dir/net/timer/WheelTimerQueue.cc.o.d"
+  "libgg_lib.a"
+  "libgg_lib.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/gg_lib.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
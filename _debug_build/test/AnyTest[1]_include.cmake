@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_debug_build/test/AnyTest[1]_tests.cmake")
+  include("/root/repo/_debug_build/test/AnyTest[1]_tests.cmake")
+else()
+  add_test(AnyTest_NOT_BUILT AnyTest_NOT_BUILT)
+endif()
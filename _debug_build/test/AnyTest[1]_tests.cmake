@@ -0,0 +1,9 @@
+add_test([=[AnyTest.TestAssign]=]  /root/repo/_debug_build/test/AnyTest [==[--gtest_filter=AnyTest.TestAssign]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[AnyTest.TestAssign]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[AnyTest.TestCast]=]  /root/repo/_debug_build/test/AnyTest [==[--gtest_filter=AnyTest.TestCast]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[AnyTest.TestCast]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[AnyTest.TestPointer]=]  /root/repo/_debug_build/test/AnyTest [==[--gtest_filter=AnyTest.TestPointer]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[AnyTest.TestPointer]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[AnyTest.MakeAny]=]  /root/repo/_debug_build/test/AnyTest [==[--gtest_filter=AnyTest.MakeAny]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[AnyTest.MakeAny]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  AnyTest_TESTS AnyTest.TestAssign AnyTest.TestCast AnyTest.TestPointer AnyTest.MakeAny)
@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_debug_build/test/BlockingQueueTest[1]_tests.cmake")
+  include("/root/repo/_debug_build/test/BlockingQueueTest[1]_tests.cmake")
+else()
+  add_test(BlockingQueueTest_NOT_BUILT BlockingQueueTest_NOT_BUILT)
+endif()
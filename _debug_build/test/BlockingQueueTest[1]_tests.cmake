@@ -0,0 +1 @@
+set(  BlockingQueueTest_TESTS)
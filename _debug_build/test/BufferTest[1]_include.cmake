@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_debug_build/test/BufferTest[1]_tests.cmake")
+  include("/root/repo/_debug_build/test/BufferTest[1]_tests.cmake")
+else()
+  add_test(BufferTest_NOT_BUILT BufferTest_NOT_BUILT)
+endif()
@@ -0,0 +1,23 @@
+add_test([=[BufferTest.AppendRetrieve]=]  /root/repo/_debug_build/test/BufferTest [==[--gtest_filter=BufferTest.AppendRetrieve]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[BufferTest.AppendRetrieve]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[BufferTest.BufferInsideGrow]=]  /root/repo/_debug_build/test/BufferTest [==[--gtest_filter=BufferTest.BufferInsideGrow]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[BufferTest.BufferInsideGrow]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[BufferTest.BufferShrink]=]  /root/repo/_debug_build/test/BufferTest [==[--gtest_filter=BufferTest.BufferShrink]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[BufferTest.BufferShrink]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[BufferTest.BufferPrepend]=]  /root/repo/_debug_build/test/BufferTest [==[--gtest_filter=BufferTest.BufferPrepend]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[BufferTest.BufferPrepend]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[BufferTest.BufferReadInt]=]  /root/repo/_debug_build/test/BufferTest [==[--gtest_filter=BufferTest.BufferReadInt]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[BufferTest.BufferReadInt]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[BufferTest.BufferFindEOL]=]  /root/repo/_debug_build/test/BufferTest [==[--gtest_filter=BufferTest.BufferFindEOL]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[BufferTest.BufferFindEOL]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[BufferTest.BufferMove]=]  /root/repo/_debug_build/test/BufferTest [==[--gtest_filter=BufferTest.BufferMove]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[BufferTest.BufferMove]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[BufferTest.BufferFmt]=]  /root/repo/_debug_build/test/BufferTest [==[--gtest_filter=BufferTest.BufferFmt]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[BufferTest.BufferFmt]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[BufferTest.BufferLazy]=]  /root/repo/_debug_build/test/BufferTest [==[--gtest_filter=BufferTest.BufferLazy]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[BufferTest.BufferLazy]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[BufferTest.BufferLazyReadFd]=]  /root/repo/_debug_build/test/BufferTest [==[--gtest_filter=BufferTest.BufferLazyReadFd]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[BufferTest.BufferLazyReadFd]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[BufferTest.BufferReleaseLarge]=]  /root/repo/_debug_build/test/BufferTest [==[--gtest_filter=BufferTest.BufferReleaseLarge]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[BufferTest.BufferReleaseLarge]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  BufferTest_TESTS BufferTest.AppendRetrieve BufferTest.BufferInsideGrow BufferTest.BufferShrink BufferTest.BufferPrepend BufferTest.BufferReadInt BufferTest.BufferFindEOL BufferTest.BufferMove BufferTest.BufferFmt BufferTest.BufferLazy BufferTest.BufferLazyReadFd BufferTest.BufferReleaseLarge)
@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_debug_build/test/BusyPollTest[1]_tests.cmake")
+  include("/root/repo/_debug_build/test/BusyPollTest[1]_tests.cmake")
+else()
+  add_test(BusyPollTest_NOT_BUILT BusyPollTest_NOT_BUILT)
+endif()
@@ -0,0 +1,5 @@
+add_test([=[BusyPollTest.SpinThenBlock]=]  /root/repo/_debug_build/test/BusyPollTest [==[--gtest_filter=BusyPollTest.SpinThenBlock]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[BusyPollTest.SpinThenBlock]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[BusyPollTest.Off]=]  /root/repo/_debug_build/test/BusyPollTest [==[--gtest_filter=BusyPollTest.Off]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[BusyPollTest.Off]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  BusyPollTest_TESTS BusyPollTest.SpinThenBlock BusyPollTest.Off)
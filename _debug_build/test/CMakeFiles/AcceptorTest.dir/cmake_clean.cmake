@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "AcceptorTest"
+  "AcceptorTest.pdb"
+  "CMakeFiles/AcceptorTest.dir/net/AcceptorTest.cc.o"
+  "CMakeFiles/AcceptorTest.dir/net/AcceptorTest.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/AcceptorTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "AnyTest"
+  "AnyTest.pdb"
+  "AnyTest[1]_tests.cmake"
+  "CMakeFiles/AnyTest.dir/AnyTest.cc.o"
+  "CMakeFiles/AnyTest.dir/AnyTest.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/AnyTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
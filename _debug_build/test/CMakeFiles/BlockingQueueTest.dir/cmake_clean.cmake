@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "BlockingQueueTest"
+  "BlockingQueueTest.pdb"
+  "BlockingQueueTest[1]_tests.cmake"
+  "CMakeFiles/BlockingQueueTest.dir/BlockingQueueTest.cc.o"
+  "CMakeFiles/BlockingQueueTest.dir/BlockingQueueTest.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/BlockingQueueTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "BufferTest"
+  "BufferTest.pdb"
+  "BufferTest[1]_tests.cmake"
+  "CMakeFiles/BufferTest.dir/net/BufferTest.cc.o"
+  "CMakeFiles/BufferTest.dir/net/BufferTest.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/BufferTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "BusyPollTest"
+  "BusyPollTest.pdb"
+  "BusyPollTest[1]_tests.cmake"
+  "CMakeFiles/BusyPollTest.dir/net/BusyPollTest.cc.o"
+  "CMakeFiles/BusyPollTest.dir/net/BusyPollTest.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/BusyPollTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ChainBufferTest.dir/net/ChainBufferTest.cc.o"
+  "CMakeFiles/ChainBufferTest.dir/net/ChainBufferTest.cc.o.d"
+  "ChainBufferTest"
+  "ChainBufferTest.pdb"
+  "ChainBufferTest[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ChainBufferTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ChannelTableTest.dir/net/ChannelTableTest.cc.o"
+  "CMakeFiles/ChannelTableTest.dir/net/ChannelTableTest.cc.o.d"
+  "ChannelTableTest"
+  "ChannelTableTest.pdb"
+  "ChannelTableTest[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ChannelTableTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ConnectionRateBench.dir/net/ConnectionRateBench.cc.o"
+  "CMakeFiles/ConnectionRateBench.dir/net/ConnectionRateBench.cc.o.d"
+  "ConnectionRateBench"
+  "ConnectionRateBench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ConnectionRateBench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/CpuAffinityTest.dir/CpuAffinityTest.cc.o"
+  "CMakeFiles/CpuAffinityTest.dir/CpuAffinityTest.cc.o.d"
+  "CpuAffinityTest"
+  "CpuAffinityTest.pdb"
+  "CpuAffinityTest[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/CpuAffinityTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
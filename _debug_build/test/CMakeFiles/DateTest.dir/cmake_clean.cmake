@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/DateTest.dir/DateTest.cc.o"
+  "CMakeFiles/DateTest.dir/DateTest.cc.o.d"
+  "DateTest"
+  "DateTest.pdb"
+  "DateTest[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/DateTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
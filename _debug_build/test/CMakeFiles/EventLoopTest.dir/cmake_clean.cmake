@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/EventLoopTest.dir/net/EventLoopTest.cc.o"
+  "CMakeFiles/EventLoopTest.dir/net/EventLoopTest.cc.o.d"
+  "EventLoopTest"
+  "EventLoopTest.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/EventLoopTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/EventLoopThreadPoolTest.dir/net/EventLoopThreadPoolTest.cc.o"
+  "CMakeFiles/EventLoopThreadPoolTest.dir/net/EventLoopThreadPoolTest.cc.o.d"
+  "EventLoopThreadPoolTest"
+  "EventLoopThreadPoolTest.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/EventLoopThreadPoolTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
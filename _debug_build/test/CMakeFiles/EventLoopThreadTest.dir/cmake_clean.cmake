@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/EventLoopThreadTest.dir/net/EventLoopThreadTest.cc.o"
+  "CMakeFiles/EventLoopThreadTest.dir/net/EventLoopThreadTest.cc.o.d"
+  "EventLoopThreadTest"
+  "EventLoopThreadTest.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/EventLoopThreadTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/FixedBufferBench.dir/FixedBufferBench.cc.o"
+  "CMakeFiles/FixedBufferBench.dir/FixedBufferBench.cc.o.d"
+  "FixedBufferBench"
+  "FixedBufferBench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/FixedBufferBench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/FixedBufferTest.dir/FixedBufferTest.cc.o"
+  "CMakeFiles/FixedBufferTest.dir/FixedBufferTest.cc.o.d"
+  "FixedBufferTest"
+  "FixedBufferTest.pdb"
+  "FixedBufferTest[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/FixedBufferTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
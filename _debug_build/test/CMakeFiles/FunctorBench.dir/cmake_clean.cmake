@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/FunctorBench.dir/net/FunctorBench.cc.o"
+  "CMakeFiles/FunctorBench.dir/net/FunctorBench.cc.o.d"
+  "FunctorBench"
+  "FunctorBench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/FunctorBench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/HttpServerTest.dir/net/HttpServerTest.cc.o"
+  "CMakeFiles/HttpServerTest.dir/net/HttpServerTest.cc.o.d"
+  "HttpServerTest"
+  "HttpServerTest.pdb"
+  "HttpServerTest[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/HttpServerTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
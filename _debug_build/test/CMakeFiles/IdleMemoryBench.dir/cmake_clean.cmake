@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/IdleMemoryBench.dir/net/IdleMemoryBench.cc.o"
+  "CMakeFiles/IdleMemoryBench.dir/net/IdleMemoryBench.cc.o.d"
+  "IdleMemoryBench"
+  "IdleMemoryBench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/IdleMemoryBench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
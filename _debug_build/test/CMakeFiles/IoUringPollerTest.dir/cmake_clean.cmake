@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/IoUringPollerTest.dir/net/IoUringPollerTest.cc.o"
+  "CMakeFiles/IoUringPollerTest.dir/net/IoUringPollerTest.cc.o.d"
+  "IoUringPollerTest"
+  "IoUringPollerTest.pdb"
+  "IoUringPollerTest[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/IoUringPollerTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
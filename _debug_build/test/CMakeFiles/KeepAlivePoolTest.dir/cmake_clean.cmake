@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/KeepAlivePoolTest.dir/net/KeepAlivePoolTest.cc.o"
+  "CMakeFiles/KeepAlivePoolTest.dir/net/KeepAlivePoolTest.cc.o.d"
+  "KeepAlivePoolTest"
+  "KeepAlivePoolTest.pdb"
+  "KeepAlivePoolTest[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/KeepAlivePoolTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/LocalRpcBench.dir/net/LocalRpcBench.cc.o"
+  "CMakeFiles/LocalRpcBench.dir/net/LocalRpcBench.cc.o.d"
+  "LocalRpcBench"
+  "LocalRpcBench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/LocalRpcBench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
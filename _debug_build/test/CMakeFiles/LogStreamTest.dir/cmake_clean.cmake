@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/LogStreamTest.dir/LogStreamTest.cc.o"
+  "CMakeFiles/LogStreamTest.dir/LogStreamTest.cc.o.d"
+  "LogStreamTest"
+  "LogStreamTest.pdb"
+  "LogStreamTest[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/LogStreamTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
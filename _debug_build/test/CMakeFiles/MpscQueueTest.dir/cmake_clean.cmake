@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/MpscQueueTest.dir/MpscQueueTest.cc.o"
+  "CMakeFiles/MpscQueueTest.dir/MpscQueueTest.cc.o.d"
+  "MpscQueueTest"
+  "MpscQueueTest.pdb"
+  "MpscQueueTest[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/MpscQueueTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
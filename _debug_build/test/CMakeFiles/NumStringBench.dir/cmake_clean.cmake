@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/NumStringBench.dir/NumStringBench.cc.o"
+  "CMakeFiles/NumStringBench.dir/NumStringBench.cc.o.d"
+  "NumStringBench"
+  "NumStringBench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/NumStringBench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/PlacementBench.dir/net/PlacementBench.cc.o"
+  "CMakeFiles/PlacementBench.dir/net/PlacementBench.cc.o.d"
+  "PlacementBench"
+  "PlacementBench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/PlacementBench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/PollerBench.dir/net/PollerBench.cc.o"
+  "CMakeFiles/PollerBench.dir/net/PollerBench.cc.o.d"
+  "PollerBench"
+  "PollerBench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/PollerBench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/QueueInLoopBench.dir/net/QueueInLoopBench.cc.o"
+  "CMakeFiles/QueueInLoopBench.dir/net/QueueInLoopBench.cc.o.d"
+  "QueueInLoopBench"
+  "QueueInLoopBench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/QueueInLoopBench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
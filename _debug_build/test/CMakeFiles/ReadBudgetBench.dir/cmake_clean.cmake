@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ReadBudgetBench.dir/net/ReadBudgetBench.cc.o"
+  "CMakeFiles/ReadBudgetBench.dir/net/ReadBudgetBench.cc.o.d"
+  "ReadBudgetBench"
+  "ReadBudgetBench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ReadBudgetBench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ShmRingBench.dir/net/ShmRingBench.cc.o"
+  "CMakeFiles/ShmRingBench.dir/net/ShmRingBench.cc.o.d"
+  "ShmRingBench"
+  "ShmRingBench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ShmRingBench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ShmRingReaderTest.dir/net/ShmRingReaderTest.cc.o"
+  "CMakeFiles/ShmRingReaderTest.dir/net/ShmRingReaderTest.cc.o.d"
+  "ShmRingReaderTest"
+  "ShmRingReaderTest.pdb"
+  "ShmRingReaderTest[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ShmRingReaderTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ShmRingTest.dir/ShmRingTest.cc.o"
+  "CMakeFiles/ShmRingTest.dir/ShmRingTest.cc.o.d"
+  "ShmRingTest"
+  "ShmRingTest.pdb"
+  "ShmRingTest[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ShmRingTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
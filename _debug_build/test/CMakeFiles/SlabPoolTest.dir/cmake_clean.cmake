@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/SlabPoolTest.dir/SlabPoolTest.cc.o"
+  "CMakeFiles/SlabPoolTest.dir/SlabPoolTest.cc.o.d"
+  "SlabPoolTest"
+  "SlabPoolTest.pdb"
+  "SlabPoolTest[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/SlabPoolTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
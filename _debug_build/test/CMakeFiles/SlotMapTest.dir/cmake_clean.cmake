@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/SlotMapTest.dir/SlotMapTest.cc.o"
+  "CMakeFiles/SlotMapTest.dir/SlotMapTest.cc.o.d"
+  "SlotMapTest"
+  "SlotMapTest.pdb"
+  "SlotMapTest[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/SlotMapTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
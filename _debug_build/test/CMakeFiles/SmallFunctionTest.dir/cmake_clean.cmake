@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/SmallFunctionTest.dir/SmallFunctionTest.cc.o"
+  "CMakeFiles/SmallFunctionTest.dir/SmallFunctionTest.cc.o.d"
+  "SmallFunctionTest"
+  "SmallFunctionTest.pdb"
+  "SmallFunctionTest[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/SmallFunctionTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/TcpClientTest.dir/net/TcpClientTest.cc.o"
+  "CMakeFiles/TcpClientTest.dir/net/TcpClientTest.cc.o.d"
+  "TcpClientTest"
+  "TcpClientTest.pdb"
+  "TcpClientTest[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/TcpClientTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/TcpConnectionTest.dir/net/TcpConnectionTest.cc.o"
+  "CMakeFiles/TcpConnectionTest.dir/net/TcpConnectionTest.cc.o.d"
+  "TcpConnectionTest"
+  "TcpConnectionTest.pdb"
+  "TcpConnectionTest[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/TcpConnectionTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/TcpServerTest.dir/net/TcpServerTest.cc.o"
+  "CMakeFiles/TcpServerTest.dir/net/TcpServerTest.cc.o.d"
+  "TcpServerTest"
+  "TcpServerTest.pdb"
+  "TcpServerTest[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/TcpServerTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
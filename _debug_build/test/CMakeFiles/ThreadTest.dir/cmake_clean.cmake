@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ThreadTest.dir/ThreadTest.cc.o"
+  "CMakeFiles/ThreadTest.dir/ThreadTest.cc.o.d"
+  "ThreadTest"
+  "ThreadTest.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ThreadTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
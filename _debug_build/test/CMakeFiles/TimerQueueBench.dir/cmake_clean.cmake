@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/TimerQueueBench.dir/net/TimerQueueBench.cc.o"
+  "CMakeFiles/TimerQueueBench.dir/net/TimerQueueBench.cc.o.d"
+  "TimerQueueBench"
+  "TimerQueueBench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/TimerQueueBench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
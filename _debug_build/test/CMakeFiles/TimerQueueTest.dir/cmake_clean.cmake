@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/TimerQueueTest.dir/net/TimerQueueTest.cc.o"
+  "CMakeFiles/TimerQueueTest.dir/net/TimerQueueTest.cc.o.d"
+  "TimerQueueTest"
+  "TimerQueueTest.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/TimerQueueTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
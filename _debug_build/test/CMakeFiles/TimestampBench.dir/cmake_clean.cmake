@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/TimestampBench.dir/TimestampBench.cc.o"
+  "CMakeFiles/TimestampBench.dir/TimestampBench.cc.o.d"
+  "TimestampBench"
+  "TimestampBench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/TimestampBench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/TimestampTest.dir/TimestampTest.cc.o"
+  "CMakeFiles/TimestampTest.dir/TimestampTest.cc.o.d"
+  "TimestampTest"
+  "TimestampTest.pdb"
+  "TimestampTest[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/TimestampTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/UdpBench.dir/net/UdpBench.cc.o"
+  "CMakeFiles/UdpBench.dir/net/UdpBench.cc.o.d"
+  "UdpBench"
+  "UdpBench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/UdpBench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/UdpSocketTest.dir/net/UdpSocketTest.cc.o"
+  "CMakeFiles/UdpSocketTest.dir/net/UdpSocketTest.cc.o.d"
+  "UdpSocketTest"
+  "UdpSocketTest.pdb"
+  "UdpSocketTest[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/UdpSocketTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
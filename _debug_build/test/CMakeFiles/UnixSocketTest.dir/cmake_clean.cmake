@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/UnixSocketTest.dir/net/UnixSocketTest.cc.o"
+  "CMakeFiles/UnixSocketTest.dir/net/UnixSocketTest.cc.o.d"
+  "UnixSocketTest"
+  "UnixSocketTest.pdb"
+  "UnixSocketTest[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/UnixSocketTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/WeakCallbackTest.dir/WeakCallbackTest.cc.o"
+  "CMakeFiles/WeakCallbackTest.dir/WeakCallbackTest.cc.o.d"
+  "WeakCallbackTest"
+  "WeakCallbackTest.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/WeakCallbackTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
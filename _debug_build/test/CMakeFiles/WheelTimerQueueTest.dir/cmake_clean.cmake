@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/WheelTimerQueueTest.dir/net/WheelTimerQueueTest.cc.o"
+  "CMakeFiles/WheelTimerQueueTest.dir/net/WheelTimerQueueTest.cc.o.d"
+  "WheelTimerQueueTest"
+  "WheelTimerQueueTest.pdb"
+  "WheelTimerQueueTest[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/WheelTimerQueueTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ZeroCopyBench.dir/net/ZeroCopyBench.cc.o"
+  "CMakeFiles/ZeroCopyBench.dir/net/ZeroCopyBench.cc.o.d"
+  "ZeroCopyBench"
+  "ZeroCopyBench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ZeroCopyBench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
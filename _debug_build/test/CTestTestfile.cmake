@@ -0,0 +1,32 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test
+# Build directory: /root/repo/_debug_build/test
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+include("/root/repo/_debug_build/test/AnyTest[1]_include.cmake")
+include("/root/repo/_debug_build/test/BlockingQueueTest[1]_include.cmake")
+include("/root/repo/_debug_build/test/CpuAffinityTest[1]_include.cmake")
+include("/root/repo/_debug_build/test/DateTest[1]_include.cmake")
+include("/root/repo/_debug_build/test/FixedBufferTest[1]_include.cmake")
+include("/root/repo/_debug_build/test/LogStreamTest[1]_include.cmake")
+include("/root/repo/_debug_build/test/MpscQueueTest[1]_include.cmake")
+include("/root/repo/_debug_build/test/ShmRingTest[1]_include.cmake")
+include("/root/repo/_debug_build/test/SlabPoolTest[1]_include.cmake")
+include("/root/repo/_debug_build/test/SlotMapTest[1]_include.cmake")
+include("/root/repo/_debug_build/test/SmallFunctionTest[1]_include.cmake")
+include("/root/repo/_debug_build/test/TimestampTest[1]_include.cmake")
+include("/root/repo/_debug_build/test/BufferTest[1]_include.cmake")
+include("/root/repo/_debug_build/test/BusyPollTest[1]_include.cmake")
+include("/root/repo/_debug_build/test/ChainBufferTest[1]_include.cmake")
+include("/root/repo/_debug_build/test/ChannelTableTest[1]_include.cmake")
+include("/root/repo/_debug_build/test/HttpServerTest[1]_include.cmake")
+include("/root/repo/_debug_build/test/IoUringPollerTest[1]_include.cmake")
+include("/root/repo/_debug_build/test/KeepAlivePoolTest[1]_include.cmake")
+include("/root/repo/_debug_build/test/ShmRingReaderTest[1]_include.cmake")
+include("/root/repo/_debug_build/test/TcpClientTest[1]_include.cmake")
+include("/root/repo/_debug_build/test/TcpConnectionTest[1]_include.cmake")
+include("/root/repo/_debug_build/test/TcpServerTest[1]_include.cmake")
+include("/root/repo/_debug_build/test/UdpSocketTest[1]_include.cmake")
+include("/root/repo/_debug_build/test/UnixSocketTest[1]_include.cmake")
+include("/root/repo/_debug_build/test/WheelTimerQueueTest[1]_include.cmake")
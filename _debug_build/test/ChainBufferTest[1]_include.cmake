@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_debug_build/test/ChainBufferTest[1]_tests.cmake")
+  include("/root/repo/_debug_build/test/ChainBufferTest[1]_tests.cmake")
+else()
+  add_test(ChainBufferTest_NOT_BUILT ChainBufferTest_NOT_BUILT)
+endif()
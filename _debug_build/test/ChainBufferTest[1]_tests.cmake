@@ -0,0 +1,19 @@
+add_test([=[ChainBufferTest.AppendRetrieve]=]  /root/repo/_debug_build/test/ChainBufferTest [==[--gtest_filter=ChainBufferTest.AppendRetrieve]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ChainBufferTest.AppendRetrieve]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ChainBufferTest.AppendNeverMoves]=]  /root/repo/_debug_build/test/ChainBufferTest [==[--gtest_filter=ChainBufferTest.AppendNeverMoves]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ChainBufferTest.AppendNeverMoves]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ChainBufferTest.RetrieveAcrossBlocks]=]  /root/repo/_debug_build/test/ChainBufferTest [==[--gtest_filter=ChainBufferTest.RetrieveAcrossBlocks]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ChainBufferTest.RetrieveAcrossBlocks]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ChainBufferTest.FillIovec]=]  /root/repo/_debug_build/test/ChainBufferTest [==[--gtest_filter=ChainBufferTest.FillIovec]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ChainBufferTest.FillIovec]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ChainBufferTest.Move]=]  /root/repo/_debug_build/test/ChainBufferTest [==[--gtest_filter=ChainBufferTest.Move]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ChainBufferTest.Move]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ChainBufferTest.AppendSlice]=]  /root/repo/_debug_build/test/ChainBufferTest [==[--gtest_filter=ChainBufferTest.AppendSlice]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ChainBufferTest.AppendSlice]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ChainBufferTest.AppendBuffer]=]  /root/repo/_debug_build/test/ChainBufferTest [==[--gtest_filter=ChainBufferTest.AppendBuffer]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ChainBufferTest.AppendBuffer]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ChainBufferTest.AppendChain]=]  /root/repo/_debug_build/test/ChainBufferTest [==[--gtest_filter=ChainBufferTest.AppendChain]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ChainBufferTest.AppendChain]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ChainBufferTest.ReadWriteFd]=]  /root/repo/_debug_build/test/ChainBufferTest [==[--gtest_filter=ChainBufferTest.ReadWriteFd]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ChainBufferTest.ReadWriteFd]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  ChainBufferTest_TESTS ChainBufferTest.AppendRetrieve ChainBufferTest.AppendNeverMoves ChainBufferTest.RetrieveAcrossBlocks ChainBufferTest.FillIovec ChainBufferTest.Move ChainBufferTest.AppendSlice ChainBufferTest.AppendBuffer ChainBufferTest.AppendChain ChainBufferTest.ReadWriteFd)
@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_debug_build/test/ChannelTableTest[1]_tests.cmake")
+  include("/root/repo/_debug_build/test/ChannelTableTest[1]_tests.cmake")
+else()
+  add_test(ChannelTableTest_NOT_BUILT ChannelTableTest_NOT_BUILT)
+endif()
@@ -0,0 +1,5 @@
+add_test([=[ChannelTableTest.InsertFindErase]=]  /root/repo/_debug_build/test/ChannelTableTest [==[--gtest_filter=ChannelTableTest.InsertFindErase]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ChannelTableTest.InsertFindErase]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ChannelTableTest.ManyChannels]=]  /root/repo/_debug_build/test/ChannelTableTest [==[--gtest_filter=ChannelTableTest.ManyChannels]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ChannelTableTest.ManyChannels]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  ChannelTableTest_TESTS ChannelTableTest.InsertFindErase ChannelTableTest.ManyChannels)
@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_debug_build/test/CpuAffinityTest[1]_tests.cmake")
+  include("/root/repo/_debug_build/test/CpuAffinityTest[1]_tests.cmake")
+else()
+  add_test(CpuAffinityTest_NOT_BUILT CpuAffinityTest_NOT_BUILT)
+endif()
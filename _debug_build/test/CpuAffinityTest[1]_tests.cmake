@@ -0,0 +1,9 @@
+add_test([=[CpuAffinityTest.ParseCpuList]=]  /root/repo/_debug_build/test/CpuAffinityTest [==[--gtest_filter=CpuAffinityTest.ParseCpuList]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[CpuAffinityTest.ParseCpuList]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[CpuAffinityTest.Topology]=]  /root/repo/_debug_build/test/CpuAffinityTest [==[--gtest_filter=CpuAffinityTest.Topology]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[CpuAffinityTest.Topology]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[CpuAffinityTest.Policies]=]  /root/repo/_debug_build/test/CpuAffinityTest [==[--gtest_filter=CpuAffinityTest.Policies]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[CpuAffinityTest.Policies]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[CpuAffinityTest.Apply]=]  /root/repo/_debug_build/test/CpuAffinityTest [==[--gtest_filter=CpuAffinityTest.Apply]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[CpuAffinityTest.Apply]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  CpuAffinityTest_TESTS CpuAffinityTest.ParseCpuList CpuAffinityTest.Topology CpuAffinityTest.Policies CpuAffinityTest.Apply)
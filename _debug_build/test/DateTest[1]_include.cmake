@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_debug_build/test/DateTest[1]_tests.cmake")
+  include("/root/repo/_debug_build/test/DateTest[1]_tests.cmake")
+else()
+  add_test(DateTest_NOT_BUILT DateTest_NOT_BUILT)
+endif()
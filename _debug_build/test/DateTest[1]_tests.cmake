@@ -0,0 +1,9 @@
+add_test([=[DateTest.CommonTest]=]  /root/repo/_debug_build/test/DateTest [==[--gtest_filter=DateTest.CommonTest]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[DateTest.CommonTest]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[DateTest.TestTimeZoneNewYork]=]  /root/repo/_debug_build/test/DateTest [==[--gtest_filter=DateTest.TestTimeZoneNewYork]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[DateTest.TestTimeZoneNewYork]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[DateTest.TestTimeZoneHongKong]=]  /root/repo/_debug_build/test/DateTest [==[--gtest_filter=DateTest.TestTimeZoneHongKong]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[DateTest.TestTimeZoneHongKong]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[DateTest.TestTimeZoneFixed]=]  /root/repo/_debug_build/test/DateTest [==[--gtest_filter=DateTest.TestTimeZoneFixed]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[DateTest.TestTimeZoneFixed]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  DateTest_TESTS DateTest.CommonTest DateTest.TestTimeZoneNewYork DateTest.TestTimeZoneHongKong DateTest.TestTimeZoneFixed)
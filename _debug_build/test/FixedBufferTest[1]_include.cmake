@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_debug_build/test/FixedBufferTest[1]_tests.cmake")
+  include("/root/repo/_debug_build/test/FixedBufferTest[1]_tests.cmake")
+else()
+  add_test(FixedBufferTest_NOT_BUILT FixedBufferTest_NOT_BUILT)
+endif()
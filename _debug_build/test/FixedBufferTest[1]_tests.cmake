@@ -0,0 +1,3 @@
+add_test([=[FixedBufferTest.TestAppend]=]  /root/repo/_debug_build/test/FixedBufferTest [==[--gtest_filter=FixedBufferTest.TestAppend]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[FixedBufferTest.TestAppend]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  FixedBufferTest_TESTS FixedBufferTest.TestAppend)
@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_debug_build/test/HttpServerTest[1]_tests.cmake")
+  include("/root/repo/_debug_build/test/HttpServerTest[1]_tests.cmake")
+else()
+  add_test(HttpServerTest_NOT_BUILT HttpServerTest_NOT_BUILT)
+endif()
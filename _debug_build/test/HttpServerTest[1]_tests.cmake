@@ -0,0 +1,5 @@
+add_test([=[HttpServerTest.ParseRequestTest]=]  /root/repo/_debug_build/test/HttpServerTest [==[--gtest_filter=HttpServerTest.ParseRequestTest]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[HttpServerTest.ParseRequestTest]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[HttpServerTest.ParseRequestMultiTest]=]  /root/repo/_debug_build/test/HttpServerTest [==[--gtest_filter=HttpServerTest.ParseRequestMultiTest]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[HttpServerTest.ParseRequestMultiTest]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  HttpServerTest_TESTS HttpServerTest.ParseRequestTest HttpServerTest.ParseRequestMultiTest)
@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_debug_build/test/IoUringPollerTest[1]_tests.cmake")
+  include("/root/repo/_debug_build/test/IoUringPollerTest[1]_tests.cmake")
+else()
+  add_test(IoUringPollerTest_NOT_BUILT IoUringPollerTest_NOT_BUILT)
+endif()
@@ -0,0 +1,7 @@
+add_test([=[IoUringPollerTest.OneShotRearm]=]  /root/repo/_debug_build/test/IoUringPollerTest [==[--gtest_filter=IoUringPollerTest.OneShotRearm]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[IoUringPollerTest.OneShotRearm]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[IoUringPollerTest.AddModifyRemove]=]  /root/repo/_debug_build/test/IoUringPollerTest [==[--gtest_filter=IoUringPollerTest.AddModifyRemove]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[IoUringPollerTest.AddModifyRemove]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[IoUringPollerTest.TimerAndWakeup]=]  /root/repo/_debug_build/test/IoUringPollerTest [==[--gtest_filter=IoUringPollerTest.TimerAndWakeup]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[IoUringPollerTest.TimerAndWakeup]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  IoUringPollerTest_TESTS IoUringPollerTest.OneShotRearm IoUringPollerTest.AddModifyRemove IoUringPollerTest.TimerAndWakeup)
@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_debug_build/test/KeepAlivePoolTest[1]_tests.cmake")
+  include("/root/repo/_debug_build/test/KeepAlivePoolTest[1]_tests.cmake")
+else()
+  add_test(KeepAlivePoolTest_NOT_BUILT KeepAlivePoolTest_NOT_BUILT)
+endif()
@@ -0,0 +1,13 @@
+add_test([=[KeepAlivePoolTest.Reuse]=]  /root/repo/_debug_build/test/KeepAlivePoolTest [==[--gtest_filter=KeepAlivePoolTest.Reuse]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[KeepAlivePoolTest.Reuse]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[KeepAlivePoolTest.ClosedByServer]=]  /root/repo/_debug_build/test/KeepAlivePoolTest [==[--gtest_filter=KeepAlivePoolTest.ClosedByServer]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[KeepAlivePoolTest.ClosedByServer]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[KeepAlivePoolTest.IdleTimeout]=]  /root/repo/_debug_build/test/KeepAlivePoolTest [==[--gtest_filter=KeepAlivePoolTest.IdleTimeout]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[KeepAlivePoolTest.IdleTimeout]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[KeepAlivePoolTest.UnixPaths]=]  /root/repo/_debug_build/test/KeepAlivePoolTest [==[--gtest_filter=KeepAlivePoolTest.UnixPaths]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[KeepAlivePoolTest.UnixPaths]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[KeepAlivePoolTest.DestroyedWithTimerOnWheel]=]  /root/repo/_debug_build/test/KeepAlivePoolTest [==[--gtest_filter=KeepAlivePoolTest.DestroyedWithTimerOnWheel]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[KeepAlivePoolTest.DestroyedWithTimerOnWheel]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[KeepAlivePoolTest.ConnectFailure]=]  /root/repo/_debug_build/test/KeepAlivePoolTest [==[--gtest_filter=KeepAlivePoolTest.ConnectFailure]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[KeepAlivePoolTest.ConnectFailure]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  KeepAlivePoolTest_TESTS KeepAlivePoolTest.Reuse KeepAlivePoolTest.ClosedByServer KeepAlivePoolTest.IdleTimeout KeepAlivePoolTest.UnixPaths KeepAlivePoolTest.DestroyedWithTimerOnWheel KeepAlivePoolTest.ConnectFailure)
@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_debug_build/test/LogStreamTest[1]_tests.cmake")
+  include("/root/repo/_debug_build/test/LogStreamTest[1]_tests.cmake")
+else()
+  add_test(LogStreamTest_NOT_BUILT LogStreamTest_NOT_BUILT)
+endif()
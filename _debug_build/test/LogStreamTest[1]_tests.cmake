@@ -0,0 +1,13 @@
+add_test([=[LogStreamTest.TestBooleans]=]  /root/repo/_debug_build/test/LogStreamTest [==[--gtest_filter=LogStreamTest.TestBooleans]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[LogStreamTest.TestBooleans]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[LogStreamTest.TestInteger]=]  /root/repo/_debug_build/test/LogStreamTest [==[--gtest_filter=LogStreamTest.TestInteger]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[LogStreamTest.TestInteger]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[LogStreamTest.TestIntegerLimit]=]  /root/repo/_debug_build/test/LogStreamTest [==[--gtest_filter=LogStreamTest.TestIntegerLimit]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[LogStreamTest.TestIntegerLimit]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[LogStreamTest.TestFloatLimit]=]  /root/repo/_debug_build/test/LogStreamTest [==[--gtest_filter=LogStreamTest.TestFloatLimit]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[LogStreamTest.TestFloatLimit]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[LogStreamTest.TestVoid]=]  /root/repo/_debug_build/test/LogStreamTest [==[--gtest_filter=LogStreamTest.TestVoid]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[LogStreamTest.TestVoid]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[LogStreamTest.TestString]=]  /root/repo/_debug_build/test/LogStreamTest [==[--gtest_filter=LogStreamTest.TestString]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[LogStreamTest.TestString]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  LogStreamTest_TESTS LogStreamTest.TestBooleans LogStreamTest.TestInteger LogStreamTest.TestIntegerLimit LogStreamTest.TestFloatLimit LogStreamTest.TestVoid LogStreamTest.TestString)
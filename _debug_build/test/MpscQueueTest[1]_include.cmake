@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_debug_build/test/MpscQueueTest[1]_tests.cmake")
+  include("/root/repo/_debug_build/test/MpscQueueTest[1]_tests.cmake")
+else()
+  add_test(MpscQueueTest_NOT_BUILT MpscQueueTest_NOT_BUILT)
+endif()
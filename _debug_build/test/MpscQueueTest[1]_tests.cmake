@@ -0,0 +1,7 @@
+add_test([=[MpscQueueTest.PushPop]=]  /root/repo/_debug_build/test/MpscQueueTest [==[--gtest_filter=MpscQueueTest.PushPop]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[MpscQueueTest.PushPop]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[MpscQueueTest.PushBeforeStub]=]  /root/repo/_debug_build/test/MpscQueueTest [==[--gtest_filter=MpscQueueTest.PushBeforeStub]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[MpscQueueTest.PushBeforeStub]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[MpscQueueTest.MultiProducer]=]  /root/repo/_debug_build/test/MpscQueueTest [==[--gtest_filter=MpscQueueTest.MultiProducer]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[MpscQueueTest.MultiProducer]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  MpscQueueTest_TESTS MpscQueueTest.PushPop MpscQueueTest.PushBeforeStub MpscQueueTest.MultiProducer)
@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_debug_build/test/ShmRingReaderTest[1]_tests.cmake")
+  include("/root/repo/_debug_build/test/ShmRingReaderTest[1]_tests.cmake")
+else()
+  add_test(ShmRingReaderTest_NOT_BUILT ShmRingReaderTest_NOT_BUILT)
+endif()
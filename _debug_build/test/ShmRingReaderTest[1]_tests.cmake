@@ -0,0 +1,3 @@
+add_test([=[ShmRingReaderTest.CrossProcess]=]  /root/repo/_debug_build/test/ShmRingReaderTest [==[--gtest_filter=ShmRingReaderTest.CrossProcess]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ShmRingReaderTest.CrossProcess]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  ShmRingReaderTest_TESTS ShmRingReaderTest.CrossProcess)
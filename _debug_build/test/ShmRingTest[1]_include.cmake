@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_debug_build/test/ShmRingTest[1]_tests.cmake")
+  include("/root/repo/_debug_build/test/ShmRingTest[1]_tests.cmake")
+else()
+  add_test(ShmRingTest_NOT_BUILT ShmRingTest_NOT_BUILT)
+endif()
@@ -0,0 +1,7 @@
+add_test([=[ShmRingTest.WrapsContiguously]=]  /root/repo/_debug_build/test/ShmRingTest [==[--gtest_filter=ShmRingTest.WrapsContiguously]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ShmRingTest.WrapsContiguously]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ShmRingTest.WakesOnlyWaitingConsumer]=]  /root/repo/_debug_build/test/ShmRingTest [==[--gtest_filter=ShmRingTest.WakesOnlyWaitingConsumer]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ShmRingTest.WakesOnlyWaitingConsumer]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ShmRingTest.OpenMissing]=]  /root/repo/_debug_build/test/ShmRingTest [==[--gtest_filter=ShmRingTest.OpenMissing]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ShmRingTest.OpenMissing]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  ShmRingTest_TESTS ShmRingTest.WrapsContiguously ShmRingTest.WakesOnlyWaitingConsumer ShmRingTest.OpenMissing)
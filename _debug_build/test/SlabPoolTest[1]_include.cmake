@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_debug_build/test/SlabPoolTest[1]_tests.cmake")
+  include("/root/repo/_debug_build/test/SlabPoolTest[1]_tests.cmake")
+else()
+  add_test(SlabPoolTest_NOT_BUILT SlabPoolTest_NOT_BUILT)
+endif()
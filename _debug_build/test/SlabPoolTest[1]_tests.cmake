@@ -0,0 +1,5 @@
+add_test([=[SlabPoolTest.Reuse]=]  /root/repo/_debug_build/test/SlabPoolTest [==[--gtest_filter=SlabPoolTest.Reuse]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[SlabPoolTest.Reuse]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[SlabPoolTest.AllocateShared]=]  /root/repo/_debug_build/test/SlabPoolTest [==[--gtest_filter=SlabPoolTest.AllocateShared]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[SlabPoolTest.AllocateShared]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  SlabPoolTest_TESTS SlabPoolTest.Reuse SlabPoolTest.AllocateShared)
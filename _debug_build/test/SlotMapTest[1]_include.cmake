@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_debug_build/test/SlotMapTest[1]_tests.cmake")
+  include("/root/repo/_debug_build/test/SlotMapTest[1]_tests.cmake")
+else()
+  add_test(SlotMapTest_NOT_BUILT SlotMapTest_NOT_BUILT)
+endif()
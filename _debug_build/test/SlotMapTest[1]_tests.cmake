@@ -0,0 +1,7 @@
+add_test([=[SlotMapTest.InsertFindErase]=]  /root/repo/_debug_build/test/SlotMapTest [==[--gtest_filter=SlotMapTest.InsertFindErase]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[SlotMapTest.InsertFindErase]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[SlotMapTest.Tag]=]  /root/repo/_debug_build/test/SlotMapTest [==[--gtest_filter=SlotMapTest.Tag]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[SlotMapTest.Tag]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[SlotMapTest.ForEachClear]=]  /root/repo/_debug_build/test/SlotMapTest [==[--gtest_filter=SlotMapTest.ForEachClear]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[SlotMapTest.ForEachClear]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  SlotMapTest_TESTS SlotMapTest.InsertFindErase SlotMapTest.Tag SlotMapTest.ForEachClear)
@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_debug_build/test/SmallFunctionTest[1]_tests.cmake")
+  include("/root/repo/_debug_build/test/SmallFunctionTest[1]_tests.cmake")
+else()
+  add_test(SmallFunctionTest_NOT_BUILT SmallFunctionTest_NOT_BUILT)
+endif()
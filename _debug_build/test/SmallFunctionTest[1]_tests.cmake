@@ -0,0 +1,9 @@
+add_test([=[SmallFunctionTest.Empty]=]  /root/repo/_debug_build/test/SmallFunctionTest [==[--gtest_filter=SmallFunctionTest.Empty]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[SmallFunctionTest.Empty]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[SmallFunctionTest.Call]=]  /root/repo/_debug_build/test/SmallFunctionTest [==[--gtest_filter=SmallFunctionTest.Call]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[SmallFunctionTest.Call]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[SmallFunctionTest.MoveOnly]=]  /root/repo/_debug_build/test/SmallFunctionTest [==[--gtest_filter=SmallFunctionTest.MoveOnly]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[SmallFunctionTest.MoveOnly]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[SmallFunctionTest.Lifetime]=]  /root/repo/_debug_build/test/SmallFunctionTest [==[--gtest_filter=SmallFunctionTest.Lifetime]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[SmallFunctionTest.Lifetime]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  SmallFunctionTest_TESTS SmallFunctionTest.Empty SmallFunctionTest.Call SmallFunctionTest.MoveOnly SmallFunctionTest.Lifetime)
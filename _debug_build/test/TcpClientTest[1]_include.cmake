@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_debug_build/test/TcpClientTest[1]_tests.cmake")
+  include("/root/repo/_debug_build/test/TcpClientTest[1]_tests.cmake")
+else()
+  add_test(TcpClientTest_NOT_BUILT TcpClientTest_NOT_BUILT)
+endif()
@@ -0,0 +1,7 @@
+add_test([=[TcpClientTest.Echo]=]  /root/repo/_debug_build/test/TcpClientTest [==[--gtest_filter=TcpClientTest.Echo]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TcpClientTest.Echo]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TcpClientTest.RetryUntilListening]=]  /root/repo/_debug_build/test/TcpClientTest [==[--gtest_filter=TcpClientTest.RetryUntilListening]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TcpClientTest.RetryUntilListening]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TcpClientTest.ConnectorGivesUp]=]  /root/repo/_debug_build/test/TcpClientTest [==[--gtest_filter=TcpClientTest.ConnectorGivesUp]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TcpClientTest.ConnectorGivesUp]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  TcpClientTest_TESTS TcpClientTest.Echo TcpClientTest.RetryUntilListening TcpClientTest.ConnectorGivesUp)
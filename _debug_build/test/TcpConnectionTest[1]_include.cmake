@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_debug_build/test/TcpConnectionTest[1]_tests.cmake")
+  include("/root/repo/_debug_build/test/TcpConnectionTest[1]_tests.cmake")
+else()
+  add_test(TcpConnectionTest_NOT_BUILT TcpConnectionTest_NOT_BUILT)
+endif()
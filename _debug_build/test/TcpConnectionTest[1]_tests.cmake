@@ -0,0 +1,13 @@
+add_test([=[TcpConnectionTest.SendFile]=]  /root/repo/_debug_build/test/TcpConnectionTest [==[--gtest_filter=TcpConnectionTest.SendFile]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TcpConnectionTest.SendFile]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TcpConnectionTest.ZeroCopySend]=]  /root/repo/_debug_build/test/TcpConnectionTest [==[--gtest_filter=TcpConnectionTest.ZeroCopySend]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TcpConnectionTest.ZeroCopySend]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TcpConnectionTest.SendFileCompletionMode]=]  /root/repo/_debug_build/test/TcpConnectionTest [==[--gtest_filter=TcpConnectionTest.SendFileCompletionMode]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TcpConnectionTest.SendFileCompletionMode]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TcpConnectionTest.CompletionModeEcho]=]  /root/repo/_debug_build/test/TcpConnectionTest [==[--gtest_filter=TcpConnectionTest.CompletionModeEcho]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TcpConnectionTest.CompletionModeEcho]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TcpConnectionTest.Migrate]=]  /root/repo/_debug_build/test/TcpConnectionTest [==[--gtest_filter=TcpConnectionTest.Migrate]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TcpConnectionTest.Migrate]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TcpConnectionTest.EdgeTriggered]=]  /root/repo/_debug_build/test/TcpConnectionTest [==[--gtest_filter=TcpConnectionTest.EdgeTriggered]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TcpConnectionTest.EdgeTriggered]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  TcpConnectionTest_TESTS TcpConnectionTest.SendFile TcpConnectionTest.ZeroCopySend TcpConnectionTest.SendFileCompletionMode TcpConnectionTest.CompletionModeEcho TcpConnectionTest.Migrate TcpConnectionTest.EdgeTriggered)
@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_debug_build/test/TcpServerTest[1]_tests.cmake")
+  include("/root/repo/_debug_build/test/TcpServerTest[1]_tests.cmake")
+else()
+  add_test(TcpServerTest_NOT_BUILT TcpServerTest_NOT_BUILT)
+endif()
@@ -0,0 +1,11 @@
+add_test([=[TcpServerTest.IdleTimeout]=]  /root/repo/_debug_build/test/TcpServerTest [==[--gtest_filter=TcpServerTest.IdleTimeout]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TcpServerTest.IdleTimeout]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TcpServerTest.IdleTimeoutAfterShutdown]=]  /root/repo/_debug_build/test/TcpServerTest [==[--gtest_filter=TcpServerTest.IdleTimeoutAfterShutdown]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TcpServerTest.IdleTimeoutAfterShutdown]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TcpServerTest.ReusePortPerLoop]=]  /root/repo/_debug_build/test/TcpServerTest [==[--gtest_filter=TcpServerTest.ReusePortPerLoop]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TcpServerTest.ReusePortPerLoop]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TcpServerTest.DeferAccept]=]  /root/repo/_debug_build/test/TcpServerTest [==[--gtest_filter=TcpServerTest.DeferAccept]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TcpServerTest.DeferAccept]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TcpServerTest.AcceptedSocketsInheritOptions]=]  /root/repo/_debug_build/test/TcpServerTest [==[--gtest_filter=TcpServerTest.AcceptedSocketsInheritOptions]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TcpServerTest.AcceptedSocketsInheritOptions]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  TcpServerTest_TESTS TcpServerTest.IdleTimeout TcpServerTest.IdleTimeoutAfterShutdown TcpServerTest.ReusePortPerLoop TcpServerTest.DeferAccept TcpServerTest.AcceptedSocketsInheritOptions)
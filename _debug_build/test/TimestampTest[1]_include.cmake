@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_debug_build/test/TimestampTest[1]_tests.cmake")
+  include("/root/repo/_debug_build/test/TimestampTest[1]_tests.cmake")
+else()
+  add_test(TimestampTest_NOT_BUILT TimestampTest_NOT_BUILT)
+endif()
@@ -0,0 +1,9 @@
+add_test([=[TimestampTest.TestCreate]=]  /root/repo/_debug_build/test/TimestampTest [==[--gtest_filter=TimestampTest.TestCreate]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TimestampTest.TestCreate]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TimestampTest.TestToString]=]  /root/repo/_debug_build/test/TimestampTest [==[--gtest_filter=TimestampTest.TestToString]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TimestampTest.TestToString]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TimestampTest.TimeCompare]=]  /root/repo/_debug_build/test/TimestampTest [==[--gtest_filter=TimestampTest.TimeCompare]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TimestampTest.TimeCompare]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TimestampTest.Timehash]=]  /root/repo/_debug_build/test/TimestampTest [==[--gtest_filter=TimestampTest.Timehash]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TimestampTest.Timehash]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  TimestampTest_TESTS TimestampTest.TestCreate TimestampTest.TestToString TimestampTest.TimeCompare TimestampTest.Timehash)
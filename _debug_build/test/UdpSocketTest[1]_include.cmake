@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_debug_build/test/UdpSocketTest[1]_tests.cmake")
+  include("/root/repo/_debug_build/test/UdpSocketTest[1]_tests.cmake")
+else()
+  add_test(UdpSocketTest_NOT_BUILT UdpSocketTest_NOT_BUILT)
+endif()
@@ -0,0 +1,9 @@
+add_test([=[UdpSocketTest.BatchedSendReceive]=]  /root/repo/_debug_build/test/UdpSocketTest [==[--gtest_filter=UdpSocketTest.BatchedSendReceive]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[UdpSocketTest.BatchedSendReceive]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[UdpSocketTest.GsoGro]=]  /root/repo/_debug_build/test/UdpSocketTest [==[--gtest_filter=UdpSocketTest.GsoGro]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[UdpSocketTest.GsoGro]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[UdpSocketTest.SendQueueLimit]=]  /root/repo/_debug_build/test/UdpSocketTest [==[--gtest_filter=UdpSocketTest.SendQueueLimit]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[UdpSocketTest.SendQueueLimit]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[UdpServerTest.ReusePortPerLoop]=]  /root/repo/_debug_build/test/UdpSocketTest [==[--gtest_filter=UdpServerTest.ReusePortPerLoop]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[UdpServerTest.ReusePortPerLoop]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  UdpSocketTest_TESTS UdpSocketTest.BatchedSendReceive UdpSocketTest.GsoGro UdpSocketTest.SendQueueLimit UdpServerTest.ReusePortPerLoop)
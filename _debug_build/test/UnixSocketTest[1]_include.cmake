@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_debug_build/test/UnixSocketTest[1]_tests.cmake")
+  include("/root/repo/_debug_build/test/UnixSocketTest[1]_tests.cmake")
+else()
+  add_test(UnixSocketTest_NOT_BUILT UnixSocketTest_NOT_BUILT)
+endif()
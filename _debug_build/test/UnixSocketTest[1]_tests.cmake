@@ -0,0 +1,11 @@
+add_test([=[UnixSocketTest.Address]=]  /root/repo/_debug_build/test/UnixSocketTest [==[--gtest_filter=UnixSocketTest.Address]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[UnixSocketTest.Address]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[UnixSocketTest.StreamEcho]=]  /root/repo/_debug_build/test/UnixSocketTest [==[--gtest_filter=UnixSocketTest.StreamEcho]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[UnixSocketTest.StreamEcho]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[UnixSocketTest.KeepsOtherFiles]=]  /root/repo/_debug_build/test/UnixSocketTest [==[--gtest_filter=UnixSocketTest.KeepsOtherFiles]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[UnixSocketTest.KeepsOtherFiles]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[UnixSocketTest.SeqPacketEcho]=]  /root/repo/_debug_build/test/UnixSocketTest [==[--gtest_filter=UnixSocketTest.SeqPacketEcho]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[UnixSocketTest.SeqPacketEcho]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[UnixSocketTest.PassFds]=]  /root/repo/_debug_build/test/UnixSocketTest [==[--gtest_filter=UnixSocketTest.PassFds]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[UnixSocketTest.PassFds]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  UnixSocketTest_TESTS UnixSocketTest.Address UnixSocketTest.StreamEcho UnixSocketTest.KeepsOtherFiles UnixSocketTest.SeqPacketEcho UnixSocketTest.PassFds)
@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_debug_build/test/WheelTimerQueueTest[1]_tests.cmake")
+  include("/root/repo/_debug_build/test/WheelTimerQueueTest[1]_tests.cmake")
+else()
+  add_test(WheelTimerQueueTest_NOT_BUILT WheelTimerQueueTest_NOT_BUILT)
+endif()
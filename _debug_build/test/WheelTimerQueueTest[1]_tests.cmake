@@ -0,0 +1,7 @@
+add_test([=[WheelTimerQueueTest.Order]=]  /root/repo/_debug_build/test/WheelTimerQueueTest [==[--gtest_filter=WheelTimerQueueTest.Order]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[WheelTimerQueueTest.Order]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[WheelTimerQueueTest.Cancel]=]  /root/repo/_debug_build/test/WheelTimerQueueTest [==[--gtest_filter=WheelTimerQueueTest.Cancel]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[WheelTimerQueueTest.Cancel]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[WheelTimerQueueTest.OtherThread]=]  /root/repo/_debug_build/test/WheelTimerQueueTest [==[--gtest_filter=WheelTimerQueueTest.OtherThread]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[WheelTimerQueueTest.OtherThread]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_debug_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  WheelTimerQueueTest_TESTS WheelTimerQueueTest.Order WheelTimerQueueTest.Cancel WheelTimerQueueTest.OtherThread)
@@ -0,0 +1,200 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#include "gg_lib/CpuAffinity.h"
+#include "gg_lib/Logging.h"
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <linux/mempolicy.h>
+
+using namespace gg_lib;
+
+namespace {
+    const char kCpuDir[] = "/sys/devices/system/cpu";
+    const char kNodeDir[] = "/sys/devices/system/node";
+
+    /// The first line of a sysfs attribute, empty if it can't be read.
+    string readLine(const string &path) {
+        std::ifstream in(path);
+        string line;
+        std::getline(in, line);
+        return line;
+    }
+
+    int readInt(const string &path, int defaultValue) {
+        string line = readLine(path);
+        return line.empty() ? defaultValue : std::atoi(line.c_str());
+    }
+
+    typedef std::vector<std::pair<int, std::vector<int>>> NodeList;
+
+    /// Ids and CPUs of the NUMA nodes with CPUs.
+    NodeList readNodes() {
+        NodeList nodes;
+        for (int node: CpuAffinity::parseCpuList(readLine(string(kNodeDir) + "/online"))) {
+            std::vector<int> cpus = CpuAffinity::parseCpuList(
+                    readLine(fmt::format("{}/node{}/cpulist", kNodeDir, node)));
+            if (!cpus.empty()) {
+                nodes.emplace_back(node, std::move(cpus));
+            }
+        }
+        return nodes;
+    }
+
+    int nodeOf(int cpu, const NodeList &nodes) {
+        for (const auto &node: nodes) {
+            if (std::find(node.second.begin(), node.second.end(), cpu) != node.second.end()) {
+                return node.first;
+            }
+        }
+        return -1;
+    }
+
+    /// Prefers memory of node for the calling thread, falls back to other nodes when it is full.
+    bool preferNode(int node) {
+        if (node >= static_cast<int>(sizeof(unsigned long) * 8)) {
+            return false;
+        }
+        unsigned long mask = 1UL << node;
+        if (::syscall(SYS_set_mempolicy, MPOL_PREFERRED, &mask, sizeof(mask) * 8 + 1) < 0) {
+            LOG_SYSERR << "set_mempolicy";
+            return false;
+        }
+        return true;
+    }
+}
+
+CpuAffinity CpuAffinity::cpuList(std::vector<int> cpus) {
+    assert(!cpus.empty());
+    return CpuAffinity(kCpuList, std::move(cpus));
+}
+
+CpuAffinity CpuAffinity::perCore() {
+    return CpuAffinity(kPerCore, std::vector<int>());
+}
+
+CpuAffinity CpuAffinity::spreadNodes() {
+    return CpuAffinity(kSpreadNodes, std::vector<int>());
+}
+
+std::vector<int> CpuAffinity::cpusOf(int index) const {
+    assert(index >= 0);
+    switch (policy_) {
+        case kCpuList:
+            return {cpus_[index % cpus_.size()]};
+        case kPerCore: {
+            std::vector<std::vector<int>> cores = physicalCores();
+            if (cores.empty()) {
+                return {};
+            }
+            return {cores[index % cores.size()].front()};
+        }
+        case kSpreadNodes: {
+            std::vector<std::vector<int>> nodes = numaNodes();
+            if (nodes.empty()) {
+                return {};
+            }
+            return nodes[index % nodes.size()];
+        }
+        default:
+            return {};
+    }
+}
+
+bool CpuAffinity::applyToCurrentThread(int index) const {
+    std::vector<int> cpus = cpusOf(index);
+    if (cpus.empty()) {
+        return policy_ == kFloating;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu: cpus) {
+        CPU_SET(cpu, &set);
+    }
+    if (::sched_setaffinity(0, sizeof set, &set) < 0) {
+        LOG_SYSERR << Fmt("sched_setaffinity to {} CPUs from {}", cpus.size(), cpus.front());
+        return false;
+    }
+    NodeList nodes = readNodes();
+    if (nodes.size() > 1) {
+        int node = nodeOf(cpus.front(), nodes);
+        bool sameNode = std::all_of(cpus.begin(), cpus.end(), [&nodes, node](int cpu) {
+            return nodeOf(cpu, nodes) == node;
+        });
+        if (node >= 0 && sameNode) {
+            return preferNode(node);
+        }
+    }
+    return true;
+}
+
+std::vector<int> CpuAffinity::parseCpuList(const string &list) {
+    std::vector<int> cpus;
+    const char *p = list.c_str();
+    while (*p) {
+        char *end = nullptr;
+        long first = std::strtol(p, &end, 10);
+        if (end == p) {
+            break;
+        }
+        long last = first;
+        p = end;
+        if (*p == '-') {
+            last = std::strtol(p + 1, &end, 10);
+            p = end;
+        }
+        for (long cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back(static_cast<int>(cpu));
+        }
+        if (*p == ',') {
+            ++p;
+        } else {
+            break;
+        }
+    }
+    return cpus;
+}
+
+std::vector<int> CpuAffinity::onlineCpus() {
+    std::vector<int> cpus = parseCpuList(readLine(string(kCpuDir) + "/online"));
+    if (cpus.empty()) {
+        long n = ::sysconf(_SC_NPROCESSORS_ONLN);
+        for (int cpu = 0; cpu < n; ++cpu) {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+std::vector<std::vector<int>> CpuAffinity::physicalCores() {
+    std::map<std::pair<int, int>, std::vector<int>> cores;
+    for (int cpu: onlineCpus()) {
+        string topology = fmt::format("{}/cpu{}/topology/", kCpuDir, cpu);
+        int package = readInt(topology + "physical_package_id", 0);
+        // without topology every CPU counts as a core.
+        int core = readInt(topology + "core_id", cpu);
+        cores[std::make_pair(package, core)].push_back(cpu);
+    }
+    std::vector<std::vector<int>> result;
+    result.reserve(cores.size());
+    for (auto &item: cores) {
+        result.push_back(std::move(item.second));
+    }
+    return result;
+}
+
+std::vector<std::vector<int>> CpuAffinity::numaNodes() {
+    std::vector<std::vector<int>> nodes;
+    for (auto &node: readNodes()) {
+        nodes.push_back(std::move(node.second));
+    }
+    if (nodes.empty()) {
+        nodes.push_back(onlineCpus());
+    }
+    return nodes;
+}
@@ -0,0 +1,184 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#include "gg_lib/ShmRing.h"
+#include "gg_lib/Logging.h"
+
+#include <assert.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace gg_lib;
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2 && ATOMIC_INT_LOCK_FREE == 2,
+              "atomics shared between processes must be lock free");
+
+namespace {
+    constexpr uint64_t kMagic = 0x676752696E673031ULL;  // "ggRing01"
+    constexpr size_t kCacheLine = 64;
+
+    size_t pageSize() {
+        static const size_t size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+        return size;
+    }
+}
+
+/// The first page, the data pages follow.
+struct ShmRing::Header {
+    std::atomic<uint64_t> magic;
+    uint64_t capacity;
+    alignas(kCacheLine) std::atomic<uint64_t> writeIndex;
+    alignas(kCacheLine) std::atomic<uint64_t> readIndex;
+    alignas(kCacheLine) std::atomic<uint32_t> consumerWaiting;
+};
+
+std::unique_ptr<ShmRing> ShmRing::create(StringArg name, size_t capacity) {
+    static_assert(sizeof(Header) <= 4096, "the header must fit into a page");
+    size_t roundedCapacity = pageSize();
+    while (roundedCapacity < capacity) {
+        roundedCapacity *= 2;
+    }
+    int fd = ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+    if (fd < 0) {
+        LOG_SYSERR << Fmt("ShmRing::create {}", name.c_str());
+        return nullptr;
+    }
+    if (::ftruncate(fd, static_cast<off_t>(pageSize() + roundedCapacity)) < 0) {
+        LOG_SYSERR << Fmt("ShmRing::create {}", name.c_str());
+        ::close(fd);
+        ::shm_unlink(name.c_str());
+        return nullptr;
+    }
+    std::unique_ptr<ShmRing> ring = map(fd, roundedCapacity);
+    if (!ring) {
+        ::shm_unlink(name.c_str());
+        return nullptr;
+    }
+    // the file starts zero filled, the indices are 0 already.
+    ring->header_->capacity = roundedCapacity;
+    ring->header_->magic.store(kMagic, std::memory_order_release);
+    return ring;
+}
+
+std::unique_ptr<ShmRing> ShmRing::open(StringArg name) {
+    int fd = ::shm_open(name.c_str(), O_RDWR | O_CLOEXEC, 0);
+    if (fd < 0) {
+        LOG_SYSERR << Fmt("ShmRing::open {}", name.c_str());
+        return nullptr;
+    }
+    struct stat st{};
+    if (::fstat(fd, &st) < 0 || static_cast<size_t>(st.st_size) <= pageSize()) {
+        LOG_ERROR << Fmt("ShmRing::open {} - not a ring", name.c_str());
+        ::close(fd);
+        return nullptr;
+    }
+    const size_t capacity = static_cast<size_t>(st.st_size) - pageSize();
+    std::unique_ptr<ShmRing> ring = map(fd, capacity);
+    if (ring && (ring->header_->magic.load(std::memory_order_acquire) != kMagic ||
+                 ring->header_->capacity != capacity)) {
+        LOG_ERROR << Fmt("ShmRing::open {} - not a ring, or not initialized yet", name.c_str());
+        return nullptr;
+    }
+    return ring;
+}
+
+void ShmRing::unlink(StringArg name) {
+    if (::shm_unlink(name.c_str()) < 0) {
+        LOG_SYSERR << Fmt("ShmRing::unlink {}", name.c_str());
+    }
+}
+
+std::unique_ptr<ShmRing> ShmRing::map(int fd, size_t capacity) {
+    const size_t page = pageSize();
+    const size_t mappingSize = page + 2 * capacity;
+    // reserve the address range, then map the header and data, and the data once more behind.
+    void *reserved = ::mmap(nullptr, mappingSize, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (reserved == MAP_FAILED) {
+        LOG_SYSERR << "ShmRing::map";
+        ::close(fd);
+        return nullptr;
+    }
+    char *base = static_cast<char *>(reserved);
+    bool ok = ::mmap(base, page + capacity, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED &&
+              ::mmap(base + page + capacity, capacity, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED,
+                     fd, static_cast<off_t>(page)) != MAP_FAILED;
+    if (!ok) {
+        LOG_SYSERR << "ShmRing::map";
+    }
+    ::close(fd);
+    if (!ok) {
+        ::munmap(base, mappingSize);
+        return nullptr;
+    }
+    return std::unique_ptr<ShmRing>(new ShmRing(reinterpret_cast<Header *>(base), base, mappingSize));
+}
+
+ShmRing::ShmRing(Header *header, char *mapping, size_t mappingSize)
+        : header_(header),
+          data_(mapping + pageSize()),
+          mapping_(mapping),
+          mappingSize_(mappingSize),
+          capacity_((mappingSize - pageSize()) / 2),
+          writeIndex_(header->writeIndex.load(std::memory_order_relaxed)),
+          cachedReadIndex_(header->readIndex.load(std::memory_order_acquire)),
+          readIndex_(cachedReadIndex_),
+          cachedWriteIndex_(header->writeIndex.load(std::memory_order_acquire)) {}
+
+ShmRing::~ShmRing() {
+    ::munmap(mapping_, mappingSize_);
+}
+
+size_t ShmRing::writableBytes() {
+    cachedReadIndex_ = header_->readIndex.load(std::memory_order_acquire);
+    return capacity_ - static_cast<size_t>(writeIndex_ - cachedReadIndex_);
+}
+
+bool ShmRing::hasWritten(size_t len) {
+    assert(len <= capacity_ - static_cast<size_t>(writeIndex_ - cachedReadIndex_));
+    writeIndex_ += len;
+    header_->writeIndex.store(writeIndex_, std::memory_order_release);
+    // pairs with the fence of prepareWait(), one of the two sees the other's store.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    return header_->consumerWaiting.load(std::memory_order_relaxed) != 0 &&
+           header_->consumerWaiting.exchange(0, std::memory_order_relaxed) != 0;
+}
+
+bool ShmRing::append(const void *data, size_t len, bool *wake) {
+    if (capacity_ - static_cast<size_t>(writeIndex_ - cachedReadIndex_) < len && writableBytes() < len) {
+        return false;
+    }
+    memcpy(beginWrite(), data, len);
+    *wake = hasWritten(len);
+    return true;
+}
+
+size_t ShmRing::readableBytes() {
+    if (readIndex_ == cachedWriteIndex_) {
+        cachedWriteIndex_ = header_->writeIndex.load(std::memory_order_acquire);
+    }
+    return static_cast<size_t>(cachedWriteIndex_ - readIndex_);
+}
+
+void ShmRing::retrieve(size_t len) {
+    assert(len <= static_cast<size_t>(cachedWriteIndex_ - readIndex_));
+    readIndex_ += len;
+    header_->readIndex.store(readIndex_, std::memory_order_release);
+}
+
+bool ShmRing::prepareWait() {
+    header_->consumerWaiting.store(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    cachedWriteIndex_ = header_->writeIndex.load(std::memory_order_acquire);
+    if (cachedWriteIndex_ != readIndex_) {
+        cancelWait();
+        return false;
+    }
+    return true;
+}
+
+void ShmRing::cancelWait() {
+    header_->consumerWaiting.store(0, std::memory_order_relaxed);
+}
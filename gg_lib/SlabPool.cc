@@ -0,0 +1,61 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#include "gg_lib/SlabPool.h"
+
+#include <assert.h>
+#include <algorithm>
+#include <new>
+
+using namespace gg_lib;
+
+namespace {
+    constexpr size_t kBlockAlign = alignof(max_align_t);
+}
+
+SlabPool::SlabPool(size_t blocksPerSlab)
+        : blocksPerSlab_(blocksPerSlab),
+          blockSize_(0),
+          carve_(nullptr),
+          carveEnd_(nullptr) {
+    assert(blocksPerSlab > 0);
+}
+
+// blocks still queued live in the slabs, nothing to do for them.
+SlabPool::~SlabPool() = default;
+
+void *SlabPool::allocate(size_t size) {
+    if (blockSize_ == 0) {
+        blockSize_ = (std::max(size, sizeof(FreeBlock)) + kBlockAlign - 1) / kBlockAlign * kBlockAlign;
+    }
+    if (size > blockSize_) {
+        return ::operator new(size);
+    }
+    FreeBlock *block = freeBlocks_.pop();
+    if (block) {
+        block->~FreeBlock();
+        return block;
+    }
+    if (carve_ == carveEnd_) {
+        addSlab();
+    }
+    void *p = carve_;
+    carve_ += blockSize_;
+    return p;
+}
+
+void SlabPool::deallocate(void *p, size_t size) {
+    if (size > blockSize_) {
+        ::operator delete(p);
+        return;
+    }
+    freeBlocks_.push(new(p) FreeBlock);
+}
+
+void SlabPool::addSlab() {
+    const size_t bytes = blockSize_ * blocksPerSlab_;
+    // new char[] is aligned for any fundamental type.
+    slabs_.emplace_back(new char[bytes]);
+    carve_ = slabs_.back().get();
+    carveEnd_ = carve_ + bytes;
+}
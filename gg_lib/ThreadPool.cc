@@ -19,12 +19,13 @@ ThreadPool::~ThreadPool() {
         stop();
 }
 
-void ThreadPool::start(int numThreads) {
+void ThreadPool::start(int numThreads, const CpuAffinity &affinity) {
     assert(!running_ && threads_.empty());
     running_ = true;
+    affinity_ = affinity;
     threads_.reserve(numThreads);
     for (int i = 0; i < numThreads; ++i) {
-        threads_.emplace_back(new Thread(std::bind(&ThreadPool::runInThread, this),
+        threads_.emplace_back(new Thread(std::bind(&ThreadPool::runInThread, this, i),
                                          name_ + std::to_string(i)));
         threads_[i]->start();
     }
@@ -70,8 +71,9 @@ bool ThreadPool::isFull() const {
     return maxQueueSize_ > 0 && queue_.size() >= maxQueueSize_;
 }
 
-void ThreadPool::runInThread() {
+void ThreadPool::runInThread(int index) {
     try {
+        affinity_.applyToCurrentThread(index);
         if (threadInitCallback_) {
             threadInitCallback_();
         }
@@ -7,20 +7,56 @@
 
 #include <errno.h>
 #include <fcntl.h>
+#include <sys/stat.h>
 #include <unistd.h>
 
 using namespace gg_lib;
 using namespace gg_lib::net;
 
-Acceptor::Acceptor(EventLoop *loop, const InetAddress &listenAddr, bool reuseport)
+namespace {
+    string fileSystemPath(const InetAddress &addr) {
+        if (addr.family() != AF_UNIX) {
+            return string();
+        }
+        string path = addr.unixPath();
+        return path.empty() || path[0] == '@' ? string() : path;
+    }
+
+    /// A socket file nobody accepts on refuses connections, one which is still
+    /// served by another process is kept, so that binding fails. Other files
+    /// refuse connections too, they are never removed.
+    void removeStaleSocketFile(const InetAddress &addr, int socketType) {
+        struct stat st;
+        if (::lstat(addr.unixPath().c_str(), &st) < 0 || !S_ISSOCK(st.st_mode)) {
+            return;
+        }
+        int probe = sockets::createNonblockingOrDie(AF_UNIX, socketType);
+        if (sockets::connect(probe, addr.getSockAddr()) < 0 && errno == ECONNREFUSED) {
+            LOG_WARN << Fmt("Acceptor removes stale socket file {}", addr.unixPath());
+            ::unlink(addr.unixPath().c_str());
+        }
+        sockets::close(probe);
+    }
+}
+
+Acceptor::Acceptor(EventLoop *loop, const InetAddress &listenAddr, bool reuseport, int socketType)
         : loop_(loop),
-          acceptSocket_(sockets::createNonblockingOrDie(listenAddr.family())),
+          unixPath_(fileSystemPath(listenAddr)),
+          acceptSocket_(sockets::createNonblockingOrDie(listenAddr.family(), socketType)),
           acceptChannel_(loop, acceptSocket_.fd()),
           listening_(false),
           idleFd_(::open("/dev/null", O_RDONLY | O_CLOEXEC)) {
     assert(idleFd_ >= 0);
-    acceptSocket_.setReuseAddr(true);
-    acceptSocket_.setReusePort(reuseport);
+    if (listenAddr.family() == AF_UNIX) {
+        // a path can't be shared, SO_REUSEPORT means nothing to it.
+        if (!unixPath_.empty()) {
+            removeStaleSocketFile(listenAddr, socketType);
+        }
+    } else {
+        acceptSocket_.setReuseAddr(true);
+        acceptSocket_.setReusePort(reuseport);
+    }
+    acceptSocket_.setKeepAlive(true);
     acceptSocket_.bindAddress(listenAddr);
     acceptChannel_.setReadCallback(
             std::bind(&Acceptor::handleRead, this));
@@ -30,6 +66,9 @@ Acceptor::~Acceptor() {
     acceptChannel_.disableAll();
     acceptChannel_.remove();
     sockets::close(idleFd_);
+    if (!unixPath_.empty()) {
+        ::unlink(unixPath_.c_str());
+    }
 }
 
 void Acceptor::listen() {
@@ -2,6 +2,12 @@
 // Author: shr-go
 
 #include "gg_lib/net/Buffer.h"
+#include "gg_lib/Logging.h"
+
+#include <algorithm>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
 
 using namespace gg_lib;
 using namespace gg_lib::net;
@@ -9,3 +15,117 @@ using namespace gg_lib::net;
 constexpr char Buffer::kCRLF[];
 constexpr size_t Buffer::kInitialSize;
 constexpr size_t Buffer::kCheapPrepend;
+constexpr Buffer::LazyTag Buffer::kLazy;
+
+namespace {
+    // every thread keeps at most 4MB of free storage.
+    constexpr size_t kMaxPooledBytes = 4 * 1024 * 1024;
+    // storage grown past what one readFd() brings in is freed on release.
+    constexpr size_t kMaxPooledCapacity = Buffer::kCheapPrepend + Buffer::kExtraReadSize;
+
+    /// Free storage of the current thread, so that many buffers drained and
+    /// filled again share a few allocations.
+    class StoragePool : noncopyable {
+    public:
+        StoragePool() : pooledBytes_(0) {}
+
+        ~StoragePool() { t_destroyed = true; }
+
+        void acquire(std::vector<char> *storage) {
+            if (!free_.empty()) {
+                storage->swap(free_.back());
+                free_.pop_back();
+                pooledBytes_ -= storage->capacity();
+            }
+        }
+
+        void release(std::vector<char> *storage) {
+            const size_t capacity = storage->capacity();
+            if (capacity <= kMaxPooledCapacity && pooledBytes_ + capacity <= kMaxPooledBytes) {
+                free_.push_back(std::move(*storage));
+                pooledBytes_ += capacity;
+            }
+            std::vector<char>().swap(*storage);
+        }
+
+        /// Buffers released after the pool is gone at thread exit just free their storage.
+        static __thread bool t_destroyed;
+
+    private:
+        std::vector<std::vector<char>> free_;
+        size_t pooledBytes_;
+    };
+
+    __thread bool StoragePool::t_destroyed = false;
+
+    thread_local StoragePool t_storagePool;
+}
+
+void Buffer::release() {
+    assert(readableBytes() == 0);
+    if (buffer_.empty()) {
+        return;
+    }
+    if (StoragePool::t_destroyed) {
+        std::vector<char>().swap(buffer_);
+    } else {
+        t_storagePool.release(&buffer_);
+    }
+    readerIndex_ = 0;
+    writerIndex_ = 0;
+}
+
+ssize_t Buffer::readFdWithFds(int fd, std::vector<int> *fds, int *savedErrno) {
+    if (!hasStorage()) {
+        acquire(0);
+    }
+    char extrabuf[kExtraReadSize];
+    struct iovec vec[2];
+    const size_t writable = writableBytes();
+    vec[0].iov_base = begin() + writerIndex_;
+    vec[0].iov_len = writable;
+    vec[1].iov_base = extrabuf;
+    vec[1].iov_len = sizeof extrabuf;
+    union {
+        char buf[CMSG_SPACE(sizeof(int) * sockets::kMaxPassedFds)];
+        struct cmsghdr align;
+    } control;
+    struct msghdr msg{};
+    msg.msg_iov = vec;
+    msg.msg_iovlen = (writable < sizeof extrabuf) ? 2 : 1;
+    msg.msg_control = control.buf;
+    msg.msg_controllen = sizeof control.buf;
+    const ssize_t n = sockets::recvmsg(fd, &msg, MSG_CMSG_CLOEXEC);
+    if (n < 0) {
+        *savedErrno = errno;
+        return n;
+    }
+    for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+        if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS) {
+            const size_t count = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+            const size_t oldSize = fds->size();
+            fds->resize(oldSize + count);
+            memcpy(fds->data() + oldSize, CMSG_DATA(cmsg), count * sizeof(int));
+        }
+    }
+    if (msg.msg_flags & MSG_CTRUNC) {
+        LOG_ERROR << Fmt("Buffer::readFdWithFds - more than {} descriptors passed, the rest are closed",
+                         sockets::kMaxPassedFds);
+    }
+    hasRead(static_cast<size_t>(n), writable, extrabuf);
+    return n;
+}
+
+void Buffer::acquire(size_t len) {
+    assert(buffer_.empty());
+    if (!StoragePool::t_destroyed) {
+        t_storagePool.acquire(&buffer_);
+    }
+    // pooled storage keeps its size, fresh storage starts at kInitialSize.
+    const size_t size = kCheapPrepend + std::max(len, kInitialSize);
+    if (buffer_.size() < size) {
+        buffer_.resize(size);
+    }
+    readerIndex_ = kCheapPrepend;
+    writerIndex_ = kCheapPrepend;
+}
@@ -0,0 +1,375 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#include "gg_lib/net/ChainBuffer.h"
+#include "gg_lib/net/Buffer.h"
+#include "gg_lib/net/SocketsHelper.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <new>
+
+using namespace gg_lib;
+using namespace gg_lib::net;
+
+constexpr size_t ChainBuffer::kBlockSize;
+constexpr int ChainBuffer::kMaxIovec;
+constexpr size_t ChainBuffer::kMinSliceSize;
+
+struct ChainBuffer::Block {
+    Block *next;
+    char *reader;
+    char *writer;
+    // bytes of a slice are owned elsewhere and never written.
+    bool slice;
+
+    char *begin() { return reinterpret_cast<char *>(this + 1); }
+
+    char *end() { return reinterpret_cast<char *>(this) + kBlockSize; }
+
+    size_t readableBytes() const { return writer - reader; }
+
+    size_t writableBytes() { return slice ? 0 : end() - writer; }
+};
+
+struct ChainBuffer::SliceBlock : ChainBuffer::Block {
+    std::shared_ptr<const void> owner;
+};
+
+namespace {
+    // every thread keeps at most 4MB of free blocks.
+    constexpr size_t kMaxPooledBlocks = 256;
+    // readFd reads at most 64KB like Buffer::readFd.
+    constexpr int kReadBlocks = 4;
+
+    struct FreeBlock {
+        FreeBlock *next;
+    };
+
+    /// Free blocks of the current thread, so that buffers drained and filled
+    /// again over and over don't go to malloc.
+    class BlockPool : noncopyable {
+    public:
+        BlockPool() : freeBlocks_(nullptr), numFreeBlocks_(0) {}
+
+        ~BlockPool() {
+            while (freeBlocks_) {
+                FreeBlock *block = freeBlocks_;
+                freeBlocks_ = block->next;
+                ::free(block);
+            }
+            t_destroyed = true;
+        }
+
+        void *acquire() {
+            if (freeBlocks_) {
+                FreeBlock *block = freeBlocks_;
+                freeBlocks_ = block->next;
+                --numFreeBlocks_;
+                return block;
+            }
+            return ::malloc(ChainBuffer::kBlockSize);
+        }
+
+        void release(void *mem) {
+            if (numFreeBlocks_ >= kMaxPooledBlocks) {
+                ::free(mem);
+            } else {
+                auto *block = static_cast<FreeBlock *>(mem);
+                block->next = freeBlocks_;
+                freeBlocks_ = block;
+                ++numFreeBlocks_;
+            }
+        }
+
+        /// Blocks released after the pool is gone at thread exit,
+        /// e.g. by buffers in static objects, are freed directly.
+        static __thread bool t_destroyed;
+
+    private:
+        FreeBlock *freeBlocks_;
+        size_t numFreeBlocks_;
+    };
+
+    __thread bool BlockPool::t_destroyed = false;
+
+    thread_local BlockPool t_blockPool;
+
+    void *acquireBlock() {
+        void *mem = BlockPool::t_destroyed ? ::malloc(ChainBuffer::kBlockSize) : t_blockPool.acquire();
+        if (!mem) {
+            throw std::bad_alloc();
+        }
+        return mem;
+    }
+
+    void releaseBlock(void *mem) {
+        if (BlockPool::t_destroyed) {
+            ::free(mem);
+        } else {
+            t_blockPool.release(mem);
+        }
+    }
+}
+
+ChainBuffer::ChainBuffer(ChainBuffer &&rhs) noexcept
+        : head_(rhs.head_), tail_(rhs.tail_), readable_(rhs.readable_) {
+    rhs.head_ = rhs.tail_ = nullptr;
+    rhs.readable_ = 0;
+}
+
+ChainBuffer &ChainBuffer::operator=(ChainBuffer &&rhs) noexcept {
+    if (this != &rhs) {
+        retrieveAll();
+        swap(rhs);
+    }
+    return *this;
+}
+
+void ChainBuffer::swap(ChainBuffer &rhs) noexcept {
+    std::swap(head_, rhs.head_);
+    std::swap(tail_, rhs.tail_);
+    std::swap(readable_, rhs.readable_);
+}
+
+const char *ChainBuffer::peek() const {
+    return head_ ? head_->reader : nullptr;
+}
+
+size_t ChainBuffer::peekableBytes() const {
+    return head_ ? head_->readableBytes() : 0;
+}
+
+void ChainBuffer::retrieve(size_t len) {
+    assert(len <= readable_);
+    readable_ -= len;
+    while (len > 0) {
+        size_t n = head_->readableBytes();
+        if (len < n) {
+            head_->reader += len;
+            break;
+        }
+        len -= n;
+        popHead();
+    }
+}
+
+void ChainBuffer::retrieve(size_t len, ChainBuffer *keep) {
+    assert(len <= readable_);
+    assert(keep != this);
+    readable_ -= len;
+    while (len > 0) {
+        size_t n = head_->readableBytes();
+        if (len < n) {
+            head_->reader += len;
+            break;
+        }
+        len -= n;
+        Block *block = head_;
+        head_ = block->next;
+        if (!head_) {
+            tail_ = nullptr;
+        }
+        block->reader = block->writer;
+        block->next = nullptr;
+        if (keep->tail_) {
+            keep->tail_->next = block;
+        } else {
+            keep->head_ = block;
+        }
+        keep->tail_ = block;
+    }
+}
+
+void ChainBuffer::retrieveAll() {
+    while (head_) {
+        popHead();
+    }
+    readable_ = 0;
+}
+
+string ChainBuffer::retrieveAsString(size_t len) {
+    assert(len <= readable_);
+    string result;
+    result.reserve(len);
+    size_t remaining = len;
+    for (Block *block = head_; remaining > 0; block = block->next) {
+        size_t n = std::min(remaining, block->readableBytes());
+        result.append(block->reader, n);
+        remaining -= n;
+    }
+    retrieve(len);
+    return result;
+}
+
+void ChainBuffer::appendSlice(const string_view &data, std::shared_ptr<const void> owner) {
+    if (data.size() < kMinSliceSize) {
+        append(data);
+        return;
+    }
+    auto *block = new SliceBlock;
+    block->next = nullptr;
+    block->reader = const_cast<char *>(data.data());
+    block->writer = block->reader + data.size();
+    block->slice = true;
+    block->owner = std::move(owner);
+    if (tail_) {
+        tail_->next = block;
+    } else {
+        head_ = block;
+    }
+    tail_ = block;
+    readable_ += data.size();
+}
+
+void ChainBuffer::append(Buffer &&buffer) {
+    if (buffer.readableBytes() < kMinSliceSize) {
+        append(buffer.peek(), buffer.readableBytes());
+        buffer.retrieveAll();
+        return;
+    }
+    auto owner = std::make_shared<Buffer>(0);
+    owner->swap(buffer);
+    string_view data = owner->toStringView();
+    appendSlice(data, std::move(owner));
+}
+
+void ChainBuffer::append(ChainBuffer &&other) {
+    if (!head_) {
+        swap(other);
+        return;
+    }
+    if (other.head_) {
+        tail_->next = other.head_;
+        tail_ = other.tail_;
+        readable_ += other.readable_;
+        other.head_ = other.tail_ = nullptr;
+        other.readable_ = 0;
+    }
+}
+
+void ChainBuffer::append(const char *data, size_t len) {
+    readable_ += len;
+    while (len > 0) {
+        if (!tail_ || tail_->writableBytes() == 0) {
+            newTail();
+        }
+        size_t n = std::min(len, tail_->writableBytes());
+        memcpy(tail_->writer, data, n);
+        tail_->writer += n;
+        data += n;
+        len -= n;
+    }
+}
+
+int ChainBuffer::fillIovec(struct iovec *iov, int maxIovec) const {
+    int iovcnt = 0;
+    for (Block *block = head_; block && iovcnt < maxIovec; block = block->next) {
+        iov[iovcnt].iov_base = block->reader;
+        iov[iovcnt].iov_len = block->readableBytes();
+        ++iovcnt;
+    }
+    return iovcnt;
+}
+
+ssize_t ChainBuffer::readFd(int fd, int *savedErrno) {
+    struct iovec vec[kReadBlocks + 1];
+    Block *fresh[kReadBlocks];
+    int iovcnt = 0;
+    const size_t tailWritable = tail_ ? tail_->writableBytes() : 0;
+    if (tailWritable > 0) {
+        vec[iovcnt].iov_base = tail_->writer;
+        vec[iovcnt].iov_len = tailWritable;
+        ++iovcnt;
+    }
+    for (Block *&block: fresh) {
+        block = newBlock();
+        vec[iovcnt].iov_base = block->writer;
+        vec[iovcnt].iov_len = block->writableBytes();
+        ++iovcnt;
+    }
+    const ssize_t n = sockets::readv(fd, vec, iovcnt);
+    if (n < 0) {
+        *savedErrno = errno;
+    }
+    size_t remaining = n > 0 ? static_cast<size_t>(n) : 0;
+    readable_ += remaining;
+    if (tailWritable > 0) {
+        size_t len = std::min(remaining, tailWritable);
+        tail_->writer += len;
+        remaining -= len;
+    }
+    for (Block *block: fresh) {
+        if (remaining > 0) {
+            size_t len = std::min(remaining, block->writableBytes());
+            block->writer += len;
+            remaining -= len;
+            if (tail_) {
+                tail_->next = block;
+            } else {
+                head_ = block;
+            }
+            tail_ = block;
+        } else {
+            freeBlock(block);
+        }
+    }
+    /// Don't loop read here, cause peer may send lots of data which can crash program.
+    return n;
+}
+
+ssize_t ChainBuffer::writeFd(int fd, int *savedErrno) {
+    struct iovec vec[kMaxIovec];
+    const int iovcnt = fillIovec(vec, kMaxIovec);
+    const ssize_t n = sockets::writev(fd, vec, iovcnt);
+    if (n > 0) {
+        retrieve(static_cast<size_t>(n));
+    } else if (n < 0) {
+        *savedErrno = errno;
+    }
+    return n;
+}
+
+size_t ChainBuffer::numBlocks() const {
+    size_t n = 0;
+    for (Block *block = head_; block; block = block->next) {
+        ++n;
+    }
+    return n;
+}
+
+ChainBuffer::Block *ChainBuffer::newBlock() {
+    auto *block = new(acquireBlock()) Block{nullptr, nullptr, nullptr, false};
+    block->reader = block->writer = block->begin();
+    return block;
+}
+
+void ChainBuffer::freeBlock(Block *block) {
+    if (block->slice) {
+        delete static_cast<SliceBlock *>(block);
+    } else {
+        releaseBlock(block);
+    }
+}
+
+ChainBuffer::Block *ChainBuffer::newTail() {
+    Block *block = newBlock();
+    if (tail_) {
+        tail_->next = block;
+    } else {
+        head_ = block;
+    }
+    tail_ = block;
+    return block;
+}
+
+void ChainBuffer::popHead() {
+    Block *block = head_;
+    head_ = block->next;
+    if (!head_) {
+        tail_ = nullptr;
+    }
+    freeBlock(block);
+}
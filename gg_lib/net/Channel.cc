@@ -17,6 +17,7 @@ Channel::Channel(EventLoop *loop, int fd)
           revents_(0),
           index_(-1),
           logHup_(true),
+          edgeTriggered_(false),
           tied_(false),
           eventHandling_(false),
           addedToLoop_(false) {}
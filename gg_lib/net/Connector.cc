@@ -0,0 +1,207 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#include "gg_lib/net/Connector.h"
+#include "gg_lib/net/Channel.h"
+#include "gg_lib/net/EventLoop.h"
+#include "gg_lib/Logging.h"
+
+#include <errno.h>
+#include <algorithm>
+
+using namespace gg_lib;
+using namespace gg_lib::net;
+
+constexpr double Connector::kDefaultInitRetryDelay;
+constexpr double Connector::kDefaultMaxRetryDelay;
+
+Connector::Connector(EventLoop *loop, const InetAddress &serverAddr)
+        : loop_(CHECK_NOTNULL(loop)),
+          serverAddr_(serverAddr),
+          socketType_(SOCK_STREAM),
+          connect_(false),
+          state_(kDisconnected),
+          initRetryDelay_(kDefaultInitRetryDelay),
+          maxRetryDelay_(kDefaultMaxRetryDelay),
+          retryDelay_(kDefaultInitRetryDelay),
+          maxRetries_(-1),
+          retries_(0),
+          retryTimer_(0),
+          retryScheduled_(false) {
+    LOG_DEBUG << Fmt("Connector::ctor[{}]", static_cast<void *>(this));
+}
+
+Connector::~Connector() {
+    LOG_DEBUG << Fmt("Connector::dtor[{}]", static_cast<void *>(this));
+    assert(!channel_);
+}
+
+void Connector::setRetryDelay(double initDelay, double maxDelay) {
+    assert(initDelay > 0 && initDelay <= maxDelay);
+    initRetryDelay_ = initDelay;
+    maxRetryDelay_ = maxDelay;
+    retryDelay_ = initDelay;
+}
+
+void Connector::start() {
+    connect_ = true;
+    loop_->runInLoop(std::bind(&Connector::startInLoop, shared_from_this()));
+}
+
+void Connector::restart() {
+    loop_->assertInLoopThread();
+    state_ = kDisconnected;
+    retryDelay_ = initRetryDelay_;
+    retries_ = 0;
+    connect_ = true;
+    startInLoop();
+}
+
+void Connector::stop() {
+    connect_ = false;
+    loop_->runInLoop(std::bind(&Connector::stopInLoop, shared_from_this()));
+}
+
+void Connector::startInLoop() {
+    loop_->assertInLoopThread();
+    retryScheduled_ = false;
+    if (connect_ && state_ == kDisconnected) {
+        connect();
+    } else {
+        LOG_DEBUG << "Connector::startInLoop - do not connect";
+    }
+}
+
+void Connector::stopInLoop() {
+    loop_->assertInLoopThread();
+    if (retryScheduled_) {
+        loop_->cancel(retryTimer_);
+        retryScheduled_ = false;
+    }
+    if (state_ == kConnecting) {
+        state_ = kDisconnected;
+        sockets::close(removeAndResetChannel());
+    }
+}
+
+void Connector::connect() {
+    int sockfd = sockets::createNonblockingOrDie(serverAddr_.family(), socketType_);
+    // set before connecting, the TcpConnection leaves the options of the socket alone.
+    int on = 1;
+    ::setsockopt(sockfd, SOL_SOCKET, SO_KEEPALIVE, &on, static_cast<socklen_t>(sizeof on));
+    int ret = sockets::connect(sockfd, serverAddr_.getSockAddr());
+    int savedErrno = (ret == 0) ? 0 : errno;
+    switch (savedErrno) {
+        case 0:
+        case EINPROGRESS:
+        case EINTR:
+        case EISCONN:
+            connecting(sockfd);
+            break;
+
+        case EAGAIN:
+        case EADDRINUSE:
+        case EADDRNOTAVAIL:
+        case ECONNREFUSED:
+        case ENETUNREACH:
+        // an AF_UNIX path the server hasn't bound yet.
+        case ENOENT:
+            retry(sockfd, savedErrno);
+            break;
+
+        default:
+            // EACCES, EAFNOSUPPORT, EBADF and such won't go away by retrying.
+            errno = savedErrno;
+            LOG_SYSERR << Fmt("Connector::connect to {}", serverAddr_.toIpPort());
+            sockets::close(sockfd);
+            connect_ = false;
+            if (failureCallback_) {
+                failureCallback_(savedErrno);
+            }
+            break;
+    }
+}
+
+void Connector::connecting(int sockfd) {
+    state_ = kConnecting;
+    assert(!channel_);
+    channel_.reset(new Channel(loop_, sockfd));
+    channel_->setWriteCallback(std::bind(&Connector::handleWrite, this));
+    channel_->setErrorCallback(std::bind(&Connector::handleError, this));
+    channel_->enableWriting();
+}
+
+int Connector::removeAndResetChannel() {
+    channel_->disableAll();
+    channel_->remove();
+    int sockfd = channel_->fd();
+    // the channel is handling the event which brought us here, it can't be destroyed yet.
+    loop_->queueInLoop(std::bind(&Connector::resetChannel, shared_from_this()));
+    return sockfd;
+}
+
+void Connector::resetChannel() {
+    channel_.reset();
+}
+
+void Connector::handleWrite() {
+    LOG_TRACE << Fmt("Connector::handleWrite state={}", static_cast<int>(state_));
+    if (state_ != kConnecting) {
+        return;
+    }
+    int sockfd = removeAndResetChannel();
+    int err = sockets::getSocketError(sockfd);
+    if (err) {
+        LOG_WARN << Fmt("Connector::handleWrite - SO_ERROR = {} {}", err, strerror_tr(err));
+        retry(sockfd, err);
+    } else if (sockets::isSelfConnect(sockfd)) {
+        LOG_WARN << "Connector::handleWrite - Self connect";
+        retry(sockfd, ECONNREFUSED);
+    } else {
+        state_ = kConnected;
+        if (connect_) {
+            newConnectionCallback_(sockfd);
+        } else {
+            sockets::close(sockfd);
+        }
+    }
+}
+
+void Connector::handleError() {
+    LOG_ERROR << Fmt("Connector::handleError state={}", static_cast<int>(state_));
+    if (state_ == kConnecting) {
+        int sockfd = removeAndResetChannel();
+        int err = sockets::getSocketError(sockfd);
+        LOG_TRACE << Fmt("SO_ERROR = {} {}", err, strerror_tr(err));
+        retry(sockfd, err);
+    }
+}
+
+void Connector::retry(int sockfd, int savedErrno) {
+    sockets::close(sockfd);
+    state_ = kDisconnected;
+    if (!connect_) {
+        LOG_DEBUG << "Connector::retry - do not connect";
+    } else if (maxRetries_ >= 0 && retries_ >= maxRetries_) {
+        LOG_WARN << Fmt("Connector::retry - give up connecting to {} after {} retries",
+                        serverAddr_.toIpPort(), retries_);
+        connect_ = false;
+        if (failureCallback_) {
+            failureCallback_(savedErrno);
+        }
+    } else {
+        ++retries_;
+        LOG_INFO << Fmt("Connector::retry - Retry connecting to {} in {} seconds",
+                        serverAddr_.toIpPort(), retryDelay_);
+        // the timer doesn't keep the connector alive.
+        std::weak_ptr<Connector> weakSelf(shared_from_this());
+        retryTimer_ = loop_->runAfter(retryDelay_, [weakSelf] {
+            ConnectorPtr self = weakSelf.lock();
+            if (self) {
+                self->startInLoop();
+            }
+        });
+        retryScheduled_ = true;
+        retryDelay_ = std::min(retryDelay_ * 2, maxRetryDelay_);
+    }
+}
@@ -44,18 +44,27 @@ EventLoop *EventLoop::getEventLoopOfCurrentThread() {
     return t_loopInThisThread;
 }
 
-EventLoop::EventLoop()
+EventLoop::EventLoop(TimerQueueType timerQueueType)
         : looping_(false),
           quit_(false),
           eventHandling_(false),
           callingPendingFunctors_(false),
+          spinning_(false),
           iteration_(0),
           threadId_(CurrentThread::tid()),
           poller_(Poller::newDefaultPoller(this)),
-          timerQueue_(new TimerQueue(this)),
+          timerQueue_(TimerQueue::newTimerQueue(this, timerQueueType)),
           wakeupFd_(createEventFd()),
           wakeupChannel_(new Channel(this, wakeupFd_)),
-          currentActiveChannel_(nullptr) {
+          currentActiveChannel_(nullptr),
+          wakeupPending_(false),
+          numConnections_(0),
+          queuedFunctors_(0),
+          ranFunctors_(0),
+          busyMicroSeconds_(0),
+          spinMicroSeconds_(0),
+          emptySpins_(0),
+          busyPollMicroSeconds_(0) {
     LOG_DEBUG << "EventLoop created " << this << " in thread" << CurrentThread::tidString();
     if (t_loopInThisThread) {
         LOG_FATAL << "Another EventLoop " << t_loopInThisThread
@@ -74,6 +83,9 @@ EventLoop::~EventLoop() {
     wakeupChannel_->disableAll();
     wakeupChannel_->remove();
     ::close(wakeupFd_);
+    while (PendingFunctor *pending = pendingFunctors_.pop()) {
+        delete pending;
+    }
     t_loopInThisThread = nullptr;
 }
 
@@ -83,14 +95,23 @@ void EventLoop::loop() {
     looping_ = true;
     quit_ = false;
     LOG_TRACE << "EventLoop " << this << " start looping";
+    int64_t iterationEnd = Timestamp::now().microSecondsSinceEpoch();
+    int64_t lastActive = iterationEnd;
     while (true) {
-        {
-            std::lock_guard<std::mutex> lk(mutex_);
-            if (quit_)
-                break;
+        if (quit_) {
+            break;
         }
         activeChannels_.clear();
-        pollReturnTime_ = poller_->poll(kPollTimeMs, &activeChannels_);
+        const int64_t busyPoll = busyPollMicroSeconds_.load(std::memory_order_relaxed);
+        const bool wasSpinning = spinning_;
+        spinning_ = busyPoll > 0 && iterationEnd - lastActive < busyPoll;
+        if (wasSpinning && !spinning_) {
+            // left set while spinning, producers may have skipped the wakeup.
+            wakeupPending_.store(false);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            spinning_ = !pendingFunctors_.empty();
+        }
+        pollReturnTime_ = poller_->poll(spinning_ ? 0 : kPollTimeMs, &activeChannels_);
         ++iteration_;
         if (canLevelLog(Logger::TRACE)) {
             printActiveChannels();
@@ -101,15 +122,29 @@ void EventLoop::loop() {
             currentActiveChannel_->handleEvent(pollReturnTime_);
         }
         currentActiveChannel_ = nullptr;
+        poller_->dispatchCompletions();
         eventHandling_ = false;
+        const int64_t ranBefore = ranFunctors_.load(std::memory_order_relaxed);
         doPendingFunctors();
+        const bool active = !activeChannels_.empty() || ranFunctors_.load(std::memory_order_relaxed) != ranBefore;
+        // single writer, no need for fetch_add.
+        const int64_t now = Timestamp::now().microSecondsSinceEpoch();
+        if (spinning_ && !active) {
+            spinMicroSeconds_.store(spinMicroSeconds_.load(std::memory_order_relaxed) + now - iterationEnd,
+                                    std::memory_order_relaxed);
+            emptySpins_.store(emptySpins_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        } else {
+            busyMicroSeconds_.store(busyMicroSeconds_.load(std::memory_order_relaxed) +
+                                    now - pollReturnTime_.microSecondsSinceEpoch(), std::memory_order_relaxed);
+            lastActive = now;
+        }
+        iterationEnd = now;
     }
     LOG_TRACE << "EventLoop " << this << " stop looping";
     looping_ = false;
 }
 
 void EventLoop::quit() {
-    std::lock_guard<std::mutex> lk(mutex_);
     quit_ = true;
     if (!isInLoopThread()) {
         wakeup();
@@ -125,11 +160,9 @@ void EventLoop::runInLoop(Functor cb) {
 }
 
 void EventLoop::queueInLoop(Functor cb) {
-    {
-        std::lock_guard<std::mutex> lk(mutex_);
-        pendingFunctors_.push_back(std::move(cb));
-    }
-    if (!isInLoopThread() || callingPendingFunctors_) {
+    queuedFunctors_.fetch_add(1, std::memory_order_relaxed);
+    pendingFunctors_.push(new PendingFunctor(std::move(cb)));
+    if ((!isInLoopThread() || callingPendingFunctors_) && !wakeupPending_.exchange(true)) {
         wakeup();
     }
 }
@@ -175,6 +208,29 @@ bool EventLoop::hasChannel(Channel *channel) {
     return poller_->hasChannel(channel);
 }
 
+bool EventLoop::supportsCompletionIo() const {
+    return poller_->supportsCompletion();
+}
+
+bool EventLoop::supportsEdgeTriggered() const {
+    return poller_->supportsEdgeTriggered();
+}
+
+uint64_t EventLoop::submitRecv(int fd, void *buf, size_t len, IoCompletionCallback cb) {
+    assertInLoopThread();
+    return poller_->submitRecv(fd, buf, len, std::move(cb));
+}
+
+uint64_t EventLoop::submitSend(int fd, const struct iovec *iov, int iovcnt, IoCompletionCallback cb) {
+    assertInLoopThread();
+    return poller_->submitSend(fd, iov, iovcnt, std::move(cb));
+}
+
+void EventLoop::cancelOperation(uint64_t operationId) {
+    assertInLoopThread();
+    poller_->cancelOperation(operationId);
+}
+
 void EventLoop::abortNotInLoopThread() {
     LOG_FATAL << "EventLoop::abortNotInLoopThread - EventLoop " << this
               << " was created in threadId_ = " << Thread::tidToString(threadId_)
@@ -198,18 +254,42 @@ void EventLoop::handleRead() const {
 }
 
 void EventLoop::doPendingFunctors() {
-    std::vector<Functor> functors;
     callingPendingFunctors_ = true;
-    {
-        std::lock_guard<std::mutex> lk(mutex_);
-        functors.swap(pendingFunctors_);
-    }
-    for (const Functor &functor: functors) {
-        functor();
+    // cleared before draining, a functor queued after this either is run
+    // below or writes wakeupFd_ again. Left set while spinning, the next
+    // poll doesn't block anyway.
+    wakeupPending_.store(spinning_);
+    // functors queued by these functors run in the next iteration. Counted before
+    // being pushed, so each one popped here is in the count.
+    const int64_t queued = numPendingFunctors();
+    int64_t ran = 0;
+    while (ran < queued) {
+        PendingFunctor *pending = pendingFunctors_.pop();
+        if (!pending) {
+            // the producer of the next one is inside push(), it will wake us up.
+            break;
+        }
+        pending->functor();
+        delete pending;
+        ++ran;
     }
+    ranFunctors_.store(ranFunctors_.load(std::memory_order_relaxed) + ran, std::memory_order_relaxed);
     callingPendingFunctors_ = false;
 }
 
+EventLoop::Stats EventLoop::stats() const {
+    Stats stats{};
+    stats.busyMicroSeconds = busyMicroSeconds_.load(std::memory_order_relaxed);
+    stats.spinMicroSeconds = spinMicroSeconds_.load(std::memory_order_relaxed);
+    stats.emptySpins = emptySpins_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+bool EventLoop::setKernelBusyPoll(int microSeconds, int budget) {
+    assertInLoopThread();
+    return poller_->setBusyPoll(microSeconds, budget);
+}
+
 void EventLoop::printActiveChannels() const {
     for (const Channel *channel: activeChannels_) {
         LOG_TRACE << "{" << channel->reventsToString() << "}";
@@ -10,11 +10,17 @@ using namespace gg_lib;
 using namespace gg_lib::net;
 
 EventLoopThread::EventLoopThread(EventLoopThread::ThreadInitCallback cb,
-                                 const string &name)
+                                 const string &name,
+                                 TimerQueueType timerQueueType,
+                                 const CpuAffinity &affinity,
+                                 int affinityIndex)
         : loop_(nullptr),
           exiting_(false),
           thread_(std::bind(&EventLoopThread::threadFunc, this), name),
-          callback_(std::move(cb)) {}
+          callback_(std::move(cb)),
+          timerQueueType_(timerQueueType),
+          affinity_(affinity),
+          affinityIndex_(affinityIndex) {}
 
 
 EventLoopThread::~EventLoopThread() {
@@ -40,7 +46,9 @@ EventLoop *EventLoopThread::startLoop() {
 }
 
 void EventLoopThread::threadFunc() {
-    EventLoop loop;
+    // before the loop, so that it allocates on the node it runs on.
+    affinity_.applyToCurrentThread(affinityIndex_);
+    EventLoop loop(timerQueueType_);
     if (callback_) {
         callback_(&loop);
     }
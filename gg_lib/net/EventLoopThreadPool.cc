@@ -3,6 +3,7 @@
 
 #include "gg_lib/net/EventLoopThreadPool.h"
 
+#include <algorithm>
 #include <utility>
 #include "gg_lib/net/EventLoop.h"
 #include "gg_lib/net/EventLoopThread.h"
@@ -10,12 +11,17 @@
 using namespace gg_lib;
 using namespace gg_lib::net;
 
+constexpr int64_t EventLoopThreadPool::kLoadSampleInterval;
+
 EventLoopThreadPool::EventLoopThreadPool(EventLoop *baseLoop, string nameArg)
         : baseLoop_(baseLoop),
           name_(std::move(nameArg)),
           started_(false),
           numThreads_(0),
-          next_(0) {}
+          next_(0),
+          timerQueueType_(kHeapTimerQueue),
+          placementPolicy_(kRoundRobin),
+          randomState_(0x9e3779b97f4a7c15ULL) {}
 
 EventLoopThreadPool::~EventLoopThreadPool() {};
 
@@ -29,9 +35,13 @@ void EventLoopThreadPool::start(const ThreadInitCallback &cb) {
     for (int i = 0; i < numThreads_; ++i) {
         char buf[name_.size() + 32];
         snprintf(buf, sizeof buf, "%s-%d", name_.c_str(), i);
-        threads_.push_back(make_unique<EventLoopThread>(cb, string(buf)));
+        threads_.push_back(make_unique<EventLoopThread>(cb, string(buf), timerQueueType_, affinity_, i));
         loops_.push_back(threads_.back()->startLoop());
     }
+    int64_t now = Timestamp::now().microSecondsSinceEpoch();
+    for (EventLoop *loop: loops_) {
+        loadSamples_.push_back(LoadSample{loop->busyMicroSeconds(), now, 0.0});
+    }
     if (numThreads_ == 0 && cb) {
         cb(baseLoop_);
     }
@@ -41,15 +51,88 @@ EventLoop *EventLoopThreadPool::getNextLoop() {
     baseLoop_->assertInLoopThread();
     assert(started_);
     EventLoop *loop = baseLoop_;
-    if (!loops_.empty()) {
-        loop = loops_[next_++];
-        if (static_cast<size_t>(next_) >= loops_.size()) {
-            next_ = 0;
+    if (loops_.empty()) {
+        return loop;
+    }
+    switch (placementPolicy_) {
+        case kLeastConnections: {
+            size_t index = leastConnectionsIndex();
+            next_ = static_cast<int>((index + 1) % loops_.size());
+            loop = loops_[index];
+            break;
+        }
+        case kLeastPendingFunctors: {
+            size_t index = leastPendingFunctorsIndex();
+            next_ = static_cast<int>((index + 1) % loops_.size());
+            loop = loops_[index];
+            break;
         }
+        case kPowerOfTwoChoices:
+            loop = loops_[powerOfTwoChoicesIndex()];
+            break;
+        default:
+            loop = loops_[next_++];
+            if (static_cast<size_t>(next_) >= loops_.size()) {
+                next_ = 0;
+            }
     }
     return loop;
 }
 
+double EventLoopThreadPool::loadScore(size_t index) {
+    baseLoop_->assertInLoopThread();
+    assert(index < loadSamples_.size());
+    LoadSample &sample = loadSamples_[index];
+    int64_t now = Timestamp::now().microSecondsSinceEpoch();
+    if (now - sample.time >= kLoadSampleInterval) {
+        int64_t busy = loops_[index]->busyMicroSeconds();
+        double fraction = static_cast<double>(busy - sample.busyMicroSeconds) / static_cast<double>(now - sample.time);
+        sample.score = (sample.score + std::min(fraction, 1.0)) / 2;
+        sample.busyMicroSeconds = busy;
+        sample.time = now;
+    }
+    return sample.score;
+}
+
+// ties go to the loop after the last pick, so that equal loads still spread.
+size_t EventLoopThreadPool::leastConnectionsIndex() const {
+    size_t best = next_;
+    for (size_t i = 1; i < loops_.size(); ++i) {
+        size_t index = (next_ + i) % loops_.size();
+        if (loops_[index]->numConnections() < loops_[best]->numConnections()) {
+            best = index;
+        }
+    }
+    return best;
+}
+
+size_t EventLoopThreadPool::leastPendingFunctorsIndex() const {
+    size_t best = next_;
+    for (size_t i = 1; i < loops_.size(); ++i) {
+        size_t index = (next_ + i) % loops_.size();
+        if (loops_[index]->numPendingFunctors() < loops_[best]->numPendingFunctors()) {
+            best = index;
+        }
+    }
+    return best;
+}
+
+size_t EventLoopThreadPool::powerOfTwoChoicesIndex() {
+    // xorshift64, the base loop thread is the only user.
+    randomState_ ^= randomState_ << 13;
+    randomState_ ^= randomState_ >> 7;
+    randomState_ ^= randomState_ << 17;
+    const size_t n = loops_.size();
+    size_t first = randomState_ % n;
+    size_t second = n > 1 ? (first + 1 + (randomState_ >> 32) % (n - 1)) % n : first;
+    double firstScore = loadScore(first);
+    double secondScore = loadScore(second);
+    if (firstScore != secondScore) {
+        return firstScore < secondScore ? first : second;
+    }
+    return loops_[first]->numConnections() <= loops_[second]->numConnections() ? first : second;
+}
+
 EventLoop *EventLoopThreadPool::getLoopForHash(size_t hash) {
     baseLoop_->assertInLoopThread();
     EventLoop *loop = baseLoop_;
@@ -0,0 +1,90 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#include "gg_lib/net/IdleReaper.h"
+#include "gg_lib/net/EventLoop.h"
+#include "gg_lib/net/TcpConnection.h"
+#include "gg_lib/Logging.h"
+
+#include <algorithm>
+
+using namespace gg_lib;
+using namespace gg_lib::net;
+
+constexpr int IdleReaper::kBucketsPerTimeout;
+
+IdleReaper::IdleReaper(EventLoop *loop, double timeout)
+        : loop_(CHECK_NOTNULL(loop)),
+          timeout_(timeout),
+          tickMicroSeconds_(std::max<int64_t>(
+                  static_cast<int64_t>(timeout * Timestamp::kMicroSecondsPerSecond) / kBucketsPerTimeout, 1000)),
+          // a deadline is at most kBucketsPerTimeout + 1 ticks ahead after rounding up.
+          buckets_(kBucketsPerTimeout + 2),
+          sweptTick_(Timestamp::now().microSecondsSinceEpoch() / tickMicroSeconds_),
+          timerId_(0),
+          started_(false) {
+    assert(timeout > 0.0);
+}
+
+void IdleReaper::start() {
+    loop_->assertInLoopThread();
+    assert(!started_);
+    started_ = true;
+    timerId_ = loop_->runEvery(static_cast<double>(tickMicroSeconds_) / Timestamp::kMicroSecondsPerSecond,
+                               std::bind(&IdleReaper::sweep, shared_from_this()));
+}
+
+void IdleReaper::stop() {
+    loop_->assertInLoopThread();
+    if (started_) {
+        started_ = false;
+        loop_->cancel(timerId_);
+    }
+}
+
+void IdleReaper::add(const TcpConnectionPtr &conn) {
+    loop_->assertInLoopThread();
+    assert(conn->getLoop() == loop_);
+    insert(conn, deadlineTick(conn->lastActiveTime()));
+}
+
+void IdleReaper::sweep() {
+    loop_->assertInLoopThread();
+    const Timestamp now = Timestamp::now();
+    const auto numBuckets = static_cast<int64_t>(buckets_.size());
+    const int64_t nowTick = now.microSecondsSinceEpoch() / tickMicroSeconds_;
+    // a late timer sweeps the ticks it missed, each bucket once at most.
+    Bucket bucket;
+    for (int64_t tick = std::max(sweptTick_ + 1, nowTick - numBuckets + 1); tick <= nowTick; ++tick) {
+        bucket.swap(buckets_[tick % numBuckets]);
+        for (const auto &weakConn: bucket) {
+            TcpConnectionPtr conn = weakConn.lock();
+            // a connection moved to another loop is watched by the reaper there. One shut down
+            // is kept, its peer may never read the rest of the output or close.
+            if (!conn || conn->disconnected() || conn->getLoop() != loop_) {
+                continue;
+            }
+            int64_t deadline = deadlineTick(conn->lastActiveTime());
+            if (deadline <= nowTick) {
+                LOG_INFO << Fmt("IdleReaper closes connection [{}] idle for {}s",
+                                conn->name(), Timestamp::timeDuration(now, conn->lastActiveTime()));
+                conn->forceClose();
+            } else {
+                insert(conn, deadline);
+            }
+        }
+        bucket.clear();
+    }
+    sweptTick_ = std::max(sweptTick_, nowTick);
+}
+
+int64_t IdleReaper::deadlineTick(Timestamp time) const {
+    const int64_t deadline = Timestamp::addTime(time, timeout_).microSecondsSinceEpoch();
+    return (deadline + tickMicroSeconds_ - 1) / tickMicroSeconds_;
+}
+
+void IdleReaper::insert(const TcpConnectionPtr &conn, int64_t tick) {
+    // swept at the next tick if the deadline has passed already.
+    tick = std::max(tick, sweptTick_ + 1);
+    buckets_[tick % static_cast<int64_t>(buckets_.size())].push_back(conn);
+}
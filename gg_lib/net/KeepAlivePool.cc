@@ -0,0 +1,229 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#include "gg_lib/net/KeepAlivePool.h"
+#include "gg_lib/net/EventLoop.h"
+#include "gg_lib/Logging.h"
+
+#include <string.h>
+
+using namespace gg_lib;
+using namespace gg_lib::net;
+
+constexpr size_t KeepAlivePool::kDefaultMaxIdlePerAddress;
+constexpr double KeepAlivePool::kDefaultIdleTimeout;
+
+KeepAlivePool::AddressKey::AddressKey(const InetAddress &addr) : words() {
+    const uint16_t family = addr.family();
+    const uint16_t port = addr.portNetEndian();
+    memcpy(words, &family, sizeof family);
+    memcpy(reinterpret_cast<char *>(words) + sizeof family, &port, sizeof port);
+    if (family == AF_INET) {
+        const uint32_t ip = addr.ipv4NetEndian();
+        memcpy(reinterpret_cast<char *>(words) + sizeof family + sizeof port, &ip, sizeof ip);
+    } else if (family == AF_UNIX) {
+        path = addr.unixPath();
+    } else {
+        const struct sockaddr_in6 *addr6 = sockets::sockaddr_in6_cast(addr.getSockAddr());
+        memcpy(&words[1], &addr6->sin6_addr, sizeof addr6->sin6_addr);
+    }
+}
+
+size_t KeepAlivePool::AddressKeyHash::operator()(const AddressKey &key) const {
+    uint64_t h = key.words[0] * 0x9E3779B97F4A7C15ULL;
+    h = (h ^ (h >> 29) ^ key.words[1]) * 0xBF58476D1CE4E5B9ULL;
+    h = (h ^ (h >> 32) ^ key.words[2]) * 0x94D049BB133111EBULL;
+    if (!key.path.empty()) {
+        h ^= std::hash<string>()(key.path);
+    }
+    return static_cast<size_t>(h ^ (h >> 31));
+}
+
+KeepAlivePool::KeepAlivePool(EventLoop *loop, string nameArg)
+        : loop_(CHECK_NOTNULL(loop)),
+          name_(std::move(nameArg)),
+          namePrefix_(std::make_shared<const string>(name_ + "#")),
+          idleCallbacks_(std::make_shared<ConnectionCallbacks>()),
+          maxIdlePerAddress_(kDefaultMaxIdlePerAddress),
+          idleTimeout_(kDefaultIdleTimeout),
+          connectRetries_(0),
+          connectInitDelay_(Connector::kDefaultInitRetryDelay),
+          connectMaxDelay_(Connector::kDefaultMaxRetryDelay),
+          expireTimer_(0),
+          expireTimerArmed_(false),
+          nextConnId_(1),
+          numIdle_(0),
+          numConnects_(0),
+          numReuses_(0) {
+    idleCallbacks_->connectionCallback = [](const TcpConnectionPtr &) {};
+    idleCallbacks_->messageCallback = [](const TcpConnectionPtr &conn, Buffer *buf, Timestamp) {
+        LOG_WARN << Fmt("KeepAlivePool - idle connection [{}] received {} bytes, closing it",
+                        conn->name(), buf->readableBytes());
+        buf->retrieveAll();
+        conn->forceClose();
+    };
+    idleCallbacks_->closeCallback = [this](const TcpConnectionPtr &conn) {
+        removeConnection(conn);
+    };
+}
+
+KeepAlivePool::~KeepAlivePool() {
+    loop_->assertInLoopThread();
+    LOG_TRACE << Fmt("KeepAlivePool::~KeepAlivePool [{}] destructing", name_);
+    if (expireTimerArmed_) {
+        loop_->cancel(expireTimer_);
+    }
+    connectors_.forEach([](ConnectorPtr &connector) {
+        connector->stop();
+    });
+    connectors_.clear();
+    idle_.clear();
+    connections_.forEach([](TcpConnectionPtr &conn) {
+        conn->getLoop()->runInLoop(std::bind(&TcpConnection::connectDestroyed, conn));
+    });
+    connections_.clear();
+}
+
+void KeepAlivePool::setConnectRetry(int maxRetries, double initDelay, double maxDelay) {
+    assert(initDelay > 0 && initDelay <= maxDelay);
+    connectRetries_ = maxRetries;
+    connectInitDelay_ = initDelay;
+    connectMaxDelay_ = maxDelay;
+}
+
+void KeepAlivePool::acquire(const InetAddress &serverAddr, AcquireCallback cb) {
+    loop_->assertInLoopThread();
+    auto it = idle_.find(AddressKey(serverAddr));
+    if (it != idle_.end()) {
+        IdleList &idle = it->second;
+        const Timestamp now = Timestamp::now();
+        while (!idle.empty()) {
+            IdleConnection entry = std::move(idle.back());
+            idle.pop_back();
+            --numIdle_;
+            // one closing but not removed yet isn't connected any more.
+            if (entry.conn->connected() && !expired(entry, now)) {
+                ++numReuses_;
+                cb(entry.conn);
+                return;
+            }
+            entry.conn->forceClose();
+        }
+    }
+    connect(serverAddr, std::move(cb));
+}
+
+void KeepAlivePool::release(const TcpConnectionPtr &conn) {
+    loop_->assertInLoopThread();
+    assert(conn->getLoop() == loop_);
+    if (!conn->connected()) {
+        // its close callback removes it.
+        return;
+    }
+    conn->setCallbacks(idleCallbacks_);
+    if (conn->inputBuffer()->readableBytes() > 0) {
+        LOG_DEBUG << Fmt("KeepAlivePool::release [{}] - unread input, closing", conn->name());
+        conn->forceClose();
+        return;
+    }
+    if (conn->outputBuffer()->readableBytes() > 0) {
+        LOG_DEBUG << Fmt("KeepAlivePool::release [{}] - unsent output, shutting down", conn->name());
+        conn->shutdown();
+        return;
+    }
+    IdleList &idle = idle_[AddressKey(conn->peerAddress())];
+    if (idle.size() >= maxIdlePerAddress_) {
+        conn->forceClose();
+        return;
+    }
+    idle.push_back(IdleConnection{conn, Timestamp::now()});
+    ++numIdle_;
+    if (!expireTimerArmed_ && idleTimeout_ > 0) {
+        // the pool cancels the timer when it goes, so this outlives it.
+        expireTimer_ = loop_->runEvery(idleTimeout_ / 2, [this] { closeExpired(); });
+        expireTimerArmed_ = true;
+    }
+}
+
+void KeepAlivePool::connect(const InetAddress &serverAddr, AcquireCallback cb) {
+    ConnectorPtr connector = std::make_shared<Connector>(loop_, serverAddr);
+    connector->setMaxRetries(connectRetries_);
+    connector->setRetryDelay(connectInitDelay_, connectMaxDelay_);
+    SlotMap<ConnectorPtr>::Key key = connectors_.insert(connector);
+    auto callback = std::make_shared<AcquireCallback>(std::move(cb));
+    connector->setNewConnectionCallback([this, key, callback](int sockfd) {
+        newConnection(key, sockfd, *callback);
+    });
+    connector->setFailureCallback([this, key, callback](int savedErrno) {
+        connectFailed(key, savedErrno, *callback);
+    });
+    connector->start();
+}
+
+void KeepAlivePool::newConnection(SlotMap<ConnectorPtr>::Key connectorKey, int sockfd, const AcquireCallback &cb) {
+    loop_->assertInLoopThread();
+    // the connector keeps itself alive until its callback returned.
+    ConnectorPtr connector = *connectors_.find(connectorKey);
+    connectors_.erase(connectorKey);
+    ConnectionId id = connections_.insert(TcpConnectionPtr());
+    TcpConnectionPtr conn = std::make_shared<TcpConnection>(
+            loop_, id, namePrefix_, nextConnId_++, sockfd, connector->serverAddress());
+    *connections_.find(id) = conn;
+    LOG_INFO << Fmt("KeepAlivePool::newConnection [{}] - new connection [{}] to {}",
+                    name_, conn->name(), connector->serverAddress().toIpPort());
+    conn->setCallbacks(idleCallbacks_);
+    conn->connectEstablished();
+    ++numConnects_;
+    cb(conn);
+}
+
+void KeepAlivePool::connectFailed(SlotMap<ConnectorPtr>::Key connectorKey, int savedErrno, const AcquireCallback &cb) {
+    loop_->assertInLoopThread();
+    ConnectorPtr connector = *connectors_.find(connectorKey);
+    connectors_.erase(connectorKey);
+    LOG_WARN << Fmt("KeepAlivePool::connectFailed [{}] - {}: {}",
+                    name_, connector->serverAddress().toIpPort(), strerror_tr(savedErrno));
+    cb(TcpConnectionPtr());
+}
+
+void KeepAlivePool::removeConnection(const TcpConnectionPtr &conn) {
+    loop_->assertInLoopThread();
+    LOG_INFO << Fmt("KeepAlivePool::removeConnection [{}] - connection {}", name_, conn->name());
+    bool erased = connections_.erase(conn->id());
+    assert(erased);
+    (void) erased;
+    removeIdle(conn);
+    loop_->queueInLoop(std::bind(&TcpConnection::connectDestroyed, conn));
+}
+
+bool KeepAlivePool::removeIdle(const TcpConnectionPtr &conn) {
+    auto it = idle_.find(AddressKey(conn->peerAddress()));
+    if (it == idle_.end()) {
+        return false;
+    }
+    IdleList &idle = it->second;
+    for (size_t i = 0; i < idle.size(); ++i) {
+        if (idle[i].conn == conn) {
+            idle.erase(idle.begin() + static_cast<ptrdiff_t>(i));
+            --numIdle_;
+            return true;
+        }
+    }
+    return false;
+}
+
+void KeepAlivePool::closeExpired() {
+    loop_->assertInLoopThread();
+    const Timestamp now = Timestamp::now();
+    for (auto &item: idle_) {
+        IdleList &idle = item.second;
+        // released in order, the expired ones come first.
+        size_t n = 0;
+        while (n < idle.size() && expired(idle[n], now)) {
+            idle[n].conn->forceClose();
+            ++n;
+        }
+        idle.erase(idle.begin(), idle.begin() + static_cast<ptrdiff_t>(n));
+        numIdle_ -= n;
+    }
+}
@@ -3,6 +3,7 @@
 
 #include "gg_lib/net/Poller.h"
 #include "gg_lib/net/Channel.h"
+#include "gg_lib/Logging.h"
 
 using namespace gg_lib;
 using namespace gg_lib::net;
@@ -14,6 +15,19 @@ Poller::~Poller() = default;
 
 bool Poller::hasChannel(Channel *channel) const {
     assertInLoopThread();
-    ChannelMap::const_iterator it = channels_.find(channel->fd());
-    return it != channels_.end() && it->second == channel;
+    return channels_.find(channel->fd()) == channel;
+}
+
+uint64_t Poller::submitRecv(int fd, void *buf, size_t len, IoCompletionCallback cb) {
+    LOG_FATAL << "Poller::submitRecv is not supported";
+    return 0;
+}
+
+uint64_t Poller::submitSend(int fd, const struct iovec *iov, int iovcnt, IoCompletionCallback cb) {
+    LOG_FATAL << "Poller::submitSend is not supported";
+    return 0;
+}
+
+void Poller::cancelOperation(uint64_t operationId) {
+    LOG_FATAL << "Poller::cancelOperation is not supported";
 }
@@ -0,0 +1,103 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#include "gg_lib/net/ShmRingReader.h"
+#include "gg_lib/net/EventLoop.h"
+#include "gg_lib/Logging.h"
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+using namespace gg_lib;
+using namespace gg_lib::net;
+
+constexpr size_t ShmRingReader::kDefaultReadBudget;
+
+namespace {
+    int createEventFd() {
+        int eventFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (eventFd < 0) {
+            LOG_SYSFATAL << "ShmRingReader eventfd";
+        }
+        return eventFd;
+    }
+}
+
+ShmRingReader::ShmRingReader(EventLoop *loop, std::unique_ptr<ShmRing> ring)
+        : loop_(CHECK_NOTNULL(loop)),
+          ring_(std::move(ring)),
+          eventFd_(createEventFd()),
+          channel_(loop, eventFd_),
+          inputBuffer_(Buffer::kLazy),
+          numWakeups_(0),
+          selfNotifies_(0) {
+    assert(ring_);
+    channel_.setReadCallback(std::bind(&ShmRingReader::handleRead, this, _1));
+}
+
+ShmRingReader::~ShmRingReader() {
+    loop_->assertInLoopThread();
+    channel_.disableAll();
+    channel_.remove();
+    ::close(eventFd_);
+}
+
+void ShmRingReader::start() {
+    loop_->assertInLoopThread();
+    channel_.enableReading();
+    // bytes written before are read on the first event, the writer doesn't signal yet.
+    notifySelf();
+}
+
+void ShmRingReader::stop() {
+    loop_->assertInLoopThread();
+    channel_.disableAll();
+}
+
+void ShmRingReader::handleRead(Timestamp receiveTime) {
+    uint64_t count = 0;
+    if (::read(eventFd_, &count, sizeof count) != sizeof count) {
+        LOG_SYSERR << "ShmRingReader::handleRead";
+    }
+    // the count sums the writes of both sides.
+    if (count > selfNotifies_) {
+        numWakeups_ += static_cast<int64_t>(count - selfNotifies_);
+    }
+    selfNotifies_ = 0;
+    drain(receiveTime);
+}
+
+void ShmRingReader::drain(Timestamp receiveTime) {
+    size_t total = 0;
+    while (total < kDefaultReadBudget) {
+        const size_t n = ring_->readableBytes();
+        if (n == 0) {
+            if (ring_->prepareWait()) {
+                return;
+            }
+            continue;
+        }
+        inputBuffer_.append(ring_->peek(), n);
+        ring_->retrieve(n);
+        total += n;
+        if (messageCallback_) {
+            messageCallback_(&inputBuffer_, receiveTime);
+        } else {
+            inputBuffer_.retrieveAll();
+        }
+        if (inputBuffer_.readableBytes() == 0) {
+            inputBuffer_.release();
+        }
+    }
+    // the writer won't signal a reader which is awake, come back after the other events.
+    notifySelf();
+}
+
+void ShmRingReader::notifySelf() {
+    uint64_t one = 1;
+    if (::write(eventFd_, &one, sizeof one) != sizeof one) {
+        LOG_SYSERR << "ShmRingReader::notifySelf";
+    } else {
+        ++selfNotifies_;
+    }
+}
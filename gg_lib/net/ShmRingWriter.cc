@@ -0,0 +1,51 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#include "gg_lib/net/ShmRingWriter.h"
+#include "gg_lib/Logging.h"
+
+#include <assert.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace gg_lib;
+using namespace gg_lib::net;
+
+ShmRingWriter::ShmRingWriter(std::unique_ptr<ShmRing> ring, int notifyFd)
+        : ring_(std::move(ring)),
+          notifyFd_(::fcntl(notifyFd, F_DUPFD_CLOEXEC, 0)),
+          numWakeups_(0) {
+    assert(ring_);
+    if (notifyFd_ < 0) {
+        LOG_SYSFATAL << "ShmRingWriter::ShmRingWriter";
+    }
+}
+
+ShmRingWriter::~ShmRingWriter() {
+    ::close(notifyFd_);
+}
+
+bool ShmRingWriter::append(const void *data, size_t len) {
+    bool wake = false;
+    if (!ring_->append(data, len, &wake)) {
+        return false;
+    }
+    if (wake) {
+        wakeReader();
+    }
+    return true;
+}
+
+void ShmRingWriter::hasWritten(size_t len) {
+    if (ring_->hasWritten(len)) {
+        wakeReader();
+    }
+}
+
+void ShmRingWriter::wakeReader() {
+    ++numWakeups_;
+    uint64_t one = 1;
+    if (::write(notifyFd_, &one, sizeof one) != sizeof one) {
+        LOG_SYSERR << "ShmRingWriter::wakeReader";
+    }
+}
@@ -4,14 +4,19 @@
 #include "gg_lib/net/SocketsHelper.h"
 #include "gg_lib/Logging.h"
 
+#include <algorithm>
 #include <cerrno>
 #include <cstdio>
+#include <cstddef>
 #include <fcntl.h>
+#include <linux/filter.h>
+#include <sys/sendfile.h>
 #include <sys/socket.h>
 #include <sys/uio.h>
 #include <unistd.h>
 #include <netdb.h>
 #include <netinet/tcp.h>
+#include <netinet/udp.h>
 
 static const in_addr_t kInaddrAny = INADDR_ANY;
 static const in_addr_t kInaddrLoopback = INADDR_LOOPBACK;
@@ -19,20 +24,29 @@ static const in_addr_t kInaddrLoopback = INADDR_LOOPBACK;
 using namespace gg_lib;
 using namespace gg_lib::net;
 
-int sockets::createNonblockingOrDie(sa_family_t family) {
-    int sockfd = ::socket(family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, IPPROTO_TCP);
+int sockets::createNonblockingOrDie(sa_family_t family, int type) {
+    int protocol = family == AF_UNIX ? 0 : IPPROTO_TCP;
+    int sockfd = ::socket(family, type | SOCK_NONBLOCK | SOCK_CLOEXEC, protocol);
     if (sockfd < 0) {
         LOG_SYSFATAL << "sockets::createNonblockingOrDie";
     }
     return sockfd;
 }
 
+int sockets::createUdpNonblockingOrDie(sa_family_t family) {
+    int sockfd = ::socket(family, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, IPPROTO_UDP);
+    if (sockfd < 0) {
+        LOG_SYSFATAL << "sockets::createUdpNonblockingOrDie";
+    }
+    return sockfd;
+}
+
 int sockets::connect(int sockfd, const struct sockaddr *addr) {
-    return ::connect(sockfd, addr, static_cast<socklen_t>(sizeof(struct sockaddr_in6)));
+    return ::connect(sockfd, addr, sockaddrLength(addr));
 }
 
 void sockets::bindOrDie(int sockfd, const struct sockaddr *addr) {
-    int ret = ::bind(sockfd, addr, static_cast<socklen_t>(sizeof(struct sockaddr_in6)));
+    int ret = ::bind(sockfd, addr, sockaddrLength(addr));
     if (ret < 0) {
         LOG_SYSFATAL << "sockets::bindOrDie";
     }
@@ -46,9 +60,11 @@ void sockets::listenOrDie(int sockfd) {
 }
 
 int sockets::accept(int sockfd, struct sockaddr_in6 *addr) {
-    auto addrlen = static_cast<socklen_t>(sizeof *addr);
-    int connfd = ::accept4(sockfd, sockaddr_cast(addr),
-                           &addrlen, SOCK_NONBLOCK | SOCK_CLOEXEC);
+    return accept(sockfd, sockaddr_cast(addr), static_cast<socklen_t>(sizeof *addr));
+}
+
+int sockets::accept(int sockfd, struct sockaddr *addr, socklen_t addrlen) {
+    int connfd = ::accept4(sockfd, addr, &addrlen, SOCK_NONBLOCK | SOCK_CLOEXEC);
     if (connfd < 0) {
         int savedErrno = errno;
         switch (savedErrno) {
@@ -98,6 +114,50 @@ ssize_t sockets::write(int sockfd, const void *buf, size_t count) {
     return ::write(sockfd, buf, count);
 }
 
+ssize_t sockets::writev(int sockfd, const struct iovec *iov, int iovcnt) {
+    return ::writev(sockfd, iov, iovcnt);
+}
+
+ssize_t sockets::sendfile(int sockfd, int fd, off_t *offset, size_t count) {
+    return ::sendfile(sockfd, fd, offset, count);
+}
+
+ssize_t sockets::sendmsg(int sockfd, const struct msghdr *msg, int flags) {
+    return ::sendmsg(sockfd, msg, flags);
+}
+
+ssize_t sockets::recvmsg(int sockfd, struct msghdr *msg, int flags) {
+    return ::recvmsg(sockfd, msg, flags);
+}
+
+ssize_t sockets::sendWithFds(int sockfd, const struct iovec *iov, int iovcnt,
+                             const int *fds, int numFds) {
+    assert(numFds > 0 && numFds <= kMaxPassedFds);
+    union {
+        char buf[CMSG_SPACE(sizeof(int) * kMaxPassedFds)];
+        struct cmsghdr align;
+    } control;
+    struct msghdr msg{};
+    msg.msg_iov = const_cast<struct iovec *>(iov);
+    msg.msg_iovlen = static_cast<size_t>(iovcnt);
+    msg.msg_control = control.buf;
+    msg.msg_controllen = CMSG_SPACE(sizeof(int) * numFds);
+    struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(int) * numFds);
+    memcpy(CMSG_DATA(cmsg), fds, sizeof(int) * numFds);
+    return ::sendmsg(sockfd, &msg, MSG_NOSIGNAL);
+}
+
+int sockets::recvmmsg(int sockfd, struct mmsghdr *msgvec, unsigned int vlen, int flags) {
+    return ::recvmmsg(sockfd, msgvec, vlen, flags, nullptr);
+}
+
+int sockets::sendmmsg(int sockfd, struct mmsghdr *msgvec, unsigned int vlen, int flags) {
+    return ::sendmmsg(sockfd, msgvec, vlen, flags);
+}
+
 void sockets::close(int sockfd) {
     if (::close(sockfd) < 0) {
         LOG_SYSERR << "sockets::close";
@@ -111,7 +171,9 @@ void sockets::shutdownWrite(int sockfd) {
 }
 
 void sockets::toIpPort(char *buf, size_t size, const struct sockaddr *addr) {
-    if (addr->sa_family == AF_INET6) {
+    if (addr->sa_family == AF_UNIX) {
+        toIp(buf, size, addr);
+    } else if (addr->sa_family == AF_INET6) {
         buf[0] = '[';
         toIp(buf + 1, size - 1, addr);
         size_t end = ::strlen(buf);
@@ -139,6 +201,13 @@ void sockets::toIp(char *buf, size_t size,
         assert(size >= INET6_ADDRSTRLEN);
         const struct sockaddr_in6 *addr6 = sockaddr_in6_cast(addr);
         ::inet_ntop(AF_INET6, &addr6->sin6_addr, buf, static_cast<socklen_t>(size));
+    } else if (addr->sa_family == AF_UNIX) {
+        const auto *addrUnix = reinterpret_cast<const struct sockaddr_un *>(addr);
+        const char *path = addrUnix->sun_path;
+        // an abstract name starts with a null byte.
+        const bool abstract = path[0] == '\0' && path[1] != '\0';
+        snprintf(buf, size, "%s%.*s", abstract ? "@" : "",
+                 static_cast<int>(sizeof addrUnix->sun_path - 1), abstract ? path + 1 : path);
     }
 }
 
@@ -170,6 +239,20 @@ int sockets::getSocketError(int sockfd) {
     }
 }
 
+socklen_t sockets::sockaddrLength(const struct sockaddr *addr) {
+    if (addr->sa_family == AF_UNIX) {
+        const auto *addrUnix = reinterpret_cast<const struct sockaddr_un *>(addr);
+        const char *path = addrUnix->sun_path;
+        const size_t maxLen = sizeof addrUnix->sun_path - 1;
+        // the name of an abstract address runs to the length, a path to its null byte.
+        size_t len = path[0] == '\0' && path[1] != '\0' ? 1 + ::strnlen(path + 1, maxLen)
+                                                         : ::strnlen(path, maxLen) + 1;
+        return static_cast<socklen_t>(offsetof(struct sockaddr_un, sun_path) + len);
+    }
+    return static_cast<socklen_t>(addr->sa_family == AF_INET ? sizeof(struct sockaddr_in)
+                                                              : sizeof(struct sockaddr_in6));
+}
+
 const struct sockaddr *sockets::sockaddr_cast(const struct sockaddr_in *addr) {
     return reinterpret_cast<const struct sockaddr *>(addr);
 }
@@ -251,14 +334,53 @@ InetAddress::InetAddress(StringArg ip, uint16_t port, bool ipv6) {
     }
 }
 
+InetAddress InetAddress::fromUnixPath(StringArg path) {
+    struct sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    const char *name = path.c_str();
+    // sun_path[0] stays null for an abstract name.
+    const bool abstract = name[0] == '@';
+    char *dest = abstract ? addr.sun_path + 1 : addr.sun_path;
+    const size_t maxLen = sizeof addr.sun_path - 1 - (abstract ? 1 : 0);
+    const size_t len = ::strlen(abstract ? name + 1 : name);
+    if (len > maxLen) {
+        LOG_ERROR << Fmt("InetAddress::fromUnixPath - {} is longer than {} bytes", name, maxLen);
+    }
+    memcpy(dest, abstract ? name + 1 : name, std::min(len, maxLen));
+    return InetAddress(addr);
+}
+
+InetAddress InetAddress::localAddressOf(int sockfd) {
+    struct sockaddr_un addr{};
+    auto addrlen = static_cast<socklen_t>(sizeof addr);
+    if (::getsockname(sockfd, reinterpret_cast<struct sockaddr *>(&addr), &addrlen) < 0) {
+        LOG_SYSERR << "InetAddress::localAddressOf";
+    }
+    return InetAddress(addr);
+}
+
+InetAddress InetAddress::peerAddressOf(int sockfd) {
+    struct sockaddr_un addr{};
+    auto addrlen = static_cast<socklen_t>(sizeof addr);
+    if (::getpeername(sockfd, reinterpret_cast<struct sockaddr *>(&addr), &addrlen) < 0) {
+        LOG_SYSERR << "InetAddress::peerAddressOf";
+    }
+    return InetAddress(addr);
+}
+
+string InetAddress::unixPath() const {
+    assert(family() == AF_UNIX);
+    return toIp();
+}
+
 string InetAddress::toIp() const {
-    char buf[64] = "";
+    char buf[sizeof(struct sockaddr_un) + 1] = "";
     sockets::toIp(buf, sizeof buf, getSockAddr());
     return buf;
 }
 
 string InetAddress::toIpPort() const {
-    char buf[64] = "";
+    char buf[sizeof(struct sockaddr_un) + 1] = "";
     sockets::toIpPort(buf, sizeof buf, getSockAddr());
     return buf;
 }
@@ -343,10 +465,12 @@ void Socket::listen() const {
 }
 
 int Socket::accept(InetAddress *peeraddr) const {
-    struct sockaddr_in6 addr{};
-    int connfd = sockets::accept(sockfd_, &addr);
+    // large enough for any family, an unnamed AF_UNIX peer leaves the path empty.
+    struct sockaddr_un addr{};
+    int connfd = sockets::accept(sockfd_, reinterpret_cast<struct sockaddr *>(&addr),
+                                 static_cast<socklen_t>(sizeof addr));
     if (connfd >= 0) {
-        peeraddr->setSockAddrInet6(addr);
+        *peeraddr = InetAddress(addr);
     }
     return connfd;
 }
@@ -397,3 +521,110 @@ void Socket::setKeepAlive(bool on) const {
     ::setsockopt(sockfd_, SOL_SOCKET, SO_KEEPALIVE,
                  &optval, static_cast<socklen_t>(sizeof optval));
 }
+
+bool Socket::setDeferAccept(int seconds) const {
+    int ret = ::setsockopt(sockfd_, IPPROTO_TCP, TCP_DEFER_ACCEPT,
+                           &seconds, static_cast<socklen_t>(sizeof seconds));
+    if (ret < 0) {
+        LOG_SYSERR << "TCP_DEFER_ACCEPT failed.";
+        return false;
+    }
+    return true;
+}
+
+bool Socket::setFastOpen(int queueLength) const {
+#ifdef TCP_FASTOPEN
+    int ret = ::setsockopt(sockfd_, IPPROTO_TCP, TCP_FASTOPEN,
+                           &queueLength, static_cast<socklen_t>(sizeof queueLength));
+    if (ret < 0) {
+        LOG_SYSERR << "TCP_FASTOPEN failed.";
+        return false;
+    }
+    return true;
+#else
+    LOG_ERROR << "TCP_FASTOPEN is not supported.";
+    return false;
+#endif
+}
+
+bool Socket::attachReusePortCpuSteering(int groupSize) const {
+#ifdef SO_ATTACH_REUSEPORT_CBPF
+    assert(groupSize > 0);
+    // A = cpu; A %= groupSize; return A.
+    struct sock_filter code[] = {
+            {BPF_LD | BPF_W | BPF_ABS, 0, 0, static_cast<uint32_t>(SKF_AD_OFF + SKF_AD_CPU)},
+            {BPF_ALU | BPF_MOD | BPF_K, 0, 0, static_cast<uint32_t>(groupSize)},
+            {BPF_RET | BPF_A, 0, 0, 0},
+    };
+    struct sock_fprog prog = {static_cast<unsigned short>(sizeof code / sizeof code[0]), code};
+    int ret = ::setsockopt(sockfd_, SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF,
+                           &prog, static_cast<socklen_t>(sizeof prog));
+    if (ret < 0) {
+        LOG_SYSERR << "SO_ATTACH_REUSEPORT_CBPF failed.";
+        return false;
+    }
+    return true;
+#else
+    LOG_ERROR << "SO_ATTACH_REUSEPORT_CBPF is not supported.";
+    return false;
+#endif
+}
+
+bool Socket::setBusyPoll(int microSeconds) const {
+#ifdef SO_BUSY_POLL
+    int ret = ::setsockopt(sockfd_, SOL_SOCKET, SO_BUSY_POLL,
+                           &microSeconds, static_cast<socklen_t>(sizeof microSeconds));
+    if (ret < 0) {
+        LOG_SYSERR << "SO_BUSY_POLL failed.";
+        return false;
+    }
+    return true;
+#else
+    LOG_ERROR << "SO_BUSY_POLL is not supported.";
+    return false;
+#endif
+}
+
+bool Socket::setZeroCopy(bool on) const {
+#ifdef SO_ZEROCOPY
+    int optval = on ? 1 : 0;
+    int ret = ::setsockopt(sockfd_, SOL_SOCKET, SO_ZEROCOPY,
+                           &optval, static_cast<socklen_t>(sizeof optval));
+    if (ret < 0 && on) {
+        LOG_SYSERR << "SO_ZEROCOPY failed.";
+    }
+    return ret == 0;
+#else
+    if (on) {
+        LOG_ERROR << "SO_ZEROCOPY is not supported.";
+    }
+    return !on;
+#endif
+}
+
+bool Socket::setUdpGro(bool on) const {
+#ifdef UDP_GRO
+    int optval = on ? 1 : 0;
+    int ret = ::setsockopt(sockfd_, SOL_UDP, UDP_GRO,
+                           &optval, static_cast<socklen_t>(sizeof optval));
+    if (ret < 0 && on) {
+        LOG_SYSERR << "UDP_GRO failed.";
+    }
+    return ret == 0;
+#else
+    if (on) {
+        LOG_ERROR << "UDP_GRO is not supported.";
+    }
+    return !on;
+#endif
+}
+
+bool Socket::supportsUdpGso() const {
+#ifdef UDP_SEGMENT
+    int optval = 0;
+    auto optlen = static_cast<socklen_t>(sizeof optval);
+    return ::getsockopt(sockfd_, SOL_UDP, UDP_SEGMENT, &optval, &optlen) == 0;
+#else
+    return false;
+#endif
+}
@@ -0,0 +1,106 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#include "gg_lib/net/TcpClient.h"
+#include "gg_lib/net/EventLoop.h"
+#include "gg_lib/Logging.h"
+
+using namespace gg_lib;
+using namespace gg_lib::net;
+
+namespace {
+    /// Close callback of a connection outliving its TcpClient.
+    void removeOrphanConnection(const TcpConnectionPtr &conn) {
+        conn->getLoop()->queueInLoop(std::bind(&TcpConnection::connectDestroyed, conn));
+    }
+}
+
+TcpClient::TcpClient(EventLoop *loop, const InetAddress &serverAddr, string nameArg)
+        : loop_(CHECK_NOTNULL(loop)),
+          connector_(std::make_shared<Connector>(loop, serverAddr)),
+          name_(std::move(nameArg)),
+          connectionCallback_(defaultConnectionCallback),
+          messageCallback_(defaultMessageCallback),
+          retry_(false),
+          connect_(false),
+          nextConnId_(1) {
+    connector_->setNewConnectionCallback([this](int sockfd) {
+        newConnection(sockfd);
+    });
+    LOG_INFO << Fmt("TcpClient::TcpClient[{}] - connector {}", name_, static_cast<void *>(connector_.get()));
+}
+
+TcpClient::~TcpClient() {
+    LOG_INFO << Fmt("TcpClient::~TcpClient[{}] - connector {}", name_, static_cast<void *>(connector_.get()));
+    TcpConnectionPtr conn;
+    bool unique;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        unique = connection_.use_count() == 1;
+        conn = connection_;
+    }
+    if (conn) {
+        assert(loop_ == conn->getLoop());
+        // the connection may still be used by others, it must no longer call back into this client.
+        loop_->runInLoop(std::bind(&TcpConnection::setCloseCallback, conn, CloseCallback(removeOrphanConnection)));
+        if (unique) {
+            conn->forceClose();
+        }
+    }
+    // the stop queued by another thread keeps the connector alive until it ran.
+    connector_->stop();
+}
+
+void TcpClient::connect() {
+    LOG_INFO << Fmt("TcpClient::connect[{}] - connecting to {}", name_, connector_->serverAddress().toIpPort());
+    connect_ = true;
+    connector_->start();
+}
+
+void TcpClient::disconnect() {
+    connect_ = false;
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (connection_) {
+        connection_->shutdown();
+    }
+}
+
+void TcpClient::stop() {
+    connect_ = false;
+    connector_->stop();
+}
+
+void TcpClient::newConnection(int sockfd) {
+    loop_->assertInLoopThread();
+    InetAddress peerAddr(InetAddress::peerAddressOf(sockfd));
+    string connName = fmt::format("{}:{}#{}", name_, peerAddr.toIpPort(), nextConnId_++);
+    InetAddress localAddr(InetAddress::localAddressOf(sockfd));
+    TcpConnectionPtr conn = std::make_shared<TcpConnection>(loop_, connName, sockfd, localAddr, peerAddr);
+    conn->setConnectionCallback(connectionCallback_);
+    conn->setMessageCallback(messageCallback_);
+    conn->setWriteCompleteCallback(writeCompleteCallback_);
+    conn->setCloseCallback([this](const TcpConnectionPtr &c) {
+        removeConnection(c);
+    });
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        connection_ = conn;
+    }
+    conn->connectEstablished();
+}
+
+void TcpClient::removeConnection(const TcpConnectionPtr &conn) {
+    loop_->assertInLoopThread();
+    assert(loop_ == conn->getLoop());
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        assert(connection_ == conn);
+        connection_.reset();
+    }
+    loop_->queueInLoop(std::bind(&TcpConnection::connectDestroyed, conn));
+    if (retry_ && connect_) {
+        LOG_INFO << Fmt("TcpClient::removeConnection[{}] - Reconnecting to {}",
+                        name_, connector_->serverAddress().toIpPort());
+        connector_->restart();
+    }
+}
@@ -5,6 +5,12 @@
 #include "gg_lib/net/EventLoop.h"
 #include "gg_lib/net/Channel.h"
 
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <linux/errqueue.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
 #include <utility>
 
 #include "gg_lib/Logging.h"
@@ -13,6 +19,23 @@
 using namespace gg_lib;
 using namespace gg_lib::net;
 
+namespace {
+    // keep recv from being submitted with a tiny window.
+    constexpr size_t kMinRecvSpace = 4096;
+    // files sendfile(2) can't handle, or sent in completion mode, are read in chunks this large.
+    constexpr size_t kFileChunkSize = 64 * 1024;
+    // blocks of unreported zero-copy sends outlive the connection this long,
+    // the kernel may still retransmit from them after close.
+    constexpr double kZeroCopyLingerSeconds = 10.0;
+
+    const std::shared_ptr<ConnectionCallbacks> &defaultCallbacks() {
+        static const std::shared_ptr<ConnectionCallbacks> callbacks(
+                new ConnectionCallbacks{defaultConnectionCallback, defaultMessageCallback,
+                                        WriteCompleteCallback(), CloseCallback(), ConnectionCallback()});
+        return callbacks;
+    }
+}
+
 void gg_lib::net::defaultConnectionCallback(const TcpConnectionPtr &conn) {
     LOG_TRACE << Fmt("{} -> {} is {}",
                      conn->localAddress().toIpPort(),
@@ -37,53 +60,110 @@ void gg_lib::net::optionalDoneHighWaterMarkCallback(const TcpConnectionPtr &conn
 }
 
 TcpConnection::TcpConnection(EventLoop *loop,
-                             string name,
+                             string nameArg,
                              int sockfd,
                              const InetAddress &localAddr,
                              const InetAddress &peerAddr)
+        : TcpConnection(loop, 0, nullptr, 0, std::move(nameArg), sockfd, &localAddr, peerAddr) {
+    socket_.setKeepAlive(true);
+}
+
+TcpConnection::TcpConnection(EventLoop *loop,
+                             ConnectionId id,
+                             std::shared_ptr<const string> namePrefix,
+                             uint64_t serial,
+                             int sockfd,
+                             const InetAddress &peerAddr)
+        : TcpConnection(loop, id, std::move(namePrefix), serial, string(), sockfd, nullptr, peerAddr) {}
+
+TcpConnection::TcpConnection(EventLoop *loop,
+                             ConnectionId id,
+                             std::shared_ptr<const string> namePrefix,
+                             uint64_t serial,
+                             string nameArg,
+                             int sockfd,
+                             const InetAddress *localAddr,
+                             const InetAddress &peerAddr)
         : loop_(CHECK_NOTNULL(loop)),
-          name_(std::move(name)),
+          id_(id),
+          namePrefix_(std::move(namePrefix)),
+          serial_(serial),
+          name_(std::move(nameArg)),
           state_(kConnecting),
           reading_(true),
-          socket_(new Socket(sockfd)),
-          channel_(new Channel(loop, sockfd)),
-          localAddr_(localAddr),
+          completionMode_(false),
+          edgeTriggered_(false),
+          readRequeued_(false),
+          pendingEof_(false),
+          receiveFds_(false),
+          readBudgetBytes_(kDefaultReadBudgetBytes),
+          readBudgetReads_(kDefaultReadBudgetReads),
+          recvPending_(false),
+          recvHeld_(false),
+          sendPending_(false),
+          recvOperation_(0),
+          sendOperation_(0),
+          socket_(sockfd),
+          channel_(loop, sockfd),
           peerAddr_(peerAddr),
-          highWaterMark_(8 * 1024 * 1024) {
-    channel_->setReadCallback(
-            std::bind(&TcpConnection::handleRead, this, _1));
-    channel_->setWriteCallback(
-            std::bind(&TcpConnection::handleWrite, this));
-    channel_->setCloseCallback(
-            std::bind(&TcpConnection::handleClose, this));
-    channel_->setErrorCallback(
-            std::bind(&TcpConnection::handleError, this));
+          callbacks_(defaultCallbacks()),
+          ownsCallbacks_(false),
+          highWaterMark_(8 * 1024 * 1024),
+          inputBuffer_(Buffer::kLazy),
+          zeroCopyThreshold_(0),
+          zeroCopyNextSeq_(0),
+          zeroCopyDoneSeq_(0),
+          migrating_(false) {
+    getLoop()->updateConnectionCount(1);
+    setChannelCallbacks();
     LOG_DEBUG << Fmt("TcpConnection::ctor[{}] at {} fd={}",
-                     name_, static_cast<void *>(this), sockfd);
-    socket_->setKeepAlive(true);
+                     name(), static_cast<void *>(this), sockfd);
+    if (localAddr) {
+        std::call_once(localAddrOnce_, [this, localAddr] { localAddr_ = *localAddr; });
+    }
 }
 
 TcpConnection::~TcpConnection() {
     LOG_DEBUG << Fmt("TcpConnection::dtor[{}] at fd={} statr={}",
-                     name_, channel_->fd(), stateToString());
+                     name(), channel_.fd(), stateToString());
     assert(state_ == kDisconnected);
+    for (auto &file: pendingFiles_) {
+        if (file.fd >= 0) {
+            ::close(file.fd);
+        }
+        for (int fd: file.fds) {
+            ::close(fd);
+        }
+    }
+    for (int fd: receivedFds_) {
+        ::close(fd);
+    }
+    getLoop()->updateConnectionCount(-1);
+}
+
+string TcpConnection::name() const {
+    return namePrefix_ ? *namePrefix_ + std::to_string(serial_) : name_;
+}
+
+const InetAddress &TcpConnection::localAddress() const {
+    std::call_once(localAddrOnce_, [this] { localAddr_ = InetAddress::localAddressOf(socket_.fd()); });
+    return localAddr_;
 }
 
 string TcpConnection::getTcpInfoString() const {
     char buf[1024]{};
-    socket_->getTcpInfoString(buf, sizeof buf - 1);
+    socket_.getTcpInfoString(buf, sizeof buf - 1);
     return buf;
 }
 
-/// FIXME consider using weak callback?
 void TcpConnection::send(string &&message) {
     if (state_ == kConnected) {
-        if (loop_->isInLoopThread()) {
+        if (inLoopThread()) {
             sendInLoop(string_view(message));
         } else {
             void (TcpConnection::*fp)(const string_view &message) = &TcpConnection::sendInLoop;
-            loop_->runInLoop(
-                    std::bind(fp, this, std::move(message)));
+            queueInLoop(
+                    std::bind(fp, shared_from_this(), std::move(message)));
         }
     }
 }
@@ -94,85 +174,146 @@ void TcpConnection::send(const void *message, size_t len) {
 
 void TcpConnection::send(const string_view &message) {
     if (state_ == kConnected) {
-        if (loop_->isInLoopThread()) {
+        if (inLoopThread()) {
             sendInLoop(message);
         } else {
             /// here we copy the message since sendInLoop won't call immediately.
             void (TcpConnection::*fp)(const string_view &message) = &TcpConnection::sendInLoop;
-            loop_->runInLoop(
-                    std::bind(fp, this, message.to_string()));
+            queueInLoop(
+                    std::bind(fp, shared_from_this(), message.to_string()));
         }
     }
 }
 
 void TcpConnection::send(Buffer &&message) {
     if (state_ == kConnected) {
-        if (loop_->isInLoopThread()) {
-            sendInLoop(message.peek(), message.readableBytes());
+        if (inLoopThread()) {
+            sendInLoop(message);
         } else {
             void (TcpConnection::*fp)(Buffer &message) = &TcpConnection::sendInLoop;
-            loop_->runInLoop(
-                    std::bind(fp, this, std::move(message)));
+            queueInLoop(
+                    std::bind(fp, shared_from_this(), std::move(message)));
         }
     }
 }
 
 void TcpConnection::send(Buffer *message) {
     if (state_ == kConnected) {
-        if (loop_->isInLoopThread()) {
+        if (inLoopThread()) {
             sendInLoop(message->peek(), message->readableBytes());
             message->retrieveAll();
         } else {
             void (TcpConnection::*fp)(const string_view &message) = &TcpConnection::sendInLoop;
-            loop_->runInLoop(
-                    std::bind(fp, this, message->retrieveAllAsString()));
+            queueInLoop(
+                    std::bind(fp, shared_from_this(), message->retrieveAllAsString()));
         }
     }
 }
 
+void TcpConnection::send(ChainBuffer &&message) {
+    if (state_ == kConnected) {
+        if (inLoopThread()) {
+            sendInLoop(message);
+        } else {
+            void (TcpConnection::*fp)(ChainBuffer &message) = &TcpConnection::sendInLoop;
+            queueInLoop(
+                    std::bind(fp, shared_from_this(), std::move(message)));
+        }
+    }
+}
+
+void TcpConnection::sendFile(int fd, off_t offset, size_t len) {
+    if (state_ == kConnected) {
+        int dupFd = ::fcntl(fd, F_DUPFD_CLOEXEC, 0);
+        if (dupFd < 0) {
+            LOG_SYSERR << "TcpConnection::sendFile";
+            return;
+        }
+        if (inLoopThread()) {
+            sendFileInLoop(dupFd, offset, len);
+        } else {
+            queueInLoop(
+                    std::bind(&TcpConnection::sendFileInLoop, shared_from_this(), dupFd, offset, len));
+        }
+    }
+}
+
+void TcpConnection::sendFds(const int *fds, int count, const string_view &message) {
+    assert(count > 0 && count <= sockets::kMaxPassedFds && !message.empty());
+    if (state_ == kConnected) {
+        std::vector<int> dupFds;
+        for (int i = 0; i < count; ++i) {
+            int dupFd = ::fcntl(fds[i], F_DUPFD_CLOEXEC, 0);
+            if (dupFd < 0) {
+                LOG_SYSERR << "TcpConnection::sendFds";
+                for (int fd: dupFds) {
+                    ::close(fd);
+                }
+                return;
+            }
+            dupFds.push_back(dupFd);
+        }
+        if (inLoopThread()) {
+            sendFdsInLoop(dupFds, message.to_string());
+        } else {
+            queueInLoop(
+                    std::bind(&TcpConnection::sendFdsInLoop, shared_from_this(), std::move(dupFds),
+                              message.to_string()));
+        }
+    }
+}
+
+std::vector<int> TcpConnection::takeReceivedFds() {
+    getLoop()->assertInLoopThread();
+    std::vector<int> fds;
+    fds.swap(receivedFds_);
+    return fds;
+}
+
 void TcpConnection::shutdown() {
     if (state_ == kConnected) {
         setState(kDisconnecting);
-        loop_->runInLoop(std::bind(&TcpConnection::shutdownInLoop, this));
+        runInLoop(std::bind(&TcpConnection::shutdownInLoop, this));
     }
 }
 
 void TcpConnection::shutdownInLoop() {
-    loop_->assertInLoopThread();
-    if (!channel_->isWriting()) {
-        socket_->shutdownWrite();
+    getLoop()->assertInLoopThread();
+    if (!writePending()) {
+        socket_.shutdownWrite();
     }
 }
 
 void TcpConnection::shutdownAndForceCloseAfter(double seconds) {
     if (state_ == kConnected) {
         setState(kDisconnecting);
-        loop_->runInLoop(std::bind(&TcpConnection::shutdownAndForceCloseInLoop, this, seconds));
+        runInLoop(std::bind(&TcpConnection::shutdownAndForceCloseInLoop, this, seconds));
     }
 }
 
 void TcpConnection::shutdownAndForceCloseInLoop(double seconds) {
-    loop_->assertInLoopThread();
-    if (!channel_->isWriting()) {
-        socket_->shutdownWrite();
+    getLoop()->assertInLoopThread();
+    if (!writePending()) {
+        socket_.shutdownWrite();
     }
-    loop_->runAfter(
+    // the connection may have moved to another loop by then.
+    getLoop()->runAfter(
             seconds,
             makeWeakCallback(weak_from_this(),
-                             &TcpConnection::forceCloseInLoop));
+                             &TcpConnection::forceClose));
 }
 
 void TcpConnection::forceClose() {
     if (state_ == kConnected || state_ == kDisconnecting) {
         setState(kDisconnecting);
-        loop_->queueInLoop(std::bind(&TcpConnection::forceCloseInLoop, shared_from_this()));
+        queueInLoop(std::bind(&TcpConnection::forceCloseInLoop, shared_from_this()));
     }
 }
 
 void TcpConnection::forceCloseWithDelay(double seconds) {
     if (state_ == kConnected || state_ == kDisconnecting) {
         setState(kDisconnecting);
-        loop_->runAfter(
+        getLoop()->runAfter(
                 seconds,
                 makeWeakCallback(shared_from_this(),
                                  &TcpConnection::forceClose));
@@ -180,46 +321,253 @@ void TcpConnection::forceCloseWithDelay(double seconds) {
 }
 
 void TcpConnection::forceCloseInLoop() {
-    loop_->assertInLoopThread();
+    getLoop()->assertInLoopThread();
     if (state_ == kConnected || state_ == kDisconnecting) {
         handleClose();
     }
 }
 
 void TcpConnection::startRead() {
-    loop_->runInLoop(std::bind(&TcpConnection::startReadInLoop, this));
+    runInLoop(std::bind(&TcpConnection::startReadInLoop, this));
 }
 
 void TcpConnection::stopRead() {
-    loop_->runInLoop(std::bind(&TcpConnection::stopReadInLoop, this));
+    runInLoop(std::bind(&TcpConnection::stopReadInLoop, this));
+}
+
+void TcpConnection::migrateTo(EventLoop *loop) {
+    assert(loop != nullptr);
+    runInLoop(std::bind(&TcpConnection::beginMigrationInLoop, shared_from_this(), loop));
+}
+
+void TcpConnection::beginMigrationInLoop(EventLoop *loop) {
+    getLoop()->assertInLoopThread();
+    if (loop == getLoop() || migrating_) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lk(migrationMutex_);
+        migrating_ = true;
+    }
+    // the calls queued before migrating_ was set run before this.
+    getLoop()->queueInLoop(std::bind(&TcpConnection::detachInLoop, shared_from_this(), loop));
+}
+
+void TcpConnection::detachInLoop(EventLoop *loop) {
+    EventLoop *oldLoop = getLoop();
+    oldLoop->assertInLoopThread();
+    if (state_ != kConnected || completionMode_ || !zeroCopyHolds_.empty()) {
+        LOG_WARN << Fmt("TcpConnection::detachInLoop [{}] - can't move in state {}{}{}", name(),
+                        stateToString(), completionMode_ ? ", completion mode" : "",
+                        zeroCopyHolds_.empty() ? "" : ", zero-copy sends in flight");
+        runMigrationStash();
+        return;
+    }
+    channel_.disableAll();
+    channel_.remove();
+    channel_.setOwnerLoop(loop);
+    oldLoop->updateConnectionCount(-1);
+    loop->updateConnectionCount(1);
+    {
+        std::lock_guard<std::mutex> lk(migrationMutex_);
+        loop_ = loop;
+    }
+    loop->queueInLoop(std::bind(&TcpConnection::attachInLoop, shared_from_this()));
+}
+
+void TcpConnection::attachInLoop() {
+    getLoop()->assertInLoopThread();
+    channel_.tie(weak_from_this());
+    if (state_ == kConnected || state_ == kDisconnecting) {
+        // adding the fd reports the bytes which arrived meanwhile at once, edge-triggered too.
+        if (reading_) {
+            channel_.enableReading();
+        }
+        if (queuedBytes() > 0) {
+            channel_.enableWriting();
+        }
+    }
+    LOG_DEBUG << Fmt("TcpConnection::attachInLoop [{}] - moved to loop {}",
+                     name(), static_cast<void *>(getLoop()));
+    runMigrationStash();
+    if (callbacks_->migrateCallback) {
+        callbacks_->migrateCallback(shared_from_this());
+    }
+}
+
+void TcpConnection::runMigrationStash() {
+    for (;;) {
+        std::vector<Functor> stash;
+        {
+            std::lock_guard<std::mutex> lk(migrationMutex_);
+            if (migrationStash_.empty()) {
+                migrating_ = false;
+                return;
+            }
+            stash.swap(migrationStash_);
+        }
+        for (Functor &functor: stash) {
+            functor();
+        }
+    }
+}
+
+bool TcpConnection::inLoopThread() const {
+    return !migrating_ && getLoop()->isInLoopThread();
+}
+
+void TcpConnection::runInLoop(Functor cb) {
+    if (inLoopThread()) {
+        cb();
+    } else {
+        queueInLoop(std::move(cb));
+    }
+}
+
+void TcpConnection::queueInLoop(Functor cb) {
+    std::lock_guard<std::mutex> lk(migrationMutex_);
+    if (migrating_) {
+        migrationStash_.push_back(std::move(cb));
+    } else {
+        getLoop()->queueInLoop(std::move(cb));
+    }
+}
+
+void TcpConnection::setChannelCallbacks() {
+    channel_.setReadCallback(
+            std::bind(&TcpConnection::handleRead, this, _1));
+    channel_.setWriteCallback(
+            std::bind(&TcpConnection::handleWrite, this));
+    channel_.setCloseCallback(
+            std::bind(&TcpConnection::handleClose, this));
+    channel_.setErrorCallback(
+            std::bind(&TcpConnection::handleError, this));
+}
+
+void TcpConnection::setConnectionCallback(const ConnectionCallback &cb) {
+    mutableCallbacks()->connectionCallback = cb;
+}
+
+void TcpConnection::setMessageCallback(const MessageCallback &cb) {
+    mutableCallbacks()->messageCallback = cb;
+}
+
+void TcpConnection::setWriteCompleteCallback(const WriteCompleteCallback &cb) {
+    mutableCallbacks()->writeCompleteCallback = cb;
+}
+
+void TcpConnection::setCloseCallback(const CloseCallback &cb) {
+    mutableCallbacks()->closeCallback = cb;
+}
+
+void TcpConnection::setMigrateCallback(const ConnectionCallback &cb) {
+    mutableCallbacks()->migrateCallback = cb;
+}
+
+void TcpConnection::setCallbacks(std::shared_ptr<ConnectionCallbacks> callbacks) {
+    if (ownsCallbacks_ && getLoop()->isInLoopThread()) {
+        // one of them may be running and replacing them, e.g. a message callback
+        // handing the connection back to a KeepAlivePool, they go after it returned.
+        std::shared_ptr<ConnectionCallbacks> previous = std::move(callbacks_);
+        getLoop()->queueInLoop([previous] {});
+    }
+    callbacks_ = std::move(callbacks);
+    ownsCallbacks_ = false;
+}
+
+ConnectionCallbacks *TcpConnection::mutableCallbacks() {
+    if (!ownsCallbacks_) {
+        callbacks_ = std::make_shared<ConnectionCallbacks>(*callbacks_);
+        ownsCallbacks_ = true;
+    }
+    return callbacks_.get();
+}
+
+void TcpConnection::setCompletionMode(bool on) {
+    assert(state_ == kConnecting);
+    if (on && !getLoop()->supportsCompletionIo()) {
+        LOG_DEBUG << Fmt("TcpConnection[{}] poller doesn't support completion mode", name());
+        on = false;
+    }
+    completionMode_ = on;
+}
+
+void TcpConnection::setEdgeTriggered(bool on) {
+    assert(state_ == kConnecting);
+    if (on && !getLoop()->supportsEdgeTriggered()) {
+        LOG_DEBUG << Fmt("TcpConnection[{}] poller doesn't support edge-triggered mode", name());
+        on = false;
+    }
+    edgeTriggered_ = on;
+}
+
+void TcpConnection::setReadBudget(size_t maxBytes, int maxReads) {
+    assert(maxBytes > 0 && maxReads > 0);
+    readBudgetBytes_ = maxBytes;
+    readBudgetReads_ = maxReads;
+}
+
+void TcpConnection::setZeroCopyThreshold(size_t threshold) {
+    getLoop()->assertInLoopThread();
+    if (completionMode_) {
+        LOG_DEBUG << Fmt("TcpConnection[{}] zero-copy is not used in completion mode", name());
+        return;
+    }
+    if (threshold > 0 && zeroCopyThreshold_ == 0 && !socket_.setZeroCopy(true)) {
+        threshold = 0;
+    }
+    zeroCopyThreshold_ = threshold;
 }
 
 void TcpConnection::connectEstablished() {
-    loop_->assertInLoopThread();
+    getLoop()->assertInLoopThread();
     assert(state_ == kConnecting);
     setState(kConnected);
-    channel_->tie(weak_from_this());
-    channel_->enableReading();
+    lastActive_ = Timestamp::now();
+    channel_.tie(weak_from_this());
+    if (completionMode_) {
+        // registered without interest, so that connectDestroyed can remove it.
+        channel_.disableAll();
+        submitRecv();
+    } else {
+        channel_.setEdgeTriggered(edgeTriggered_);
+        channel_.enableReading();
+    }
 
-    connectionCallback_(shared_from_this());
+    callbacks_->connectionCallback(shared_from_this());
 }
 
 void TcpConnection::connectDestroyed() {
-    loop_->assertInLoopThread();
-    if (state_ == kConnected) {
+    getLoop()->assertInLoopThread();
+    if (state_ == kConnected || state_ == kDisconnecting) {
         setState(kDisconnected);
-        channel_->disableAll();
-        connectionCallback_(shared_from_this());
+        channel_.disableAll();
+        cancelIo();
+        callbacks_->connectionCallback(shared_from_this());
     }
-    channel_->remove();
+    if (!zeroCopyHolds_.empty()) {
+        auto holds = std::make_shared<std::vector<ZeroCopyHold>>(std::move(zeroCopyHolds_));
+        getLoop()->runAfter(kZeroCopyLingerSeconds, [holds] {});
+    }
+    channel_.remove();
 }
 
 void TcpConnection::handleRead(Timestamp receiveTime) {
-    loop_->assertInLoopThread();
+    getLoop()->assertInLoopThread();
+    if (edgeTriggered_) {
+        if (channel_.revents() & POLLRDHUP) {
+            pendingEof_ = true;
+        }
+        drainInput(receiveTime);
+        releaseInputIfDrained();
+        return;
+    }
     int saveErrno = 0;
-    ssize_t n = inputBuffer_.readFd(channel_->fd(), &saveErrno);
+    ssize_t n = readInput(&saveErrno);
     if (n > 0) {
-        messageCallback_(shared_from_this(), &inputBuffer_, receiveTime);
+        lastActive_ = receiveTime;
+        callbacks_->messageCallback(shared_from_this(), &inputBuffer_, receiveTime);
+        releaseInputIfDrained();
     } else if (n == 0) {
         handleClose();
     } else {
@@ -229,46 +577,244 @@ void TcpConnection::handleRead(Timestamp receiveTime) {
     }
 }
 
-void TcpConnection::handleWrite() {
-    loop_->assertInLoopThread();
-    if (channel_->isWriting()) {
-        ssize_t n = sockets::write(channel_->fd(),
-                                   outputBuffer_.peek(),
-                                   outputBuffer_.readableBytes());
+void TcpConnection::drainInput(Timestamp receiveTime) {
+    size_t total = 0;
+    for (int reads = 0; reads < readBudgetReads_ && total < readBudgetBytes_; ++reads) {
+        const size_t capacity = inputBuffer_.readFdCapacity();
+        int saveErrno = 0;
+        ssize_t n = readInput(&saveErrno);
         if (n > 0) {
-            outputBuffer_.retrieve(n);
-            if (outputBuffer_.readableBytes() == 0) {
-                channel_->disableWriting();
-                if (writeCompleteCallback_) {
-                    loop_->queueInLoop(std::bind(writeCompleteCallback_, shared_from_this()));
-                }
-                if (state_ == kDisconnecting) {
-                    shutdownInLoop();
-                }
+            total += static_cast<size_t>(n);
+            lastActive_ = receiveTime;
+            callbacks_->messageCallback(shared_from_this(), &inputBuffer_, receiveTime);
+            // the bytes arriving after a short read raise another edge, an EOF doesn't.
+            if ((static_cast<size_t>(n) < capacity && !pendingEof_) ||
+                !reading_ || state_ == kDisconnected) {
+                return;
+            }
+        } else if (n == 0) {
+            handleClose();
+            return;
+        } else {
+            if (saveErrno != EAGAIN) {
+                errno = saveErrno;
+                LOG_SYSERR << "TcpConnection::drainInput";
+                handleError();
+            }
+            return;
+        }
+    }
+    // no edge is coming for the bytes left, read them once the other ready connections were served.
+    if (!readRequeued_) {
+        readRequeued_ = true;
+        queueInLoop(std::bind(&TcpConnection::continueRead, shared_from_this()));
+    }
+}
+
+void TcpConnection::continueRead() {
+    getLoop()->assertInLoopThread();
+    readRequeued_ = false;
+    if (reading_ && (state_ == kConnected || state_ == kDisconnecting)) {
+        drainInput(getLoop()->pollReturnTime());
+        releaseInputIfDrained();
+    }
+}
+
+void TcpConnection::handleWrite() {
+    getLoop()->assertInLoopThread();
+    if (channel_.isWriting()) {
+        int savedErrno = 0;
+        // 0 bytes is possible when only empty files were queued.
+        ssize_t n = writeOutput(&savedErrno);
+        // edge-triggered, a write which didn't fill the socket buffer raises no edge to wait for.
+        while (edgeTriggered_ && n > 0 && queuedBytes() > 0) {
+            ssize_t more = writeOutput(&savedErrno);
+            if (more <= 0) {
+                break;
+            }
+            n += more;
+        }
+        if (n >= 0) {
+            if (n > 0) {
+                lastActive_ = getLoop()->pollReturnTime();
+            }
+            if (queuedBytes() == 0) {
+                channel_.disableWriting();
+                writeDone();
             }
         } else {
+            errno = savedErrno;
             LOG_SYSERR << "TcpConnection::handleWrite";
         }
     } else {
-        LOG_TRACE << Fmt("Connection fd = {} is down, no more writing", channel_->fd());
+        LOG_TRACE << Fmt("Connection fd = {} is down, no more writing", channel_.fd());
+    }
+}
+
+ssize_t TcpConnection::writeOutput(int *savedErrno) {
+    ssize_t total = 0;
+    while (true) {
+        if (outputBuffer_.readableBytes() > 0) {
+            ssize_t n = writeChain(&outputBuffer_, savedErrno);
+            if (n < 0) {
+                return total > 0 ? total : n;
+            }
+            total += n;
+            if (outputBuffer_.readableBytes() > 0) {
+                break;
+            }
+        }
+        if (pendingFiles_.empty()) {
+            break;
+        }
+        PendingFile &file = pendingFiles_.front();
+        if (!file.fds.empty()) {
+            ssize_t n = writeFds(&file, savedErrno);
+            if (n < 0) {
+                return total > 0 ? total : n;
+            }
+            total += n;
+        }
+        if (file.remaining == 0) {
+            popFile();
+            continue;
+        }
+        ssize_t n = sockets::sendfile(channel_.fd(), file.fd, &file.offset, file.remaining);
+        if (n > 0) {
+            total += n;
+            file.remaining -= static_cast<size_t>(n);
+            if (file.remaining > 0) {
+                break;
+            }
+        } else if (n == 0) {
+            LOG_ERROR << Fmt("TcpConnection::writeOutput [{}] - file ends {} bytes early",
+                             name(), file.remaining);
+            file.remaining = 0;
+        } else if (errno == EINVAL || errno == ENOSYS) {
+            // not a file sendfile can read from, copy it through outputBuffer_ instead.
+            readFileChunk(&file);
+        } else {
+            *savedErrno = errno;
+            return total > 0 ? total : n;
+        }
+    }
+    return total;
+}
+
+ssize_t TcpConnection::writeChain(ChainBuffer *buf, int *savedErrno) {
+    bool zeroCopy = zeroCopyThreshold_ > 0 && buf->readableBytes() >= zeroCopyThreshold_;
+    if (!zeroCopy && zeroCopyHolds_.empty()) {
+        return buf->writeFd(channel_.fd(), savedErrno);
+    }
+    struct iovec vec[ChainBuffer::kMaxIovec];
+    struct msghdr msg{};
+    msg.msg_iov = vec;
+    msg.msg_iovlen = static_cast<size_t>(buf->fillIovec(vec, ChainBuffer::kMaxIovec));
+    ssize_t n = sockets::sendmsg(channel_.fd(), &msg, zeroCopy ? MSG_ZEROCOPY : 0);
+    if (n < 0 && zeroCopy && errno == ENOBUFS) {
+        // too many notifications pending, send this one by copy.
+        zeroCopy = false;
+        n = sockets::sendmsg(channel_.fd(), &msg, 0);
+    }
+    if (n < 0) {
+        *savedErrno = errno;
+        return n;
+    }
+    if (zeroCopy && n > 0) {
+        zeroCopyHolds_.push_back(ZeroCopyHold{zeroCopyNextSeq_++, ChainBuffer()});
+    }
+    if (zeroCopyHolds_.empty()) {
+        // the first zero-copy send fell back to copying.
+        buf->retrieve(static_cast<size_t>(n));
+    } else {
+        // blocks sent by copy may share a page with ones a zero-copy send still reads.
+        buf->retrieve(static_cast<size_t>(n), &zeroCopyHolds_.back().blocks);
+    }
+    return n;
+}
+
+bool TcpConnection::readZeroCopyNotifications() {
+    bool found = false;
+    while (true) {
+        char control[128];
+        struct msghdr msg{};
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof control;
+        if (::recvmsg(channel_.fd(), &msg, MSG_ERRQUEUE | MSG_DONTWAIT) < 0) {
+            break;
+        }
+        for (struct cmsghdr *cm = CMSG_FIRSTHDR(&msg); cm; cm = CMSG_NXTHDR(&msg, cm)) {
+            if (!(cm->cmsg_level == SOL_IP && cm->cmsg_type == IP_RECVERR) &&
+                !(cm->cmsg_level == SOL_IPV6 && cm->cmsg_type == IPV6_RECVERR)) {
+                continue;
+            }
+            auto *err = reinterpret_cast<const struct sock_extended_err *>(CMSG_DATA(cm));
+            if (err->ee_errno != 0 || err->ee_origin != SO_EE_ORIGIN_ZEROCOPY) {
+                continue;
+            }
+            found = true;
+            if ((err->ee_code & SO_EE_CODE_ZEROCOPY_COPIED) && zeroCopyThreshold_ > 0) {
+                // e.g. over loopback, pinning pages only adds cost to the copy.
+                LOG_DEBUG << Fmt("TcpConnection[{}] zero-copy send was copied, turn it off", name());
+                zeroCopyThreshold_ = 0;
+            }
+            completeZeroCopy(err->ee_info, err->ee_data);
+        }
+    }
+    return found;
+}
+
+void TcpConnection::completeZeroCopy(uint32_t lo, uint32_t hi) {
+    zeroCopyRanges_.emplace_back(lo, hi);
+    bool advanced = true;
+    while (advanced) {
+        advanced = false;
+        for (auto it = zeroCopyRanges_.begin(); it != zeroCopyRanges_.end(); ++it) {
+            if (it->first == zeroCopyDoneSeq_) {
+                zeroCopyDoneSeq_ = it->second + 1;
+                zeroCopyRanges_.erase(it);
+                advanced = true;
+                break;
+            }
+        }
+    }
+    auto done = zeroCopyHolds_.begin();
+    while (done != zeroCopyHolds_.end() && static_cast<int32_t>(done->seq - zeroCopyDoneSeq_) < 0) {
+        ++done;
+    }
+    zeroCopyHolds_.erase(zeroCopyHolds_.begin(), done);
+}
+
+void TcpConnection::writeDone() {
+    if (callbacks_->writeCompleteCallback) {
+        getLoop()->queueInLoop(std::bind(callbacks_->writeCompleteCallback, shared_from_this()));
+    }
+    if (state_ == kDisconnecting) {
+        shutdownInLoop();
     }
 }
 
 void TcpConnection::handleClose() {
-    loop_->assertInLoopThread();
-    LOG_TRACE << Fmt("fd = {} state = {}", channel_->fd(), stateToString());
+    getLoop()->assertInLoopThread();
+    LOG_TRACE << Fmt("fd = {} state = {}", channel_.fd(), stateToString());
     assert(state_ == kConnected || state_ == kDisconnecting);
     setState(kDisconnected);
-    channel_->disableAll();
+    channel_.disableAll();
+    cancelIo();
     TcpConnectionPtr guardThis(shared_from_this());
-    connectionCallback_(guardThis);
-    closeCallback_(guardThis);
+    callbacks_->connectionCallback(guardThis);
+    callbacks_->closeCallback(guardThis);
 }
 
 void TcpConnection::handleError() {
-    int err = sockets::getSocketError(channel_->fd());
+    // notifications of zero-copy sends arrive on the error queue as well.
+    bool notified = !zeroCopyHolds_.empty() && readZeroCopyNotifications();
+    int err = sockets::getSocketError(channel_.fd());
+    if (notified && err == 0) {
+        return;
+    }
     LOG_ERROR << Fmt("TcpConnection::handleError [{}] - SO_ERROR = {} {}",
-                     name_, err, strerror_tr(err));
+                     name(), err, strerror_tr(err));
 }
 
 void TcpConnection::sendInLoop(const string_view &message) {
@@ -276,12 +822,14 @@ void TcpConnection::sendInLoop(const string_view &message) {
 }
 
 void TcpConnection::sendInLoop(Buffer &message) {
-    sendInLoop(message.peek(), message.readableBytes());
-    message.retrieveAll();
+    // the unsent part of a large buffer is queued without being copied.
+    ChainBuffer chain;
+    chain.append(std::move(message));
+    sendInLoop(chain);
 }
 
 void TcpConnection::sendInLoop(const void *message, size_t len) {
-    loop_->assertInLoopThread();
+    getLoop()->assertInLoopThread();
     ssize_t nwrote = 0;
     size_t remaining = len;
     bool faultError = false;
@@ -289,12 +837,12 @@ void TcpConnection::sendInLoop(const void *message, size_t len) {
         LOG_WARN << "disconnected, give up writing";
         return;
     }
-    if (!channel_->isWriting() && outputBuffer_.readableBytes() == 0) {
-        nwrote = sockets::write(channel_->fd(), message, len);
+    if (!writePending() && queuedBytes() == 0) {
+        nwrote = sockets::write(channel_.fd(), message, len);
         if (nwrote >= 0) {
             remaining = len - nwrote;
-            if (remaining == 0 && writeCompleteCallback_) {
-                loop_->queueInLoop(std::bind(writeCompleteCallback_, shared_from_this()));
+            if (remaining == 0 && callbacks_->writeCompleteCallback) {
+                getLoop()->queueInLoop(std::bind(callbacks_->writeCompleteCallback, shared_from_this()));
             }
         } else {
             nwrote = 0;
@@ -308,14 +856,165 @@ void TcpConnection::sendInLoop(const void *message, size_t len) {
     }
     assert(remaining <= len);
     if (!faultError && remaining > 0) {
-        size_t oldLen = outputBuffer_.readableBytes();
-        if (oldLen + remaining >= highWaterMark_ && oldLen < highWaterMark_ && highWaterMarkCallback_) {
-            loop_->queueInLoop(std::bind(highWaterMarkCallback_, shared_from_this(), oldLen + remaining));
+        size_t oldLen = queuedBytes();
+        outputTail().append(static_cast<const char *>(message) + nwrote, remaining);
+        outputQueued(oldLen);
+    }
+}
+
+void TcpConnection::sendInLoop(ChainBuffer &message) {
+    getLoop()->assertInLoopThread();
+    bool faultError = false;
+    if (state_ == kDisconnected) {
+        LOG_WARN << "disconnected, give up writing";
+        return;
+    }
+    if (!writePending() && queuedBytes() == 0) {
+        int savedErrno = 0;
+        if (writeChain(&message, &savedErrno) >= 0) {
+            if (message.readableBytes() == 0 && callbacks_->writeCompleteCallback) {
+                getLoop()->queueInLoop(std::bind(callbacks_->writeCompleteCallback, shared_from_this()));
+            }
+        } else if (savedErrno != EWOULDBLOCK) {
+            errno = savedErrno;
+            LOG_SYSERR << "TcpConnection::sendInLoop";
+            if (errno == EPIPE || errno == ECONNRESET) {
+                faultError = true;
+            }
+        }
+    }
+    if (!faultError && message.readableBytes() > 0) {
+        size_t oldLen = queuedBytes();
+        outputTail().append(std::move(message));
+        outputQueued(oldLen);
+    }
+}
+
+void TcpConnection::sendFileInLoop(int fd, off_t offset, size_t len) {
+    getLoop()->assertInLoopThread();
+    if (state_ == kDisconnected) {
+        LOG_WARN << "disconnected, give up sending file";
+        ::close(fd);
+        return;
+    }
+    size_t oldLen = queuedBytes();
+    pendingFiles_.push_back(PendingFile{fd, offset, len, ChainBuffer(), std::vector<int>()});
+    outputQueued(oldLen);
+}
+
+void TcpConnection::sendFdsInLoop(const std::vector<int> &fds, const string &message) {
+    getLoop()->assertInLoopThread();
+    if (state_ == kDisconnected || completionMode_) {
+        if (completionMode_) {
+            LOG_ERROR << Fmt("TcpConnection::sendFds [{}] - not supported in completion mode", name());
+        } else {
+            LOG_WARN << "disconnected, give up passing fds";
         }
-        outputBuffer_.append(static_cast<const char *>(message) + nwrote, remaining);
-        if (!channel_->isWriting()) {
-            channel_->enableWriting();
+        for (int fd: fds) {
+            ::close(fd);
         }
+        return;
+    }
+    size_t oldLen = queuedBytes();
+    pendingFiles_.push_back(PendingFile{-1, 0, 0, ChainBuffer(), fds});
+    pendingFiles_.back().trailer.append(message.data(), message.size());
+    if (oldLen == 0 && !writePending()) {
+        int savedErrno = 0;
+        if (writeOutput(&savedErrno) < 0 && savedErrno != EWOULDBLOCK) {
+            errno = savedErrno;
+            LOG_SYSERR << "TcpConnection::sendFdsInLoop";
+            if (errno == EPIPE || errno == ECONNRESET) {
+                return;
+            }
+        }
+        if (queuedBytes() == 0) {
+            if (callbacks_->writeCompleteCallback) {
+                getLoop()->queueInLoop(std::bind(callbacks_->writeCompleteCallback, shared_from_this()));
+            }
+            return;
+        }
+    }
+    outputQueued(oldLen);
+}
+
+ssize_t TcpConnection::writeFds(PendingFile *file, int *savedErrno) {
+    assert(outputBuffer_.readableBytes() == 0 && file->trailer.readableBytes() > 0);
+    struct iovec vec[ChainBuffer::kMaxIovec];
+    int iovcnt = file->trailer.fillIovec(vec, ChainBuffer::kMaxIovec);
+    ssize_t n = sockets::sendWithFds(channel_.fd(), vec, iovcnt,
+                                     file->fds.data(), static_cast<int>(file->fds.size()));
+    if (n < 0) {
+        *savedErrno = errno;
+        return n;
+    }
+    // the peer holds its own copies now.
+    for (int fd: file->fds) {
+        ::close(fd);
+    }
+    file->fds.clear();
+    file->trailer.retrieve(static_cast<size_t>(n));
+    return n;
+}
+
+void TcpConnection::readFileChunk(PendingFile *file) {
+    Buffer chunk(std::min(file->remaining, kFileChunkSize));
+    ssize_t n = ::pread(file->fd, chunk.beginWrite(), chunk.writableBytes(), file->offset);
+    if (n > 0) {
+        chunk.hasWritten(static_cast<size_t>(n));
+        file->offset += n;
+        file->remaining -= static_cast<size_t>(n);
+        outputBuffer_.append(std::move(chunk));
+    } else {
+        if (n < 0) {
+            LOG_SYSERR << "TcpConnection::readFileChunk";
+        }
+        LOG_ERROR << Fmt("TcpConnection::readFileChunk [{}] - {} bytes of file not sent",
+                         name(), file->remaining);
+        file->remaining = 0;
+    }
+}
+
+void TcpConnection::fillFromFiles() {
+    while (outputBuffer_.readableBytes() == 0 && !pendingFiles_.empty()) {
+        PendingFile &file = pendingFiles_.front();
+        if (file.remaining > 0) {
+            readFileChunk(&file);
+        } else {
+            popFile();
+        }
+    }
+}
+
+void TcpConnection::popFile() {
+    assert(outputBuffer_.readableBytes() == 0);
+    PendingFile &file = pendingFiles_.front();
+    assert(file.fds.empty());
+    if (file.fd >= 0) {
+        ::close(file.fd);
+    }
+    outputBuffer_.swap(file.trailer);
+    pendingFiles_.erase(pendingFiles_.begin());
+}
+
+size_t TcpConnection::queuedBytes() const {
+    size_t n = outputBuffer_.readableBytes();
+    for (const auto &file: pendingFiles_) {
+        n += file.remaining + file.trailer.readableBytes();
+    }
+    return n;
+}
+
+void TcpConnection::outputQueued(size_t oldLen) {
+    size_t newLen = queuedBytes();
+    if (newLen >= highWaterMark_ && oldLen < highWaterMark_ && highWaterMarkCallback_) {
+        getLoop()->queueInLoop(std::bind(highWaterMarkCallback_, shared_from_this(), newLen));
+    }
+    if (completionMode_) {
+        if (!sendPending_) {
+            submitSend();
+        }
+    } else if (!channel_.isWriting()) {
+        channel_.enableWriting();
     }
 }
 
@@ -336,17 +1035,128 @@ const char *TcpConnection::stateToString() const {
 }
 
 void TcpConnection::startReadInLoop() {
-    loop_->assertInLoopThread();
-    if (!reading_ || !channel_->isReading()) {
-        channel_->enableReading();
+    getLoop()->assertInLoopThread();
+    if (completionMode_) {
+        reading_ = true;
+        if (recvHeld_) {
+            recvHeld_ = false;
+            callbacks_->messageCallback(shared_from_this(), &inputBuffer_, getLoop()->pollReturnTime());
+        }
+        if (reading_ && !recvPending_ && (state_ == kConnected || state_ == kDisconnecting)) {
+            submitRecv();
+        }
+    } else if (!reading_ || !channel_.isReading()) {
+        channel_.enableReading();
         reading_ = true;
     }
 }
 
 void TcpConnection::stopReadInLoop() {
-    loop_->assertInLoopThread();
-    if (reading_ || channel_->isReading()) {
-        channel_->disableReading();
+    getLoop()->assertInLoopThread();
+    if (completionMode_) {
         reading_ = false;
+        if (recvPending_) {
+            getLoop()->cancelOperation(recvOperation_);
+        }
+    } else if (reading_ || channel_.isReading()) {
+        channel_.disableReading();
+        reading_ = false;
+    }
+}
+
+void TcpConnection::submitRecv() {
+    assert(completionMode_ && !recvPending_);
+    if (inputBuffer_.writableBytes() < kMinRecvSpace) {
+        inputBuffer_.ensureWritableBytes(kMinRecvSpace);
+    }
+    // the bound pointer keeps inputBuffer_ alive until the kernel is done with it.
+    recvPending_ = true;
+    recvOperation_ = getLoop()->submitRecv(
+            channel_.fd(), inputBuffer_.beginWrite(), inputBuffer_.writableBytes(),
+            std::bind(&TcpConnection::handleRecvComplete, shared_from_this(), _1));
+}
+
+void TcpConnection::submitSend() {
+    assert(completionMode_ && !sendPending_);
+    // the ring has no sendfile, files are copied through outputBuffer_.
+    fillFromFiles();
+    if (outputBuffer_.readableBytes() == 0) {
+        writeDone();
+        return;
+    }
+    struct iovec vec[ChainBuffer::kMaxIovec];
+    int iovcnt = outputBuffer_.fillIovec(vec, ChainBuffer::kMaxIovec);
+    sendPending_ = true;
+    sendOperation_ = getLoop()->submitSend(
+            channel_.fd(), vec, iovcnt,
+            std::bind(&TcpConnection::handleSendComplete, shared_from_this(), _1));
+}
+
+void TcpConnection::handleRecvComplete(int result) {
+    getLoop()->assertInLoopThread();
+    recvPending_ = false;
+    if (state_ == kDisconnected) {
+        return;
+    }
+    if (result > 0) {
+        inputBuffer_.hasWritten(static_cast<size_t>(result));
+        lastActive_ = getLoop()->pollReturnTime();
+        // the cancellation of stopRead() came too late, hold the bytes until startRead().
+        if (!reading_) {
+            recvHeld_ = true;
+            return;
+        }
+        callbacks_->messageCallback(shared_from_this(), &inputBuffer_, getLoop()->pollReturnTime());
+        if (reading_ && !recvPending_ && state_ != kDisconnected) {
+            submitRecv();
+        }
+    } else if (result == 0) {
+        handleClose();
+    } else if (result == -ECANCELED || result == -EAGAIN || result == -EINTR) {
+        // read may have been restarted before the cancellation completed.
+        if (reading_) {
+            submitRecv();
+        }
+    } else {
+        // the error has been consumed by recv, SO_ERROR won't report it again.
+        errno = -result;
+        LOG_SYSERR << "TcpConnection::handleRecvComplete";
+        handleClose();
+    }
+}
+
+void TcpConnection::handleSendComplete(int result) {
+    getLoop()->assertInLoopThread();
+    sendPending_ = false;
+    if (state_ == kDisconnected) {
+        return;
+    }
+    if (result >= 0 || result == -EAGAIN || result == -EINTR) {
+        if (result > 0) {
+            outputBuffer_.retrieve(static_cast<size_t>(result));
+            lastActive_ = getLoop()->pollReturnTime();
+        }
+        if (queuedBytes() > 0) {
+            submitSend();
+        } else {
+            writeDone();
+        }
+    } else if (result != -ECANCELED) {
+        // the pending recv will see the error and close the connection.
+        errno = -result;
+        LOG_SYSERR << "TcpConnection::handleSendComplete";
+    }
+}
+
+bool TcpConnection::writePending() const {
+    return completionMode_ ? sendPending_ : channel_.isWriting();
+}
+
+void TcpConnection::cancelIo() {
+    if (recvPending_) {
+        getLoop()->cancelOperation(recvOperation_);
+    }
+    if (sendPending_) {
+        getLoop()->cancelOperation(sendOperation_);
     }
 }
@@ -5,73 +5,323 @@
 #include "gg_lib/net/Acceptor.h"
 #include "gg_lib/net/EventLoop.h"
 #include "gg_lib/net/EventLoopThreadPool.h"
+#include "gg_lib/net/IdleReaper.h"
 
 #include <utility>
 
+#include "gg_lib/CountDownLatch.h"
 #include "gg_lib/Logging.h"
 
 using namespace gg_lib;
 using namespace gg_lib::net;
 
-TcpServer::TcpServer(EventLoop *loop, const InetAddress &listenAddr, string nameArg, TcpServer::Option option)
+///
+/// @brief The Acceptor and the connections of one I/O loop in kReusePortPerLoop mode.
+///
+/// It copies the callbacks of the server, so connections accepted between
+/// the destruction of TcpServer and stop() don't touch it. Lives in the loop thread
+/// except for construction.
+///
+class TcpServer::LoopShard : noncopyable,
+                             public std::enable_shared_from_this<LoopShard> {
+public:
+    LoopShard(EventLoop *loop, const InetAddress &listenAddr, string serverName, string namePrefix,
+              uint8_t index)
+            : loop_(loop),
+              serverName_(std::move(serverName)),
+              namePrefix_(std::make_shared<const string>(std::move(namePrefix))),
+              acceptor_(new Acceptor(loop, listenAddr, true)),
+              connectionPool_(std::make_shared<SlabPool>()),
+              completionMode_(false),
+              edgeTriggered_(false),
+              readBudgetBytes_(TcpConnection::kDefaultReadBudgetBytes),
+              readBudgetReads_(TcpConnection::kDefaultReadBudgetReads),
+              nextConnId_(1),
+              connections_(index) {}
+
+    EventLoop *loop() const { return loop_; }
+
+    Acceptor *acceptor() const { return acceptor_.get(); }
+
+    void setCallbacks(const TcpServer &server) {
+        connCallbacks_ = std::make_shared<ConnectionCallbacks>();
+        connCallbacks_->connectionCallback = server.connectionCallback_;
+        connCallbacks_->messageCallback = server.messageCallback_;
+        connCallbacks_->writeCompleteCallback = server.writeCompleteCallback_;
+        completionMode_ = server.completionMode_;
+        edgeTriggered_ = server.edgeTriggered_;
+        readBudgetBytes_ = server.readBudgetBytes_;
+        readBudgetReads_ = server.readBudgetReads_;
+    }
+
+    void setIdleReapers(const IdleReaperMap &reapers) { reapers_ = reapers; }
+
+    void listen() {
+        std::weak_ptr<LoopShard> weakSelf(shared_from_this());
+        connCallbacks_->closeCallback = [weakSelf](const TcpConnectionPtr &conn) {
+            std::shared_ptr<LoopShard> self = weakSelf.lock();
+            if (self) {
+                // the connection may have moved to another loop.
+                self->loop_->runInLoop(std::bind(&LoopShard::removeConnection, self, conn));
+            } else {
+                conn->getLoop()->queueInLoop(std::bind(&TcpConnection::connectDestroyed, conn));
+            }
+        };
+        if (!reapers_.empty()) {
+            connCallbacks_->migrateCallback = [weakSelf](const TcpConnectionPtr &conn) {
+                std::shared_ptr<LoopShard> self = weakSelf.lock();
+                if (self) {
+                    addToIdleReaper(self->reapers_, conn);
+                }
+            };
+        }
+        acceptor_->setNewConnectionCallback([weakSelf](int sockfd, const InetAddress &peerAddr) {
+            std::shared_ptr<LoopShard> self = weakSelf.lock();
+            if (self) {
+                self->newConnection(sockfd, peerAddr);
+            } else {
+                sockets::close(sockfd);
+            }
+        });
+        acceptor_->listen();
+    }
+
+    void stop() {
+        loop_->assertInLoopThread();
+        acceptor_.reset();
+        connections_.forEach([](TcpConnectionPtr &conn) {
+            conn->getLoop()->queueInLoop(std::bind(&TcpConnection::connectDestroyed, conn));
+        });
+        connections_.clear();
+    }
+
+    TcpConnectionPtr findConnection(ConnectionId id) {
+        loop_->assertInLoopThread();
+        TcpConnectionPtr *conn = connections_.find(id);
+        return conn ? *conn : TcpConnectionPtr();
+    }
+
+private:
+    void newConnection(int sockfd, const InetAddress &peerAddr) {
+        loop_->assertInLoopThread();
+        ConnectionId id = connections_.insert(TcpConnectionPtr());
+        TcpConnectionPtr conn = std::allocate_shared<TcpConnection>(
+                SlabAllocator<TcpConnection>(connectionPool_), loop_, id, namePrefix_, nextConnId_++,
+                sockfd, peerAddr);
+        *connections_.find(id) = conn;
+        LOG_INFO << Fmt("TcpServer::newConnection [{}] - new connection [{}] from {}",
+                        serverName_, conn->name(), peerAddr.toIpPort());
+        conn->setCallbacks(connCallbacks_);
+        conn->setCompletionMode(completionMode_);
+        conn->setEdgeTriggered(edgeTriggered_);
+        conn->setReadBudget(readBudgetBytes_, readBudgetReads_);
+        conn->connectEstablished();
+        addToIdleReaper(reapers_, conn);
+    }
+
+    void removeConnection(const TcpConnectionPtr &conn) {
+        loop_->assertInLoopThread();
+        LOG_INFO << Fmt("TcpServer::removeConnectionInLoop [{}] - connection {}", serverName_, conn->name());
+        // stop() may have dropped it already.
+        connections_.erase(conn->id());
+        conn->getLoop()->queueInLoop(std::bind(&TcpConnection::connectDestroyed, conn));
+    }
+
+    EventLoop *loop_;
+    const string serverName_;
+    const std::shared_ptr<const string> namePrefix_;
+    std::unique_ptr<Acceptor> acceptor_;
+    std::shared_ptr<ConnectionCallbacks> connCallbacks_;
+    std::shared_ptr<SlabPool> connectionPool_;
+    bool completionMode_;
+    bool edgeTriggered_;
+    size_t readBudgetBytes_;
+    int readBudgetReads_;
+    IdleReaperMap reapers_;
+    uint64_t nextConnId_;
+    ConnectionMap connections_;
+};
+
+TcpServer::TcpServer(EventLoop *loop, const InetAddress &listenAddr, string nameArg, TcpServer::Option option,
+                     int socketType)
         : loop_(CHECK_NOTNULL(loop)),
           ipPort_(listenAddr.toIpPort()),
           name_(std::move(nameArg)),
-          acceptor_(new Acceptor(loop, listenAddr, option == kReusePort)),
+          namePrefix_(std::make_shared<const string>(fmt::format("{}-{}#", name_, ipPort_))),
+          listenAddr_(listenAddr),
+          option_(option),
+          acceptor_(option == kReusePortPerLoop ? nullptr
+                                                : new Acceptor(loop, listenAddr, option == kReusePort, socketType)),
           threadPool_(new EventLoopThreadPool(loop, name_)),
           connectionCallback_(defaultConnectionCallback),
           messageCallback_(defaultMessageCallback),
+          connectionPool_(std::make_shared<SlabPool>()),
+          completionMode_(false),
+          edgeTriggered_(false),
+          readBudgetBytes_(TcpConnection::kDefaultReadBudgetBytes),
+          readBudgetReads_(TcpConnection::kDefaultReadBudgetReads),
+          cpuSteering_(false),
+          idleTimeout_(0.0),
+          deferAcceptSeconds_(0),
+          fastOpenQueueLength_(0),
+          tcpNoDelay_(false),
           nextConnId_(1),
           started_(0) {
-    acceptor_->setNewConnectionCallback([this](int sockfd, const InetAddress &peerAddr){
-        newConnection(sockfd, peerAddr);
-    });
+    if (option == kReusePortPerLoop && listenAddr.family() == AF_UNIX) {
+        LOG_FATAL << Fmt("TcpServer[{}] - an AF_UNIX path can't be bound once per loop", name_);
+    }
+    if (acceptor_) {
+        acceptor_->setNewConnectionCallback([this](int sockfd, const InetAddress &peerAddr){
+            newConnection(sockfd, peerAddr);
+        });
+    }
 }
 
 TcpServer::~TcpServer() {
     loop_->assertInLoopThread();
     LOG_TRACE << Fmt("TcpServer::~TcpServer [{}] destructing", name_);
-    for (auto &item: connections_) {
-        TcpConnectionPtr conn(item.second);
-        item.second.reset();
+    connections_.forEach([](TcpConnectionPtr &conn) {
         conn->getLoop()->runInLoop(
                 std::bind(&TcpConnection::connectDestroyed, conn));
+    });
+    connections_.clear();
+    for (auto &shard: shards_) {
+        shard->loop()->runInLoop(std::bind(&LoopShard::stop, shard));
+    }
+    for (auto &item: idleReapers_) {
+        item.first->runInLoop(std::bind(&IdleReaper::stop, item.second));
     }
 }
 
-void TcpServer::setThreadNum(int numThreads) {
+void TcpServer::setThreadNum(int numThreads, const CpuAffinity &affinity) {
     assert(numThreads >= 0);
-    threadPool_->setThreadNum(numThreads);
+    threadPool_->setThreadNum(numThreads, affinity);
 }
 
 void TcpServer::start() {
     if (started_.exchange(1) == 0) {
         threadPool_->start(threadInitCallback_);
-        assert(!acceptor_->listening());
-        loop_->runInLoop(
-                std::bind(&Acceptor::listen, acceptor_.get()));
+        if (completionMode_) {
+            for (EventLoop *ioLoop: threadPool_->getAllLoops()) {
+                if (!ioLoop->supportsCompletionIo()) {
+                    LOG_WARN << Fmt("TcpServer[{}] poller doesn't support completion mode, "
+                                    "fall back to readiness mode", name_);
+                    break;
+                }
+            }
+        }
+        if (idleTimeout_ > 0.0) {
+            for (EventLoop *ioLoop: threadPool_->getAllLoops()) {
+                auto reaper = std::make_shared<IdleReaper>(ioLoop, idleTimeout_);
+                idleReapers_[ioLoop] = reaper;
+                ioLoop->runInLoop(std::bind(&IdleReaper::start, reaper));
+            }
+        }
+        if (option_ == kReusePortPerLoop) {
+            startPerLoopAcceptors();
+        } else {
+            assert(!acceptor_->listening());
+            configureAcceptor(*acceptor_);
+            loop_->runInLoop(
+                    std::bind(&Acceptor::listen, acceptor_.get()));
+        }
+    }
+}
+
+void TcpServer::startPerLoopAcceptors() {
+    std::vector<EventLoop *> loops = threadPool_->getAllLoops();
+    // the index of a shard tags the ids of its connections.
+    assert(loops.size() <= 256);
+    for (size_t i = 0; i < loops.size(); ++i) {
+        auto shard = std::make_shared<LoopShard>(loops[i], listenAddr_, name_,
+                                                 fmt::format("{}-{}#{}.", name_, ipPort_, i),
+                                                 static_cast<uint8_t>(i));
+        shard->setCallbacks(*this);
+        shard->setIdleReapers(idleReapers_);
+        configureAcceptor(*shard->acceptor());
+        shards_.push_back(std::move(shard));
+    }
+    // the reuseport group indexes sockets in listen order, which must be the loop order
+    // for the steering program, so listen one after another.
+    for (auto &shard: shards_) {
+        if (shard->loop()->isInLoopThread()) {
+            shard->listen();
+        } else {
+            CountDownLatch latch(1);
+            shard->loop()->runInLoop([&shard, &latch] {
+                shard->listen();
+                latch.countDown();
+            });
+            latch.wait();
+        }
+    }
+    if (cpuSteering_) {
+        shards_.front()->acceptor()->attachReusePortCpuSteering(static_cast<int>(shards_.size()));
+    }
+}
+
+void TcpServer::configureAcceptor(const Acceptor &acceptor) const {
+    if (deferAcceptSeconds_ > 0 && !acceptor.setDeferAccept(deferAcceptSeconds_)) {
+        LOG_WARN << Fmt("TcpServer[{}] accepts without waiting for data", name_);
+    }
+    if (fastOpenQueueLength_ > 0 && !acceptor.setFastOpen(fastOpenQueueLength_)) {
+        LOG_WARN << Fmt("TcpServer[{}] accepts without TCP Fast Open", name_);
+    }
+    if (tcpNoDelay_) {
+        acceptor.setTcpNoDelay(true);
     }
 }
 
 void TcpServer::newConnection(int sockfd, const InetAddress &peerAddr) {
     loop_->assertInLoopThread();
     EventLoop *ioLoop = threadPool_->getNextLoop();
-    string connName = fmt::format("{}-{}#{}", name_, ipPort_, nextConnId_++);
+    ConnectionId id = connections_.insert(TcpConnectionPtr());
+    TcpConnectionPtr conn = std::allocate_shared<TcpConnection>(
+            SlabAllocator<TcpConnection>(connectionPool_), ioLoop, id, namePrefix_, nextConnId_++,
+            sockfd, peerAddr);
+    *connections_.find(id) = conn;
     LOG_INFO << Fmt("TcpServer::newConnection [{}] - new connection [{}] from {}",
-                    name_, connName, peerAddr.toIpPort());
-    InetAddress localAddr(sockets::getLocalAddr(sockfd));
-    TcpConnectionPtr conn =
-            std::make_shared<TcpConnection>(ioLoop, connName, sockfd, localAddr, peerAddr);
-    connections_[connName] = conn;
+                    name_, conn->name(), peerAddr.toIpPort());
 #ifndef NDEBUG
     weakVec_.push_back(conn);
 #endif
-    conn->setConnectionCallback(connectionCallback_);
-    conn->setMessageCallback(messageCallback_);
-    conn->setWriteCompleteCallback(writeCompleteCallback_);
-    // FIXME: unsafe
-    conn->setCloseCallback([this](const TcpConnectionPtr &conn){removeConnection(conn);});
-    ioLoop->runInLoop(std::bind(&TcpConnection::connectEstablished, std::move(conn)));
+    if (!connCallbacks_) {
+        connCallbacks_ = std::make_shared<ConnectionCallbacks>();
+        connCallbacks_->connectionCallback = connectionCallback_;
+        connCallbacks_->messageCallback = messageCallback_;
+        connCallbacks_->writeCompleteCallback = writeCompleteCallback_;
+        // FIXME: unsafe
+        connCallbacks_->closeCallback = [this](const TcpConnectionPtr &conn) { removeConnection(conn); };
+        if (!idleReapers_.empty()) {
+            connCallbacks_->migrateCallback =
+                    std::bind(&TcpServer::addToIdleReaper, std::cref(idleReapers_), _1);
+        }
+    }
+    conn->setCallbacks(connCallbacks_);
+    conn->setCompletionMode(completionMode_);
+    conn->setEdgeTriggered(edgeTriggered_);
+    conn->setReadBudget(readBudgetBytes_, readBudgetReads_);
+    ioLoop->runInLoop(std::bind(&TcpConnection::connectEstablished, conn));
+    if (!idleReapers_.empty()) {
+        ioLoop->runInLoop(std::bind(&TcpServer::addToIdleReaper, std::cref(idleReapers_), std::move(conn)));
+    }
+}
+
+TcpConnectionPtr TcpServer::findConnection(ConnectionId id) {
+    if (option_ == kReusePortPerLoop) {
+        size_t index = ConnectionMap::tagOf(id);
+        return index < shards_.size() ? shards_[index]->findConnection(id) : TcpConnectionPtr();
+    }
+    loop_->assertInLoopThread();
+    TcpConnectionPtr *conn = connections_.find(id);
+    return conn ? *conn : TcpConnectionPtr();
+}
+
+void TcpServer::addToIdleReaper(const IdleReaperMap &reapers, const TcpConnectionPtr &conn) {
+    auto iter = reapers.find(conn->getLoop());
+    if (iter != reapers.end()) {
+        iter->second->add(conn);
+    }
 }
 
 /// here may be not safe cause TcpConnectionPtr may live after TcpServer destroy,
@@ -84,8 +334,9 @@ void TcpServer::removeConnection(const TcpConnectionPtr &conn) {
 void TcpServer::removeConnectionInLoop(const TcpConnectionPtr &conn) {
     loop_->assertInLoopThread();
     LOG_INFO << Fmt("TcpServer::removeConnectionInLoop [{}] - connection {}", name_, conn->name());
-    size_t n = connections_.erase(conn->name());
-    assert(n == 1);
+    bool erased = connections_.erase(conn->id());
+    assert(erased);
+    (void) erased;
     EventLoop *ioLoop = conn->getLoop();
     ioLoop->queueInLoop(
             std::bind(&TcpConnection::connectDestroyed, conn));
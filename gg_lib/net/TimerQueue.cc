@@ -6,6 +6,8 @@
 #include "gg_lib/net/TimerQueue.h"
 #include "gg_lib/net/Timer.h"
 #include "gg_lib/net/EventLoop.h"
+#include "gg_lib/net/timer/HeapTimerQueue.h"
+#include "gg_lib/net/timer/WheelTimerQueue.h"
 
 #include <sys/timerfd.h>
 #include <unistd.h>
@@ -44,7 +46,7 @@ namespace gg_lib {
                 }
             }
 
-            void resetTimerfd(int timerfd, Timestamp expiration) {
+            void setTimerfd(int timerfd, Timestamp expiration) {
                 // wake up loop by timerfd_settime()
                 struct itimerspec newValue{};
                 struct itimerspec oldValue{};
@@ -67,8 +69,7 @@ AtomicInt64 Timer::s_numCreated_;
 TimerQueue::TimerQueue(EventLoop *loop)
         : loop_(loop),
           timerfd_(createTimerfd()),
-          timerfdChannel_(loop, timerfd_),
-          timers_() {
+          timerfdChannel_(loop, timerfd_) {
     timerfdChannel_.setReadCallback(
             std::bind(&TimerQueue::handleRead, this));
     timerfdChannel_.enableReading();
@@ -78,108 +79,23 @@ TimerQueue::~TimerQueue() {
     timerfdChannel_.disableAll();
     timerfdChannel_.remove();
     ::close(timerfd_);
-    // here we don't need to delete timers, since they are managed by shared_ptr.
 }
 
-TimerId TimerQueue::addTimer(TimerCallback cb,
-                             Timestamp when,
-                             double interval) {
-    auto timer = new Timer(std::move(cb), when, interval);
-    TimerId timerId = timer->sequence();
-    loop_->runInLoop(
-            std::bind(&TimerQueue::addTimerInLoop, this, timer));
-    return timerId;
-}
-
-void TimerQueue::cancel(TimerId timerId) {
-    loop_->runInLoop(
-            std::bind(&TimerQueue::cancelInLoop, this, timerId));
-}
-
-void TimerQueue::addTimerInLoop(Timer *rawTimer) {
-    loop_->assertInLoopThread();
-    auto timer = std::unique_ptr<Timer>(rawTimer);
-    auto expiration = timer->expiration();
-    bool earliestChanged = insert(timer);
-    if (earliestChanged) {
-        resetTimerfd(timerfd_, expiration);
+TimerQueue *TimerQueue::newTimerQueue(EventLoop *loop, TimerQueueType type) {
+    if (type == kWheelTimerQueue) {
+        return new WheelTimerQueue(loop);
+    } else {
+        return new HeapTimerQueue(loop);
     }
 }
 
-void TimerQueue::cancelInLoop(TimerId timerId) {
-    loop_->assertInLoopThread();
-    activeTimers_.erase(timerId);
+void TimerQueue::resetTimerfd(Timestamp expiration) {
+    setTimerfd(timerfd_, expiration);
 }
 
 void TimerQueue::handleRead() {
     loop_->assertInLoopThread();
     Timestamp now = Timestamp::now();
     readTimerfd(timerfd_, now);
-    std::vector<Timer*> expired = getExpired(now);
-    for (auto ptr: expired) {
-        ptr->run();
-    }
-    reset(expired, now);
-}
-
-std::vector<Timer*> TimerQueue::getExpired(Timestamp now) {
-    std::vector<Timer*> expired;
-    while (!timers_.empty()) {
-        const auto& entry = timers_.top();
-        if (entry.first <= now) {
-            auto iter = activeTimers_.find(entry.second);
-            if (iter != activeTimers_.end()) {
-                expired.push_back(iter->second.get());
-            }
-            timers_.pop();
-        } else {
-            break;
-        }
-    }
-    return expired;
-}
-
-void TimerQueue::reset(const std::vector<Timer*> &expired, Timestamp now) {
-    Timestamp nextExpire;
-    for (auto timer: expired) {
-        TimerId timerId = timer->sequence();
-        // repeat timer may be deleted in its callback.
-        if (timer->repeat() && activeTimers_.find(timerId) != activeTimers_.end()) {
-            timer->restart(now);
-            Timestamp when = timer->expiration();
-            timers_.emplace(when, timerId);
-        } else {
-            activeTimers_.erase(timerId);
-        }
-    }
-    while (!timers_.empty()) {
-        const auto& entry = timers_.top();
-        auto iter = activeTimers_.find(entry.second);
-        if (iter == activeTimers_.end()) {
-            timers_.pop();
-        } else {
-            nextExpire = entry.first;
-            break;
-        }
-    }
-
-    if (nextExpire.valid()) {
-        resetTimerfd(timerfd_, nextExpire);
-    }
+    handleExpired(now);
 }
-
-bool TimerQueue::insert(TimerQueue::TimerPtr &timer) {
-    loop_->assertInLoopThread();
-    bool earliestChanged = false;
-    Timestamp when = timer->expiration();
-    if (timers_.empty() || when < timers_.top().first) {
-        earliestChanged = true;
-    }
-    TimerId timerId = timer->sequence();
-    timers_.emplace(when, timerId);
-    if (activeTimers_.find(timerId) == activeTimers_.end()) {
-        activeTimers_.emplace(timerId, std::move(timer));
-    }
-    return earliestChanged;
-}
-
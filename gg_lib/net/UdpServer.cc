@@ -0,0 +1,63 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#include "gg_lib/net/UdpServer.h"
+#include "gg_lib/net/EventLoop.h"
+#include "gg_lib/net/EventLoopThreadPool.h"
+#include "gg_lib/Logging.h"
+
+using namespace gg_lib;
+using namespace gg_lib::net;
+
+UdpServer::UdpServer(EventLoop *loop, const InetAddress &listenAddr, string nameArg)
+        : loop_(CHECK_NOTNULL(loop)),
+          name_(std::move(nameArg)),
+          listenAddr_(listenAddr),
+          threadPool_(new EventLoopThreadPool(loop, name_)),
+          recvBatch_(UdpSocket::kDefaultRecvBatch),
+          maxDatagramSize_(UdpSocket::kDefaultMaxDatagramSize),
+          gro_(false),
+          gso_(false),
+          started_(0) {}
+
+UdpServer::~UdpServer() {
+    loop_->assertInLoopThread();
+    LOG_TRACE << Fmt("UdpServer::~UdpServer [{}] destructing", name_);
+    // the functor takes the last reference, so the socket goes in its loop.
+    for (auto &socket: sockets_) {
+        EventLoop *ioLoop = socket->getLoop();
+        ioLoop->runInLoop(std::bind(&UdpSocket::stop, std::move(socket)));
+    }
+}
+
+void UdpServer::setThreadNum(int numThreads, const CpuAffinity &affinity) {
+    assert(numThreads >= 0);
+    threadPool_->setThreadNum(numThreads, affinity);
+}
+
+void UdpServer::start() {
+    if (started_.exchange(1) != 0) {
+        return;
+    }
+    threadPool_->start(threadInitCallback_);
+    std::vector<EventLoop *> loops = threadPool_->getAllLoops();
+    const bool reusePort = loops.size() > 1;
+    for (EventLoop *ioLoop: loops) {
+        // binds here, so the port is taken when start() returns. The others join
+        // the port the kernel picked for the first one.
+        auto socket = std::make_shared<UdpSocket>(
+                ioLoop, sockets_.empty() ? listenAddr_ : sockets_.front()->localAddress(), reusePort);
+        socket->setMessageCallback(messageCallback_);
+        if (gro_ && !socket->setGro(true)) {
+            LOG_WARN << Fmt("UdpServer::start [{}] - GRO is not supported", name_);
+        }
+        socket->setRecvBatch(recvBatch_, maxDatagramSize_);
+        if (gso_ && !socket->setGso(true)) {
+            LOG_WARN << Fmt("UdpServer::start [{}] - GSO is not supported", name_);
+        }
+        ioLoop->runInLoop(std::bind(&UdpSocket::start, socket));
+        sockets_.push_back(std::move(socket));
+    }
+    LOG_INFO << Fmt("UdpServer::start [{}] - {} sockets on {}", name_, sockets_.size(),
+                    sockets_.front()->localAddress().toIpPort());
+}
@@ -0,0 +1,342 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#include "gg_lib/net/UdpSocket.h"
+#include "gg_lib/net/EventLoop.h"
+#include "gg_lib/Logging.h"
+
+#include <errno.h>
+#include <netinet/udp.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+using namespace gg_lib;
+using namespace gg_lib::net;
+
+constexpr int UdpSocket::kDefaultRecvBatch;
+constexpr size_t UdpSocket::kDefaultMaxDatagramSize;
+constexpr size_t UdpSocket::kGroDatagramSize;
+constexpr size_t UdpSocket::kDefaultSendQueueBytes;
+
+namespace {
+    // recvmmsg calls per read event, the rest is read after the other ready channels.
+    constexpr int kMaxRecvRounds = 4;
+    constexpr int kMaxSendBatch = 64;
+    // the kernel segments at most this many datagrams of at most this many bytes in all.
+    constexpr int kMaxGsoSegments = 64;
+    constexpr size_t kMaxGsoBytes = 65000;
+    // both UDP_GRO and UDP_SEGMENT pass one integer.
+    constexpr size_t kControlSpace = CMSG_SPACE(sizeof(int));
+
+    /// The batch buffers of the current thread, shared by all its UDP sockets
+    /// since a batch is handed out and done with within one call.
+    struct BatchArena {
+        std::vector<char> buffers;
+        std::vector<struct mmsghdr> msgs;
+        std::vector<struct iovec> iovecs;
+        std::vector<struct sockaddr_in6> addrs;
+        std::vector<char> control;
+        std::vector<UdpDatagram> datagrams;
+        // datagrams in each message sent.
+        std::vector<int> msgDatagrams;
+    };
+
+    thread_local BatchArena t_arena;
+
+    template<typename T>
+    void growTo(std::vector<T> *v, size_t n) {
+        if (v->size() < n) {
+            v->resize(n);
+        }
+    }
+
+    socklen_t addrLen(const InetAddress &addr) {
+        return static_cast<socklen_t>(addr.family() == AF_INET ? sizeof(struct sockaddr_in)
+                                                              : sizeof(struct sockaddr_in6));
+    }
+
+    bool samePeer(const InetAddress &lhs, const InetAddress &rhs) {
+        if (lhs.family() != rhs.family() || lhs.portNetEndian() != rhs.portNetEndian()) {
+            return false;
+        }
+        if (lhs.family() == AF_INET) {
+            return lhs.ipv4NetEndian() == rhs.ipv4NetEndian();
+        }
+        return memcmp(&sockets::sockaddr_in6_cast(lhs.getSockAddr())->sin6_addr,
+                      &sockets::sockaddr_in6_cast(rhs.getSockAddr())->sin6_addr,
+                      sizeof(struct in6_addr)) == 0;
+    }
+}
+
+UdpSocket::UdpSocket(EventLoop *loop, const InetAddress &bindAddr, bool reusePort)
+        : loop_(CHECK_NOTNULL(loop)),
+          socket_(sockets::createUdpNonblockingOrDie(bindAddr.family())),
+          channel_(loop, socket_.fd()),
+          localAddr_(bindAddr),
+          recvBatch_(kDefaultRecvBatch),
+          maxDatagramSize_(kDefaultMaxDatagramSize),
+          gro_(false),
+          gso_(false),
+          sendHead_(0),
+          sendQueueLimit_(kDefaultSendQueueBytes),
+          flushQueued_(false),
+          numReceived_(0),
+          numSent_(0),
+          numDropped_(0),
+          numRecvCalls_(0),
+          numSendCalls_(0) {
+    socket_.setReuseAddr(true);
+    socket_.setReusePort(reusePort);
+    socket_.bindAddress(bindAddr);
+    localAddr_ = InetAddress(sockets::getLocalAddr(socket_.fd()));
+    channel_.setReadCallback(std::bind(&UdpSocket::handleRead, this, _1));
+    channel_.setWriteCallback(std::bind(&UdpSocket::handleWrite, this));
+}
+
+UdpSocket::~UdpSocket() {
+    channel_.disableAll();
+    channel_.remove();
+}
+
+void UdpSocket::setRecvBatch(int datagrams, size_t maxDatagramSize) {
+    assert(datagrams > 0 && maxDatagramSize > 0);
+    recvBatch_ = datagrams;
+    maxDatagramSize_ = gro_ ? std::max(maxDatagramSize, kGroDatagramSize) : maxDatagramSize;
+}
+
+bool UdpSocket::setGro(bool on) {
+    if (!socket_.setUdpGro(on)) {
+        return false;
+    }
+    gro_ = on;
+    if (on) {
+        // a coalesced read longer than the buffer is cut short.
+        maxDatagramSize_ = std::max(maxDatagramSize_, kGroDatagramSize);
+    }
+    return true;
+}
+
+bool UdpSocket::setGso(bool on) {
+    if (on && !socket_.supportsUdpGso()) {
+        return false;
+    }
+    gso_ = on;
+    return true;
+}
+
+void UdpSocket::start() {
+    loop_->assertInLoopThread();
+    channel_.tie(weak_from_this());
+    channel_.enableReading();
+}
+
+void UdpSocket::stop() {
+    loop_->assertInLoopThread();
+    channel_.disableReading();
+}
+
+void UdpSocket::handleRead(Timestamp receiveTime) {
+    loop_->assertInLoopThread();
+    BatchArena &arena = t_arena;
+    const auto batch = static_cast<size_t>(recvBatch_);
+    growTo(&arena.buffers, batch * maxDatagramSize_);
+    growTo(&arena.msgs, batch);
+    growTo(&arena.iovecs, batch);
+    growTo(&arena.addrs, batch);
+    growTo(&arena.control, batch * kControlSpace);
+    for (int round = 0; round < kMaxRecvRounds; ++round) {
+        for (size_t i = 0; i < batch; ++i) {
+            arena.iovecs[i].iov_base = &arena.buffers[i * maxDatagramSize_];
+            arena.iovecs[i].iov_len = maxDatagramSize_;
+            struct msghdr &hdr = arena.msgs[i].msg_hdr;
+            memset(&hdr, 0, sizeof hdr);
+            hdr.msg_name = &arena.addrs[i];
+            hdr.msg_namelen = static_cast<socklen_t>(sizeof(struct sockaddr_in6));
+            hdr.msg_iov = &arena.iovecs[i];
+            hdr.msg_iovlen = 1;
+            if (gro_) {
+                hdr.msg_control = &arena.control[i * kControlSpace];
+                hdr.msg_controllen = kControlSpace;
+            }
+        }
+        int n = sockets::recvmmsg(socket_.fd(), arena.msgs.data(), static_cast<unsigned int>(batch), MSG_DONTWAIT);
+        if (n < 0) {
+            if (errno != EAGAIN && errno != EINTR) {
+                LOG_SYSERR << "UdpSocket::handleRead";
+            }
+            return;
+        }
+        ++numRecvCalls_;
+        arena.datagrams.clear();
+        for (int i = 0; i < n; ++i) {
+            struct msghdr &hdr = arena.msgs[i].msg_hdr;
+            if (hdr.msg_flags & MSG_TRUNC) {
+                ++numDropped_;
+                continue;
+            }
+            const size_t len = arena.msgs[i].msg_len;
+            size_t segment = len;
+#ifdef UDP_GRO
+            if (gro_) {
+                for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(&hdr); cmsg; cmsg = CMSG_NXTHDR(&hdr, cmsg)) {
+                    if (cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_GRO) {
+                        int size;
+                        memcpy(&size, CMSG_DATA(cmsg), sizeof size);
+                        segment = size > 0 ? static_cast<size_t>(size) : len;
+                    }
+                }
+            }
+#endif
+            const char *data = static_cast<const char *>(arena.iovecs[i].iov_base);
+            InetAddress peer(arena.addrs[i]);
+            for (size_t offset = 0; offset < len; offset += segment) {
+                arena.datagrams.push_back(UdpDatagram{data + offset, std::min(segment, len - offset), peer});
+            }
+            // an empty datagram is a datagram as well.
+            if (len == 0) {
+                arena.datagrams.push_back(UdpDatagram{data, 0, peer});
+            }
+        }
+        if (!arena.datagrams.empty()) {
+            numReceived_ += static_cast<int64_t>(arena.datagrams.size());
+            if (messageCallback_) {
+                messageCallback_(shared_from_this(), arena.datagrams.data(),
+                                 static_cast<int>(arena.datagrams.size()), receiveTime);
+            }
+        }
+        if (static_cast<size_t>(n) < batch) {
+            return;
+        }
+    }
+}
+
+bool UdpSocket::send(const void *data, size_t len, const InetAddress &peer) {
+    loop_->assertInLoopThread();
+    if (sendData_.size() + len > sendQueueLimit_) {
+        ++numDropped_;
+        return false;
+    }
+    const size_t offset = sendData_.size();
+    const char *bytes = static_cast<const char *>(data);
+    sendData_.insert(sendData_.end(), bytes, bytes + len);
+    sendQueue_.push_back(PendingDatagram{offset, len, peer});
+    if (!flushQueued_ && !channel_.isWriting()) {
+        flushQueued_ = true;
+        std::weak_ptr<UdpSocket> weakSelf(shared_from_this());
+        loop_->queueInLoop([weakSelf] {
+            UdpSocketPtr self = weakSelf.lock();
+            if (self) {
+                self->flushQueued_ = false;
+                self->flush();
+            }
+        });
+    }
+    return true;
+}
+
+void UdpSocket::flush() {
+    loop_->assertInLoopThread();
+    BatchArena &arena = t_arena;
+    while (sendHead_ < sendQueue_.size()) {
+        int count = fillSendBatch();
+        int n = sockets::sendmmsg(socket_.fd(), arena.msgs.data(), static_cast<unsigned int>(count), 0);
+        if (n < 0) {
+            int savedErrno = errno;
+            if (savedErrno == EAGAIN || savedErrno == ENOBUFS) {
+                if (!channel_.isWriting()) {
+                    channel_.enableWriting();
+                }
+                return;
+            } else if (savedErrno == EINTR) {
+                continue;
+            } else if (gso_ && arena.msgDatagrams[0] > 1 && (savedErrno == EIO || savedErrno == EINVAL)) {
+                // the route can't segment, e.g. without checksum offload.
+                LOG_WARN << Fmt("UdpSocket::flush - GSO refused ({}), sending datagrams one by one",
+                                strerror_tr(savedErrno));
+                gso_ = false;
+                continue;
+            }
+            errno = savedErrno;
+            LOG_SYSERR << "UdpSocket::flush";
+            // drop the first message, the others may still go.
+            sendHead_ += static_cast<size_t>(arena.msgDatagrams[0]);
+            numDropped_ += arena.msgDatagrams[0];
+            continue;
+        }
+        ++numSendCalls_;
+        for (int i = 0; i < n; ++i) {
+            sendHead_ += static_cast<size_t>(arena.msgDatagrams[i]);
+            numSent_ += arena.msgDatagrams[i];
+        }
+    }
+    sendData_.clear();
+    sendQueue_.clear();
+    sendHead_ = 0;
+    if (channel_.isWriting()) {
+        channel_.disableWriting();
+    }
+}
+
+void UdpSocket::handleWrite() {
+    loop_->assertInLoopThread();
+    flush();
+}
+
+int UdpSocket::fillSendBatch() {
+    BatchArena &arena = t_arena;
+    growTo(&arena.msgs, static_cast<size_t>(kMaxSendBatch));
+    growTo(&arena.iovecs, static_cast<size_t>(kMaxSendBatch * kMaxGsoSegments));
+    growTo(&arena.control, kMaxSendBatch * kControlSpace);
+    growTo(&arena.msgDatagrams, static_cast<size_t>(kMaxSendBatch));
+    int count = 0;
+    size_t next = sendHead_;
+    size_t iov = 0;
+    while (count < kMaxSendBatch && next < sendQueue_.size()) {
+        const PendingDatagram &first = sendQueue_[next];
+        int segments = 1;
+        if (gso_) {
+            size_t bytes = first.len;
+            // all but the last segment have the size of the first.
+            while (next + segments < sendQueue_.size() && segments < kMaxGsoSegments) {
+                const PendingDatagram &d = sendQueue_[next + segments];
+                if (d.len == 0 || d.len > first.len || bytes + d.len > kMaxGsoBytes || !samePeer(d.peer, first.peer)) {
+                    break;
+                }
+                bytes += d.len;
+                ++segments;
+                if (d.len < first.len) {
+                    break;
+                }
+            }
+        }
+        struct msghdr &hdr = arena.msgs[count].msg_hdr;
+        memset(&hdr, 0, sizeof hdr);
+        hdr.msg_name = const_cast<struct sockaddr *>(first.peer.getSockAddr());
+        hdr.msg_namelen = addrLen(first.peer);
+        hdr.msg_iov = &arena.iovecs[iov];
+        hdr.msg_iovlen = static_cast<size_t>(segments);
+        for (int k = 0; k < segments; ++k) {
+            const PendingDatagram &d = sendQueue_[next + k];
+            arena.iovecs[iov].iov_base = sendData_.data() + d.offset;
+            arena.iovecs[iov].iov_len = d.len;
+            ++iov;
+        }
+#ifdef UDP_SEGMENT
+        if (segments > 1) {
+            hdr.msg_control = &arena.control[count * kControlSpace];
+            hdr.msg_controllen = CMSG_SPACE(sizeof(uint16_t));
+            struct cmsghdr *cmsg = CMSG_FIRSTHDR(&hdr);
+            cmsg->cmsg_level = SOL_UDP;
+            cmsg->cmsg_type = UDP_SEGMENT;
+            cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+            auto size = static_cast<uint16_t>(first.len);
+            memcpy(CMSG_DATA(cmsg), &size, sizeof size);
+        }
+#endif
+        arena.msgDatagrams[count] = segments;
+        ++count;
+        next += static_cast<size_t>(segments);
+    }
+    return count;
+}
@@ -4,6 +4,7 @@
 #include "gg_lib/net/http/HttpResponse.h"
 #include "gg_lib/Logging.h"
 #include "gg_lib/net/Buffer.h"
+#include "gg_lib/net/ChainBuffer.h"
 
 using namespace gg_lib;
 using namespace gg_lib::net;
@@ -29,6 +30,24 @@ static inline void refreshDateTime() {
 }
 
 void HttpResponse::appendToBuffer(Buffer *output) const {
+    appendHeadersTo(output);
+    output->append(body_);
+}
+
+void HttpResponse::moveToBuffer(ChainBuffer *output) {
+    appendHeadersTo(output);
+    if (body_.size() < ChainBuffer::kMinSliceSize) {
+        output->append(body_);
+    } else {
+        auto body = std::make_shared<string>(std::move(body_));
+        string_view data = *body;
+        output->appendSlice(data, std::move(body));
+    }
+    body_.clear();
+}
+
+template<typename BUFFER>
+void HttpResponse::appendHeadersTo(BUFFER *output) const {
     char buf[32];
     snprintf(buf, sizeof buf, "HTTP/1.1 %d ", statusCode_);
     output->append(buf);
@@ -50,7 +69,6 @@ void HttpResponse::appendToBuffer(Buffer *output) const {
     refreshDateTime();
     output->append(t_dateTime);
     output->append("\r\n");
-    output->append(body_);
 }
 
 void HttpResponse::reset() {
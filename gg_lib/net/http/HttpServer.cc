@@ -48,7 +48,7 @@ void HttpServer::onConnection(const TcpConnectionPtr &conn) {
 
 void HttpServer::onMessage(const TcpConnectionPtr &conn, Buffer *buf, Timestamp receiveTime) {
     auto &context = any_cast<std::shared_ptr<HttpContext> &>(conn->getContext());
-    Buffer outBuf;
+    ChainBuffer outBuf;
     HttpResponse response;
     bool needClose = false;
     while (!needClose) {
@@ -58,7 +58,7 @@ void HttpServer::onMessage(const TcpConnectionPtr &conn, Buffer *buf, Timestamp
             needClose = true;
         } else if (context->gotAll()) {
             onRequest(context->request(), &response);
-            response.appendToBuffer(&outBuf);
+            response.moveToBuffer(&outBuf);
             context->reset();
             if (response.getCloseConnection()) {
                 needClose = true;
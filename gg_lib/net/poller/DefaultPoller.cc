@@ -4,12 +4,20 @@
 #include "gg_lib/net/Poller.h"
 #include "gg_lib/net/poller/PollPoller.h"
 #include "gg_lib/net/poller/EPollPoller.h"
+#include "gg_lib/net/poller/IoUringPoller.h"
+#include "gg_lib/Logging.h"
 
 using namespace gg_lib::net;
 
 Poller *Poller::newDefaultPoller(EventLoop *loop) {
     if (::getenv("USE_POLL")) {
         return new PollPoller(loop);
+    } else if (::getenv("USE_IO_URING")) {
+        if (IoUringPoller::isSupported()) {
+            return new IoUringPoller(loop);
+        }
+        LOG_WARN << "io_uring is not supported, fall back to epoll";
+        return new EPollPoller(loop);
     } else {
         return new EPollPoller(loop);
     }
@@ -9,8 +9,20 @@
 #include <errno.h>
 #include <poll.h>
 #include <sys/epoll.h>
+#include <sys/ioctl.h>
 #include <unistd.h>
 
+#ifndef EPIOCSPARAMS
+// from linux/eventpoll.h, which older headers lack.
+struct epoll_params {
+    uint32_t busy_poll_usecs;
+    uint16_t busy_poll_budget;
+    uint8_t prefer_busy_poll;
+    uint8_t __pad;
+};
+#define EPIOCSPARAMS _IOW(0x8A, 0x01, struct epoll_params)
+#endif
+
 using namespace gg_lib;
 using namespace gg_lib::net;
 
@@ -33,6 +45,19 @@ EPollPoller::~EPollPoller() {
     ::close(epollfd_);
 }
 
+bool EPollPoller::setBusyPoll(int microSeconds, int budget) {
+    assertInLoopThread();
+    struct epoll_params params{};
+    params.busy_poll_usecs = static_cast<uint32_t>(microSeconds);
+    params.busy_poll_budget = static_cast<uint16_t>(budget);
+    params.prefer_busy_poll = microSeconds > 0 ? 1 : 0;
+    if (::ioctl(epollfd_, EPIOCSPARAMS, &params) < 0) {
+        LOG_SYSERR << "EPollPoller::setBusyPoll";
+        return false;
+    }
+    return true;
+}
+
 Timestamp EPollPoller::poll(int timeoutMs, Poller::ChannelList *activeChannels) {
     LOG_TRACE << Fmt("fd total count {}", channels_.size());
     int numEvents = ::epoll_wait(epollfd_,
@@ -63,12 +88,7 @@ void EPollPoller::fillActiveChannels(int numEvents, ChannelList *activeChannels)
     activeChannels->reserve(numEvents);
     for (int i = 0; i < numEvents; ++i) {
         auto channel = static_cast<Channel *>(events_[i].data.ptr);
-#ifndef NDEBUG
-        int fd = channel->fd();
-        auto it = channels_.find(fd);
-        assert(it != channels_.end());
-        assert(it->second == channel);
-#endif
+        assert(channels_.find(channel->fd()) == channel);
         channel->set_revents(static_cast<int>(events_[i].events));
         activeChannels->push_back(channel);
     }
@@ -81,18 +101,16 @@ void EPollPoller::updateChannel(Channel *channel) {
     if (index == kNew || index == kDeleted) {
         int fd = channel->fd();
         if (index == kNew) {
-            assert(channels_.find(fd) == channels_.end());
-            channels_[fd] = channel;
+            assert(!channels_.contains(fd));
+            channels_.insert(fd, channel);
         } else {
-            assert(channels_.find(fd) != channels_.end());
-            assert(channels_[fd] == channel);
+            assert(channels_.find(fd) == channel);
         }
         channel->set_index(kAdded);
         update(EPOLL_CTL_ADD, channel);
     } else {
         int fd = channel->fd();
-        assert(channels_.find(fd) != channels_.end());
-        assert(channels_[fd] == channel);
+        assert(channels_.find(fd) == channel);
         assert(index == kAdded);
         if (channel->isNoneEvent()) {
             update(EPOLL_CTL_DEL, channel);
@@ -107,13 +125,11 @@ void EPollPoller::removeChannel(Channel *channel) {
     Poller::assertInLoopThread();
     int fd = channel->fd();
     LOG_TRACE << Fmt("fd = {}", fd);
-    assert(channels_.find(fd) != channels_.end());
-    assert(channels_[fd] == channel);
+    assert(channels_.find(fd) == channel);
     assert(channel->isNoneEvent());
     int index = channel->index();
     assert(index == kAdded || index == kDeleted);
-    size_t n = channels_.erase(fd);
-    assert(n == 1);
+    channels_.erase(fd);
     if (index == kAdded) {
         update(EPOLL_CTL_DEL, channel);
     }
@@ -123,6 +139,9 @@ void EPollPoller::removeChannel(Channel *channel) {
 void EPollPoller::update(int operation, Channel *channel) {
     struct epoll_event event{};
     event.events = channel->events();
+    if (channel->edgeTriggered()) {
+        event.events |= EPOLLET | EPOLLRDHUP;
+    }
     event.data.ptr = channel;
     int fd = channel->fd();
     LOG_TRACE << Fmt("epoll_ctl op = {} fd = {} event = {{{}}}",
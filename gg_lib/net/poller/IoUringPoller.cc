@@ -0,0 +1,411 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#include "gg_lib/net/poller/IoUringPoller.h"
+#include "gg_lib/net/Channel.h"
+#include "gg_lib/Logging.h"
+
+#include <assert.h>
+#include <algorithm>
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+using namespace gg_lib;
+using namespace gg_lib::net;
+
+constexpr int IoUringPoller::kMaxSendIovec;
+
+namespace {
+    constexpr int kNew = -1;
+    constexpr int kAdded = 1;
+
+    // completions of POLL_REMOVE and ASYNC_CANCEL requests carry this tag and are dropped.
+    constexpr uint64_t kIgnoredUserData = 0;
+    // user data of poll requests is fd << 32 | seq, operations set the top bit
+    // and keep slot generation and index in the rest.
+    constexpr uint64_t kOperationTag = 1ULL << 63;
+
+    int ioUringSetup(unsigned entries, struct io_uring_params *params) {
+        return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+    }
+
+    int ioUringEnter(int ringFd, unsigned toSubmit, unsigned minComplete,
+                     unsigned flags, const void *arg, size_t argSize) {
+        return static_cast<int>(::syscall(__NR_io_uring_enter, ringFd, toSubmit,
+                                          minComplete, flags, arg, argSize));
+    }
+
+    bool hasRequiredFeatures(const struct io_uring_params &params) {
+        return (params.features & IORING_FEAT_NODROP) && (params.features & IORING_FEAT_EXT_ARG);
+    }
+
+    int createRing(struct io_uring_params *params, unsigned sqEntries, unsigned cqEntries) {
+        bzero(params, sizeof *params);
+        params->flags = IORING_SETUP_CQSIZE | IORING_SETUP_CLAMP;
+        params->cq_entries = cqEntries;
+        return ioUringSetup(sqEntries, params);
+    }
+
+    void *mapRing(int ringFd, size_t size, off_t offset) {
+        void *ptr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                           MAP_SHARED | MAP_POPULATE, ringFd, offset);
+        if (ptr == MAP_FAILED) {
+            LOG_SYSFATAL << "IoUringPoller mmap";
+        }
+        return ptr;
+    }
+
+    template<typename T>
+    T *ringField(void *ring, unsigned offset) {
+        return reinterpret_cast<T *>(static_cast<char *>(ring) + offset);
+    }
+}
+
+IoUringPoller::IoUringPoller(EventLoop *loop)
+        : Poller(loop),
+          ringFd_(-1),
+          nextSeq_(0),
+          sqeTail_(0) {
+    struct io_uring_params params{};
+    ringFd_ = createRing(&params, kSubmissionEntries, kCompletionEntries);
+    if (ringFd_ < 0) {
+        LOG_SYSFATAL << "IoUringPoller::IoUringPoller";
+    }
+    if (!hasRequiredFeatures(params)) {
+        LOG_FATAL << "IoUringPoller::IoUringPoller kernel lacks NODROP or EXT_ARG";
+    }
+    sqRingSize_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cqRingSize_ = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    bool singleMmap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (singleMmap) {
+        sqRingSize_ = cqRingSize_ = std::max(sqRingSize_, cqRingSize_);
+    }
+    sqRing_ = mapRing(ringFd_, sqRingSize_, IORING_OFF_SQ_RING);
+    cqRing_ = singleMmap ? sqRing_ : mapRing(ringFd_, cqRingSize_, IORING_OFF_CQ_RING);
+
+    sqHead_ = ringField<unsigned>(sqRing_, params.sq_off.head);
+    sqTail_ = ringField<unsigned>(sqRing_, params.sq_off.tail);
+    sqMask_ = *ringField<unsigned>(sqRing_, params.sq_off.ring_mask);
+    sqEntries_ = *ringField<unsigned>(sqRing_, params.sq_off.ring_entries);
+    sqArray_ = ringField<unsigned>(sqRing_, params.sq_off.array);
+    sqes_ = static_cast<io_uring_sqe *>(
+            mapRing(ringFd_, sqEntries_ * sizeof(struct io_uring_sqe), IORING_OFF_SQES));
+    sqeTail_ = *sqTail_;
+
+    cqHead_ = ringField<unsigned>(cqRing_, params.cq_off.head);
+    cqTail_ = ringField<unsigned>(cqRing_, params.cq_off.tail);
+    cqMask_ = *ringField<unsigned>(cqRing_, params.cq_off.ring_mask);
+    cqes_ = ringField<io_uring_cqe>(cqRing_, params.cq_off.cqes);
+    LOG_DEBUG << Fmt("IoUringPoller sq entries = {} cq entries = {}",
+                     sqEntries_, params.cq_entries);
+}
+
+IoUringPoller::~IoUringPoller() {
+    // closing the ring cancels operations in flight, their callbacks are
+    // destroyed with operations_ afterwards.
+    ::munmap(sqes_, sqEntries_ * sizeof(struct io_uring_sqe));
+    if (cqRing_ != sqRing_) {
+        ::munmap(cqRing_, cqRingSize_);
+    }
+    ::munmap(sqRing_, sqRingSize_);
+    ::close(ringFd_);
+}
+
+bool IoUringPoller::isSupported() {
+    static const bool supported = [] {
+        struct io_uring_params params{};
+        int fd = createRing(&params, 2, 4);
+        if (fd < 0) {
+            return false;
+        }
+        ::close(fd);
+        return hasRequiredFeatures(params);
+    }();
+    return supported;
+}
+
+Timestamp IoUringPoller::poll(int timeoutMs, Poller::ChannelList *activeChannels) {
+    LOG_TRACE << Fmt("fd total count {}", channels_.size());
+    flushInterest();
+    int ret = enter(pendingSubmissions(), timeoutMs);
+    int savedErrno = errno;
+    Timestamp now(Timestamp::now());
+    if (ret < 0 && savedErrno != ETIME && savedErrno != EINTR && savedErrno != EBUSY) {
+        errno = savedErrno;
+        LOG_SYSERR << "IoUringPoller::poll()";
+    }
+    size_t before = activeChannels->size();
+    fillActiveChannels(activeChannels);
+    if (activeChannels->size() > before) {
+        LOG_TRACE << Fmt("{}  events happened", activeChannels->size() - before);
+    } else {
+        LOG_TRACE << "nothing happened";
+    }
+    return now;
+}
+
+void IoUringPoller::updateChannel(Channel *channel) {
+    Poller::assertInLoopThread();
+    const int index = channel->index();
+    const int fd = channel->fd();
+    LOG_TRACE << Fmt("fd = {} events = {} index = {}", fd, channel->events(), index);
+    if (index == kNew) {
+        assert(!channels_.contains(fd));
+        channels_.insert(fd, channel);
+        channel->set_index(kAdded);
+        PollState &state = pollStates_[fd];
+        state.armedUserData = kIgnoredUserData;
+        state.armedEvents = 0;
+        state.dirty = false;
+        markDirty(fd, &state);
+    } else {
+        assert(index == kAdded);
+        assert(channels_.find(fd) == channel);
+        markDirty(fd, &pollStates_[fd]);
+    }
+}
+
+void IoUringPoller::removeChannel(Channel *channel) {
+    Poller::assertInLoopThread();
+    int fd = channel->fd();
+    LOG_TRACE << Fmt("fd = {}", fd);
+    assert(channels_.find(fd) == channel);
+    assert(channel->isNoneEvent());
+    assert(channel->index() == kAdded);
+    channels_.erase(fd);
+    auto it = pollStates_.find(fd);
+    assert(it != pollStates_.end());
+    if (it->second.armedUserData != kIgnoredUserData) {
+        prepPollRemove(it->second.armedUserData);
+    }
+    pollStates_.erase(it);
+    channel->set_index(kNew);
+}
+
+void IoUringPoller::markDirty(int fd, PollState *state) {
+    if (!state->dirty) {
+        state->dirty = true;
+        dirtyFds_.push_back(fd);
+    }
+}
+
+void IoUringPoller::flushInterest() {
+    for (int fd: dirtyFds_) {
+        auto it = pollStates_.find(fd);
+        // the channel may have been removed after it was marked.
+        if (it == pollStates_.end() || !it->second.dirty) {
+            continue;
+        }
+        PollState &state = it->second;
+        state.dirty = false;
+        Channel *channel = channels_.find(fd);
+        int events = channel->events();
+        if (state.armedUserData != kIgnoredUserData) {
+            if (state.armedEvents == events) {
+                continue;
+            }
+            prepPollRemove(state.armedUserData);
+            state.armedUserData = kIgnoredUserData;
+        }
+        if (events != 0) {
+            if (++nextSeq_ == 0) {
+                ++nextSeq_;
+            }
+            uint64_t userData = (static_cast<uint64_t>(fd) << 32) | nextSeq_;
+            prepPollAdd(fd, events, userData);
+            state.armedUserData = userData;
+            state.armedEvents = events;
+        }
+    }
+    dirtyFds_.clear();
+}
+
+void IoUringPoller::fillActiveChannels(Poller::ChannelList *activeChannels) {
+    unsigned head = *cqHead_;
+    unsigned tail = __atomic_load_n(cqTail_, __ATOMIC_ACQUIRE);
+    for (; head != tail; ++head) {
+        const struct io_uring_cqe &cqe = cqes_[head & cqMask_];
+        uint64_t userData = cqe.user_data;
+        if (userData == kIgnoredUserData) {
+            continue;
+        }
+        if (userData & kOperationTag) {
+            completeOperation(userData, cqe.res);
+            continue;
+        }
+        int fd = static_cast<int>(userData >> 32);
+        auto it = pollStates_.find(fd);
+        // stale completion of a request which has been replaced or removed.
+        if (it == pollStates_.end() || it->second.armedUserData != userData) {
+            continue;
+        }
+        PollState &state = it->second;
+        state.armedUserData = kIgnoredUserData;
+        // one-shot request, re-arm it while the channel is still interested.
+        markDirty(fd, &state);
+        if (cqe.res == -ECANCELED) {
+            continue;
+        }
+        Channel *channel = channels_.find(fd);
+        assert(channel != nullptr);
+        int revents = cqe.res;
+        if (cqe.res < 0) {
+            LOG_ERROR << Fmt("IoUringPoller poll fd = {} error = {}", fd, strerror_tr(-cqe.res));
+            revents = POLLERR;
+        }
+        // interest may have shrunk after this request was armed.
+        revents &= channel->events() | POLLERR | POLLHUP | POLLNVAL;
+        if (revents == 0) {
+            continue;
+        }
+        channel->set_revents(revents);
+        activeChannels->push_back(channel);
+    }
+    __atomic_store_n(cqHead_, head, __ATOMIC_RELEASE);
+}
+
+io_uring_sqe *IoUringPoller::getSqe() {
+    if (sqeTail_ - __atomic_load_n(sqHead_, __ATOMIC_ACQUIRE) >= sqEntries_) {
+        // submission ring is full, hand it to kernel without waiting.
+        if (enter(pendingSubmissions(), 0) < 0) {
+            LOG_SYSFATAL << "IoUringPoller::getSqe";
+        }
+    }
+    unsigned index = sqeTail_ & sqMask_;
+    struct io_uring_sqe *sqe = &sqes_[index];
+    bzero(sqe, sizeof *sqe);
+    sqArray_[index] = index;
+    ++sqeTail_;
+    return sqe;
+}
+
+void IoUringPoller::prepPollAdd(int fd, int events, uint64_t userData) {
+    struct io_uring_sqe *sqe = getSqe();
+    sqe->opcode = IORING_OP_POLL_ADD;
+    sqe->fd = fd;
+    sqe->poll32_events = static_cast<uint32_t>(events);
+    sqe->user_data = userData;
+}
+
+void IoUringPoller::prepPollRemove(uint64_t userData) {
+    struct io_uring_sqe *sqe = getSqe();
+    sqe->opcode = IORING_OP_POLL_REMOVE;
+    sqe->fd = -1;
+    sqe->addr = userData;
+    sqe->user_data = kIgnoredUserData;
+}
+
+unsigned IoUringPoller::pendingSubmissions() const {
+    return sqeTail_ - __atomic_load_n(sqHead_, __ATOMIC_ACQUIRE);
+}
+
+int IoUringPoller::enter(unsigned toSubmit, int timeoutMs) {
+    __atomic_store_n(sqTail_, sqeTail_, __ATOMIC_RELEASE);
+    if (timeoutMs == 0) {
+        return toSubmit > 0 ? ioUringEnter(ringFd_, toSubmit, 0, 0, nullptr, 0) : 0;
+    }
+    struct __kernel_timespec ts{};
+    struct io_uring_getevents_arg arg{};
+    arg.sigmask = 0;
+    arg.sigmask_sz = _NSIG / 8;
+    if (timeoutMs > 0) {
+        ts.tv_sec = timeoutMs / 1000;
+        ts.tv_nsec = (timeoutMs % 1000) * 1000 * 1000;
+        arg.ts = reinterpret_cast<uint64_t>(&ts);
+    }
+    return ioUringEnter(ringFd_, toSubmit, 1,
+                        IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg, sizeof arg);
+}
+
+uint64_t IoUringPoller::submitRecv(int fd, void *buf, size_t len, IoCompletionCallback cb) {
+    Poller::assertInLoopThread();
+    uint64_t userData = addOperation(std::move(cb));
+    struct io_uring_sqe *sqe = getSqe();
+    sqe->opcode = IORING_OP_RECV;
+    sqe->fd = fd;
+    sqe->addr = reinterpret_cast<uint64_t>(buf);
+    sqe->len = static_cast<uint32_t>(len);
+    sqe->user_data = userData;
+    return userData;
+}
+
+uint64_t IoUringPoller::submitSend(int fd, const struct iovec *iov, int iovcnt, IoCompletionCallback cb) {
+    Poller::assertInLoopThread();
+    uint64_t userData = addOperation(std::move(cb));
+    Operation &op = operations_[static_cast<uint32_t>(userData)];
+    if (!op.message) {
+        op.message.reset(new SendMessage);
+    }
+    // a short send is reported like send(2) does, the caller submits the rest.
+    iovcnt = std::min(iovcnt, kMaxSendIovec);
+    std::copy(iov, iov + iovcnt, op.message->iov);
+    struct msghdr &header = op.message->header;
+    header = msghdr();
+    header.msg_iov = op.message->iov;
+    header.msg_iovlen = static_cast<size_t>(iovcnt);
+    struct io_uring_sqe *sqe = getSqe();
+    sqe->opcode = IORING_OP_SENDMSG;
+    sqe->fd = fd;
+    sqe->addr = reinterpret_cast<uint64_t>(&header);
+    sqe->len = 1;
+    sqe->msg_flags = MSG_NOSIGNAL;
+    sqe->user_data = userData;
+    return userData;
+}
+
+void IoUringPoller::cancelOperation(uint64_t operationId) {
+    Poller::assertInLoopThread();
+    assert(operationId & kOperationTag);
+    struct io_uring_sqe *sqe = getSqe();
+    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    sqe->fd = -1;
+    sqe->addr = operationId;
+    sqe->user_data = kIgnoredUserData;
+}
+
+void IoUringPoller::dispatchCompletions() {
+    if (completions_.empty()) {
+        return;
+    }
+    std::vector<std::pair<IoCompletionCallback, int>> completions;
+    completions.swap(completions_);
+    for (auto &completion: completions) {
+        completion.first(completion.second);
+    }
+    // keep the capacity for the next round.
+    completions.clear();
+    if (completions_.empty()) {
+        completions_.swap(completions);
+    }
+}
+
+uint64_t IoUringPoller::addOperation(IoCompletionCallback cb) {
+    uint32_t index;
+    if (freeOperations_.empty()) {
+        index = static_cast<uint32_t>(operations_.size());
+        operations_.push_back(Operation{IoCompletionCallback(), 0, nullptr});
+    } else {
+        index = freeOperations_.back();
+        freeOperations_.pop_back();
+    }
+    Operation &op = operations_[index];
+    op.callback = std::move(cb);
+    ++op.generation;
+    return kOperationTag | (static_cast<uint64_t>(op.generation & 0x7fffffff) << 32) | index;
+}
+
+void IoUringPoller::completeOperation(uint64_t userData, int result) {
+    auto index = static_cast<uint32_t>(userData);
+    assert(index < operations_.size());
+    Operation &op = operations_[index];
+    assert(((userData >> 32) & 0x7fffffff) == (op.generation & 0x7fffffff));
+    completions_.emplace_back(std::move(op.callback), result);
+    op.callback = IoCompletionCallback();
+    freeOperations_.push_back(index);
+}
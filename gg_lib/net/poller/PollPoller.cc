@@ -37,7 +37,7 @@ void PollPoller::updateChannel(Channel *channel) {
     Poller::assertInLoopThread();
     LOG_TRACE << Fmt("fd = {} events = {}", channel->fd(), channel->events());
     if (channel->index() < 0) {
-        assert(channels_.find(channel->fd()) == channels_.end());
+        assert(!channels_.contains(channel->fd()));
         struct pollfd pfd;
         pfd.fd = channel->fd();
         pfd.events = static_cast<short>(channel->events());
@@ -45,10 +45,9 @@ void PollPoller::updateChannel(Channel *channel) {
         pollfds_.push_back(pfd);
         int idx = static_cast<int>(pollfds_.size()) - 1;
         channel->set_index(idx);
-        channels_[pfd.fd] = channel;
+        channels_.insert(pfd.fd, channel);
     } else {
-        assert(channels_.find(channel->fd()) != channels_.end());
-        assert(channels_[channel->fd()] == channel);
+        assert(channels_.find(channel->fd()) == channel);
         int idx = channel->index();
         assert(0 <= idx && idx < static_cast<int>(pollfds_.size()));
         struct pollfd &pfd = pollfds_[idx];
@@ -66,23 +65,21 @@ void PollPoller::removeChannel(Channel *channel) {
     Poller::assertInLoopThread();
     LOG_TRACE << Fmt("fd = {}", channel->fd());
 
-    assert(channels_.find(channel->fd()) != channels_.end());
-    assert(channels_[channel->fd()] == channel);
+    assert(channels_.find(channel->fd()) == channel);
     assert(channel->isNoneEvent());
 
     int idx = channel->index();
     assert(0 <= idx && idx < static_cast<int>(pollfds_.size()));
     const struct pollfd &pfd = pollfds_[idx];
     assert(pfd.fd == -channel->fd() - 1 && pfd.events == channel->events());
-    size_t n = channels_.erase(channel->fd());
-    assert(n == 1);
+    channels_.erase(channel->fd());
     if (idx != pollfds_.size() - 1) {
         int channelAtEnd = pollfds_.back().fd;
         iter_swap(pollfds_.begin() + idx, pollfds_.end() - 1);
         if (channelAtEnd < 0) {
             channelAtEnd = -channelAtEnd - 1;
         }
-        channels_[channelAtEnd]->set_index(idx);
+        channels_.find(channelAtEnd)->set_index(idx);
     }
     pollfds_.pop_back();
 }
@@ -91,9 +88,8 @@ void PollPoller::fillActiveChannels(int numEvents, Poller::ChannelList *activeCh
     for (auto pfd = pollfds_.begin(); pfd != pollfds_.end() && numEvents > 0; ++pfd) {
         if (pfd->revents > 0) {
             --numEvents;
-            ChannelMap::const_iterator ch = channels_.find(pfd->fd);
-            assert(ch != channels_.end());
-            Channel *channel = ch->second;
+            Channel *channel = channels_.find(pfd->fd);
+            assert(channel != nullptr);
             assert(channel->fd() == pfd->fd);
             channel->set_revents(pfd->revents);
             activeChannels->push_back(channel);
@@ -0,0 +1,114 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#include "gg_lib/net/timer/HeapTimerQueue.h"
+#include "gg_lib/net/Timer.h"
+#include "gg_lib/net/EventLoop.h"
+
+using namespace gg_lib;
+using namespace gg_lib::net;
+
+HeapTimerQueue::HeapTimerQueue(EventLoop *loop)
+        : TimerQueue(loop),
+          timers_() {}
+
+HeapTimerQueue::~HeapTimerQueue() = default;
+
+TimerId HeapTimerQueue::addTimer(TimerCallback cb,
+                                 Timestamp when,
+                                 double interval) {
+    auto timer = new Timer(std::move(cb), when, interval);
+    TimerId timerId = timer->sequence();
+    loop_->runInLoop(
+            std::bind(&HeapTimerQueue::addTimerInLoop, this, timer));
+    return timerId;
+}
+
+void HeapTimerQueue::cancel(TimerId timerId) {
+    loop_->runInLoop(
+            std::bind(&HeapTimerQueue::cancelInLoop, this, timerId));
+}
+
+void HeapTimerQueue::addTimerInLoop(Timer *rawTimer) {
+    loop_->assertInLoopThread();
+    auto timer = std::unique_ptr<Timer>(rawTimer);
+    auto expiration = timer->expiration();
+    bool earliestChanged = insert(timer);
+    if (earliestChanged) {
+        resetTimerfd(expiration);
+    }
+}
+
+void HeapTimerQueue::cancelInLoop(TimerId timerId) {
+    loop_->assertInLoopThread();
+    activeTimers_.erase(timerId);
+}
+
+void HeapTimerQueue::handleExpired(Timestamp now) {
+    std::vector<Timer*> expired = getExpired(now);
+    for (auto ptr: expired) {
+        ptr->run();
+    }
+    reset(expired, now);
+}
+
+std::vector<Timer*> HeapTimerQueue::getExpired(Timestamp now) {
+    std::vector<Timer*> expired;
+    while (!timers_.empty()) {
+        const auto& entry = timers_.top();
+        if (entry.first <= now) {
+            auto iter = activeTimers_.find(entry.second);
+            if (iter != activeTimers_.end()) {
+                expired.push_back(iter->second.get());
+            }
+            timers_.pop();
+        } else {
+            break;
+        }
+    }
+    return expired;
+}
+
+void HeapTimerQueue::reset(const std::vector<Timer*> &expired, Timestamp now) {
+    Timestamp nextExpire;
+    for (auto timer: expired) {
+        TimerId timerId = timer->sequence();
+        // repeat timer may be deleted in its callback.
+        if (timer->repeat() && activeTimers_.find(timerId) != activeTimers_.end()) {
+            timer->restart(now);
+            Timestamp when = timer->expiration();
+            timers_.emplace(when, timerId);
+        } else {
+            activeTimers_.erase(timerId);
+        }
+    }
+    while (!timers_.empty()) {
+        const auto& entry = timers_.top();
+        auto iter = activeTimers_.find(entry.second);
+        if (iter == activeTimers_.end()) {
+            timers_.pop();
+        } else {
+            nextExpire = entry.first;
+            break;
+        }
+    }
+
+    if (nextExpire.valid()) {
+        resetTimerfd(nextExpire);
+    }
+}
+
+bool HeapTimerQueue::insert(HeapTimerQueue::TimerPtr &timer) {
+    loop_->assertInLoopThread();
+    bool earliestChanged = false;
+    Timestamp when = timer->expiration();
+    if (timers_.empty() || when < timers_.top().first) {
+        earliestChanged = true;
+    }
+    TimerId timerId = timer->sequence();
+    timers_.emplace(when, timerId);
+    if (activeTimers_.find(timerId) == activeTimers_.end()) {
+        activeTimers_.emplace(timerId, std::move(timer));
+    }
+    return earliestChanged;
+}
@@ -0,0 +1,290 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#include "gg_lib/net/timer/WheelTimerQueue.h"
+#include "gg_lib/net/EventLoop.h"
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+
+using namespace gg_lib;
+using namespace gg_lib::net;
+
+constexpr int WheelTimerQueue::kLevelBits;
+constexpr int WheelTimerQueue::kSlots;
+constexpr int WheelTimerQueue::kLevels;
+
+static_assert(WheelTimerQueue::kSlots == 64, "a level is tracked by one uint64_t bitmap");
+
+namespace {
+    constexpr int kNil = -1;
+    // list of a node whose callback is running.
+    constexpr int kRunning = -2;
+    // list of a node in the free list.
+    constexpr int kFree = -3;
+
+    constexpr int64_t kMicroSecondsPerTick = 1000;
+    constexpr int64_t kNoTick = std::numeric_limits<int64_t>::max();
+    constexpr TimerId kProvisionalBit = 1ULL << 63;
+    constexpr uint32_t kGenerationMask = 0x7fffffff;
+
+    /// Rounds up, so a timer never runs before its expiration.
+    int64_t toTick(Timestamp when) {
+        return (when.microSecondsSinceEpoch() + kMicroSecondsPerTick - 1) / kMicroSecondsPerTick;
+    }
+}
+
+struct WheelTimerQueue::Node {
+    Node()
+            : expiration(0),
+              interval(0.0),
+              provisionalId(0),
+              generation(0),
+              prev(kNil),
+              next(kNil),
+              list(kFree),
+              cancelled(false) {}
+
+    TimerCallback callback;
+    // in ticks
+    int64_t expiration;
+    double interval;
+    TimerId provisionalId;
+    uint32_t generation;
+    // slot lists are circular, the head's prev is the tail.
+    int prev;
+    int next;
+    int list;
+    // cancelled while its callback runs.
+    bool cancelled;
+};
+
+WheelTimerQueue::WheelTimerQueue(EventLoop *loop)
+        : TimerQueue(loop),
+          freeNodes_(kNil),
+          occupied_(),
+          currentTick_(toTick(Timestamp::now())),
+          armedTick_(kNoTick),
+          callingExpiredTimers_(false),
+          nextProvisionalId_(0) {
+    std::fill(std::begin(slots_), std::end(slots_), kNil);
+}
+
+WheelTimerQueue::~WheelTimerQueue() = default;
+
+TimerId WheelTimerQueue::addTimer(TimerCallback cb,
+                                  Timestamp when,
+                                  double interval) {
+    if (loop_->isInLoopThread()) {
+        return addTimerInLoop(std::move(cb), when, interval);
+    }
+    TimerId provisionalId = kProvisionalBit | nextProvisionalId_.fetch_add(1);
+    loop_->queueInLoop(std::bind(&WheelTimerQueue::addProvisionalTimer, this,
+                                 std::move(cb), when, interval, provisionalId));
+    return provisionalId;
+}
+
+void WheelTimerQueue::cancel(TimerId timerId) {
+    if (loop_->isInLoopThread()) {
+        cancelInLoop(timerId);
+    } else {
+        loop_->queueInLoop(
+                std::bind(&WheelTimerQueue::cancelInLoop, this, timerId));
+    }
+}
+
+TimerId WheelTimerQueue::addTimerInLoop(TimerCallback cb, Timestamp when, double interval) {
+    loop_->assertInLoopThread();
+    // an empty wheel may not have been advanced for long, a delay measured
+    // from there would land in a far level and cascade for nothing.
+    if (!callingExpiredTimers_ && std::all_of(std::begin(occupied_), std::end(occupied_), [](uint64_t bits) { return bits == 0; })) {
+        currentTick_ = std::max(currentTick_, Timestamp::now().microSecondsSinceEpoch() / kMicroSecondsPerTick);
+    }
+    const int index = newNode();
+    Node &node = nodes_[index];
+    node.callback = std::move(cb);
+    node.expiration = toTick(when);
+    node.interval = interval;
+    rearm(place(index, currentTick_ + 1));
+    return static_cast<TimerId>(node.generation) << 32 | static_cast<uint32_t>(index);
+}
+
+void WheelTimerQueue::addProvisionalTimer(TimerCallback &cb, Timestamp when,
+                                          double interval, TimerId provisionalId) {
+    TimerId timerId = addTimerInLoop(std::move(cb), when, interval);
+    nodes_[static_cast<uint32_t>(timerId)].provisionalId = provisionalId;
+    provisionalIds_.emplace(provisionalId, timerId);
+}
+
+void WheelTimerQueue::cancelInLoop(TimerId timerId) {
+    loop_->assertInLoopThread();
+    if (timerId & kProvisionalBit) {
+        auto iter = provisionalIds_.find(timerId);
+        if (iter == provisionalIds_.end()) {
+            return;
+        }
+        timerId = iter->second;
+    }
+    const auto index = static_cast<uint32_t>(timerId);
+    if (index >= nodes_.size()) {
+        return;
+    }
+    Node &node = nodes_[index];
+    if (node.generation != (timerId >> 32) || node.list == kFree) {
+        return;
+    }
+    if (node.list == kRunning) {
+        node.cancelled = true;
+    } else {
+        unlink(static_cast<int>(index));
+        freeNode(static_cast<int>(index));
+    }
+}
+
+void WheelTimerQueue::handleExpired(Timestamp now) {
+    const int64_t nowTick = now.microSecondsSinceEpoch() / kMicroSecondsPerTick;
+    int64_t tick;
+    callingExpiredTimers_ = true;
+    while ((tick = nextTick()) <= nowTick) {
+        currentTick_ = tick;
+        // higher levels first, their timers may move down to a slot reached right now.
+        for (int level = kLevels - 1; level > 0; --level) {
+            if ((tick & ((int64_t(1) << (kLevelBits * level)) - 1)) == 0) {
+                cascade(level);
+            }
+        }
+        runSlot(now);
+    }
+    callingExpiredTimers_ = false;
+    currentTick_ = std::max(currentTick_, nowTick);
+    armedTick_ = kNoTick;
+    rearm(nextTick());
+}
+
+int64_t WheelTimerQueue::place(int index, int64_t minTick) {
+    Node &node = nodes_[index];
+    int64_t tick = std::max(node.expiration, minTick);
+    const int64_t delta = tick - currentTick_;
+    int level = 0;
+    while (level < kLevels - 1 && (delta >> (kLevelBits * (level + 1))) != 0) {
+        ++level;
+    }
+    if ((delta >> (kLevelBits * kLevels)) != 0) {
+        // beyond the wheel, wait in the farthest slot and place it again from there.
+        tick = currentTick_ + (int64_t(1) << (kLevelBits * kLevels)) - 1;
+    }
+    const int shift = kLevelBits * level;
+    link(index, level * kSlots + static_cast<int>((tick >> shift) & (kSlots - 1)));
+    return tick >> shift << shift;
+}
+
+void WheelTimerQueue::cascade(int level) {
+    const int slot = static_cast<int>((currentTick_ >> (kLevelBits * level)) & (kSlots - 1));
+    int &head = slots_[level * kSlots + slot];
+    while (head != kNil) {
+        const int index = head;
+        unlink(index);
+        // expiring right now goes to the level 0 slot run after the cascades.
+        place(index, currentTick_);
+    }
+}
+
+void WheelTimerQueue::runSlot(Timestamp now) {
+    int &head = slots_[currentTick_ & (kSlots - 1)];
+    while (head != kNil) {
+        const int index = head;
+        unlink(index);
+        Node &node = nodes_[index];
+        node.list = kRunning;
+        node.callback();
+        if (node.interval > 0.0 && !node.cancelled) {
+            node.expiration = toTick(Timestamp::addTime(now, node.interval));
+            place(index, currentTick_ + 1);
+        } else {
+            freeNode(index);
+        }
+    }
+}
+
+int64_t WheelTimerQueue::nextTick() const {
+    int64_t next = kNoTick;
+    for (int level = 0; level < kLevels; ++level) {
+        const uint64_t bits = occupied_[level];
+        if (bits == 0) {
+            continue;
+        }
+        // slots are reached in order from the one after the current, wrapping around.
+        const int shift = kLevelBits * level;
+        const int64_t current = currentTick_ >> shift;
+        const int start = static_cast<int>((current + 1) & (kSlots - 1));
+        const uint64_t rotated = (bits >> start) | (bits << ((kSlots - start) & (kSlots - 1)));
+        const int64_t tick = (current + 1 + __builtin_ctzll(rotated)) << shift;
+        next = std::min(next, tick);
+    }
+    return next;
+}
+
+void WheelTimerQueue::rearm(int64_t tick) {
+    if (tick < armedTick_) {
+        armedTick_ = tick;
+        resetTimerfd(Timestamp(tick * kMicroSecondsPerTick));
+    }
+}
+
+int WheelTimerQueue::newNode() {
+    if (freeNodes_ != kNil) {
+        const int index = freeNodes_;
+        freeNodes_ = nodes_[index].next;
+        nodes_[index].cancelled = false;
+        return index;
+    }
+    nodes_.emplace_back();
+    return static_cast<int>(nodes_.size() - 1);
+}
+
+void WheelTimerQueue::freeNode(int index) {
+    Node &node = nodes_[index];
+    node.callback = nullptr;
+    if (node.provisionalId) {
+        provisionalIds_.erase(node.provisionalId);
+        node.provisionalId = 0;
+    }
+    node.generation = (node.generation + 1) & kGenerationMask;
+    node.list = kFree;
+    node.next = freeNodes_;
+    freeNodes_ = index;
+}
+
+void WheelTimerQueue::link(int index, int list) {
+    Node &node = nodes_[index];
+    node.list = list;
+    int &head = slots_[list];
+    if (head == kNil) {
+        node.prev = node.next = index;
+        head = index;
+        occupied_[list / kSlots] |= 1ULL << (list % kSlots);
+    } else {
+        Node &first = nodes_[head];
+        node.prev = first.prev;
+        node.next = head;
+        nodes_[first.prev].next = index;
+        first.prev = index;
+    }
+}
+
+void WheelTimerQueue::unlink(int index) {
+    Node &node = nodes_[index];
+    int &head = slots_[node.list];
+    if (node.next == index) {
+        head = kNil;
+        occupied_[node.list / kSlots] &= ~(1ULL << (node.list % kSlots));
+    } else {
+        nodes_[node.prev].next = node.next;
+        nodes_[node.next].prev = node.prev;
+        if (head == index) {
+            head = node.next;
+        }
+    }
+    node.prev = node.next = kNil;
+}
@@ -0,0 +1,70 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#ifndef GG_LIB_CPUAFFINITY_H
+#define GG_LIB_CPUAFFINITY_H
+
+#include "gg_lib/copyable.h"
+#include "gg_lib/Utils.h"
+
+#include <vector>
+
+namespace gg_lib {
+    ///
+    /// @brief Where the i-th thread of a pool runs.
+    ///
+    /// A thread pinned within one NUMA node also prefers memory of that node,
+    /// so what it allocates, e.g. the buffers of a loop, is local.
+    /// The topology comes from /sys/devices/system.
+    ///
+    class CpuAffinity : public copyable {
+    public:
+        enum Policy {
+            /// Threads float freely, the default.
+            kFloating,
+            /// Thread i runs on cpus[i % cpus.size()].
+            kCpuList,
+            /// Thread i runs on the first hardware thread of physical core i % cores.
+            kPerCore,
+            /// Thread i runs on any CPU of NUMA node i % nodes.
+            kSpreadNodes,
+        };
+
+        CpuAffinity() : policy_(kFloating) {}
+
+        static CpuAffinity cpuList(std::vector<int> cpus);
+
+        static CpuAffinity perCore();
+
+        static CpuAffinity spreadNodes();
+
+        Policy policy() const { return policy_; }
+
+        /// CPUs the index-th thread may run on, empty if it floats.
+        std::vector<int> cpusOf(int index) const;
+
+        /// Pins the calling thread as the index-th thread, returns false if it fails.
+        bool applyToCurrentThread(int index) const;
+
+        /// Parses the "0-3,8,10-11" format of sysfs.
+        static std::vector<int> parseCpuList(const string &list);
+
+        static std::vector<int> onlineCpus();
+
+        /// The hardware threads of each physical core, by package and core id.
+        static std::vector<std::vector<int>> physicalCores();
+
+        /// The CPUs of each NUMA node with CPUs, a single node if the kernel has no NUMA.
+        static std::vector<std::vector<int>> numaNodes();
+
+    private:
+        CpuAffinity(Policy policy, std::vector<int> cpus)
+                : policy_(policy), cpus_(std::move(cpus)) {}
+
+        Policy policy_;
+        // kCpuList only.
+        std::vector<int> cpus_;
+    };
+}
+
+#endif //GG_LIB_CPUAFFINITY_H
@@ -0,0 +1,97 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#ifndef GG_LIB_MPSCQUEUE_H
+#define GG_LIB_MPSCQUEUE_H
+
+#include <atomic>
+
+#include "gg_lib/noncopyable.h"
+
+namespace gg_lib {
+    /// Link of a node queued in MpscQueue, nodes derive from it.
+    struct MpscNode {
+        MpscNode() : mpscNext(nullptr) {}
+
+        std::atomic<MpscNode *> mpscNext;
+    };
+
+    /// Default Hooks of MpscQueue. Tests replace it to push from the consumer
+    /// where a producer may interleave.
+    struct MpscNoHooks {
+        template<typename Queue>
+        static void beforeStubPush(Queue &) {}
+    };
+
+    ///
+    /// @brief Intrusive multi-producer single-consumer queue, after Dmitry Vyukov's.
+    ///
+    /// push() is wait-free, one atomic exchange. pop() is lock-free but a producer
+    /// preempted inside push() hides the nodes queued after its own until it
+    /// resumes, pop() returns nullptr meanwhile. The queue never owns the nodes.
+    ///
+    template<typename T, typename Hooks = MpscNoHooks>
+    class MpscQueue : noncopyable {
+    public:
+        MpscQueue() : head_(&stub_), tail_(&stub_) {}
+
+        /// Thread safe.
+        void push(T *node) {
+            pushNode(node);
+        }
+
+        /// Whether pop() has nothing to return, nodes a producer is still linking
+        /// count as not queued yet. head_ can't tell, the stub pushed by pop() may
+        /// be queued behind nodes. Must be called by the consumer.
+        bool empty() const {
+            return tail_ == &stub_ && !stub_.mpscNext.load(std::memory_order_acquire);
+        }
+
+        /// Must be called by the consumer.
+        T *pop() {
+            MpscNode *tail = tail_;
+            MpscNode *next = tail->mpscNext.load(std::memory_order_acquire);
+            if (tail == &stub_) {
+                if (!next) {
+                    return nullptr;
+                }
+                tail_ = next;
+                tail = next;
+                next = next->mpscNext.load(std::memory_order_acquire);
+            }
+            if (next) {
+                tail_ = next;
+                return static_cast<T *>(tail);
+            }
+            if (tail != head_.load(std::memory_order_acquire)) {
+                // a producer has taken head_ but not linked its node yet.
+                return nullptr;
+            }
+            // tail is the only node, the stub keeps the queue non-empty once it is taken.
+            Hooks::beforeStubPush(*this);
+            pushNode(&stub_);
+            next = tail->mpscNext.load(std::memory_order_acquire);
+            if (next) {
+                tail_ = next;
+                return static_cast<T *>(tail);
+            }
+            return nullptr;
+        }
+
+    private:
+        void pushNode(MpscNode *node) {
+            node->mpscNext.store(nullptr, std::memory_order_relaxed);
+            MpscNode *prev = head_.exchange(node, std::memory_order_acq_rel);
+            prev->mpscNext.store(node, std::memory_order_release);
+        }
+
+        MpscNode stub_;
+        // producers queue after head_, the consumer takes from tail_.
+        std::atomic<MpscNode *> head_;
+        // keeps tail_ off the cache line producers write.
+        char padding_[64];
+        MpscNode *tail_;
+    };
+}
+
+#endif //GG_LIB_MPSCQUEUE_H
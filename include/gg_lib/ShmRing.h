@@ -0,0 +1,97 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#ifndef GG_LIB_SHMRING_H
+#define GG_LIB_SHMRING_H
+
+#include "gg_lib/noncopyable.h"
+#include "gg_lib/Utils.h"
+
+#include <atomic>
+#include <memory>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace gg_lib {
+    ///
+    /// @brief A single-producer single-consumer byte ring in POSIX shared memory,
+    /// mapped by a producer and a consumer which may live in different processes.
+    ///
+    /// The data pages are mapped twice in a row, so the readable and the writable
+    /// bytes are always contiguous however they wrap. Each side caches the index of
+    /// the other and reloads it only when the ring looks full or empty, so the cache
+    /// lines bounce once per batch rather than once per message. Whether the consumer
+    /// must be woken is decided here, signalling it is left to the caller, see
+    /// net::ShmRingReader and net::ShmRingWriter.
+    ///
+    class ShmRing : noncopyable {
+    public:
+        /// Creates name, e.g. "/feed", under /dev/shm with capacity rounded up to a power
+        /// of two of at least a page, failing if it exists. null on error.
+        static std::unique_ptr<ShmRing> create(StringArg name, size_t capacity);
+
+        /// Maps the ring another process created. null on error.
+        static std::unique_ptr<ShmRing> open(StringArg name);
+
+        /// Removes name, the rings mapped stay usable.
+        static void unlink(StringArg name);
+
+        ~ShmRing();
+
+        size_t capacity() const { return capacity_; }
+
+        // for the producer.
+
+        /// Loads the index of the consumer.
+        size_t writableBytes();
+
+        /// writableBytes() contiguous bytes.
+        char *beginWrite() { return data_ + (writeIndex_ & (capacity_ - 1)); }
+
+        /// Publishes len bytes written at beginWrite(). Returns true if the consumer
+        /// waits for them and must be woken, which it then is only once.
+        bool hasWritten(size_t len);
+
+        /// false if there is no room for len bytes, otherwise see hasWritten().
+        bool append(const void *data, size_t len, bool *wake);
+
+        // for the consumer.
+
+        /// Loads the index of the producer once the bytes seen before are retrieved.
+        size_t readableBytes();
+
+        /// readableBytes() contiguous bytes.
+        const char *peek() const { return data_ + (readIndex_ & (capacity_ - 1)); }
+
+        /// Frees len bytes for the producer.
+        void retrieve(size_t len);
+
+        /// Announces the consumer is about to sleep until woken. Returns false if
+        /// bytes arrived meanwhile, it must read them instead.
+        bool prepareWait();
+
+        /// The consumer is awake, the producer stops waking it.
+        void cancelWait();
+
+    private:
+        struct Header;
+
+        ShmRing(Header *header, char *mapping, size_t mappingSize);
+
+        static std::unique_ptr<ShmRing> map(int fd, size_t capacity);
+
+        Header *const header_;
+        char *const data_;
+        char *const mapping_;
+        const size_t mappingSize_;
+        const size_t capacity_;
+        // the producer's view of writeIndex and the latest readIndex it loaded.
+        uint64_t writeIndex_;
+        uint64_t cachedReadIndex_;
+        // the consumer's view of readIndex and the latest writeIndex it loaded.
+        uint64_t readIndex_;
+        uint64_t cachedWriteIndex_;
+    };
+}
+
+#endif //GG_LIB_SHMRING_H
@@ -0,0 +1,94 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#ifndef GG_LIB_SLABPOOL_H
+#define GG_LIB_SLABPOOL_H
+
+#include "gg_lib/MpscQueue.h"
+#include "gg_lib/noncopyable.h"
+
+#include <stddef.h>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace gg_lib {
+    ///
+    /// @brief Blocks of one size carved from slabs, for objects created at a high rate.
+    ///
+    /// The first allocation fixes the block size, larger requests go to operator new.
+    /// allocate() must be called by one thread, deallocate() by any: freed blocks are
+    /// queued on an MpscQueue and reused by the allocating thread. Slabs are only
+    /// released with the pool.
+    ///
+    class SlabPool : noncopyable {
+    public:
+        explicit SlabPool(size_t blocksPerSlab = 64);
+
+        ~SlabPool();
+
+        void *allocate(size_t size);
+
+        /// Thread safe, size must be the one passed to allocate().
+        void deallocate(void *p, size_t size);
+
+        /// 0 until the first allocation.
+        size_t blockSize() const { return blockSize_; }
+
+        /// Must be called by the allocating thread.
+        size_t numSlabs() const { return slabs_.size(); }
+
+    private:
+        struct FreeBlock : MpscNode {
+        };
+
+        void addSlab();
+
+        const size_t blocksPerSlab_;
+        // written by the first allocate(), before any block can be freed.
+        size_t blockSize_;
+        MpscQueue<FreeBlock> freeBlocks_;
+        // the part of the last slab never handed out.
+        char *carve_;
+        char *carveEnd_;
+        std::vector<std::unique_ptr<char[]>> slabs_;
+    };
+
+    /// Allocator for std::allocate_shared, control block and object come from one block.
+    template<typename T>
+    class SlabAllocator {
+    public:
+        typedef T value_type;
+
+        explicit SlabAllocator(std::shared_ptr<SlabPool> pool) : pool_(std::move(pool)) {}
+
+        template<typename U>
+        SlabAllocator(const SlabAllocator<U> &rhs) : pool_(rhs.pool()) {}
+
+        T *allocate(size_t n) {
+            static_assert(alignof(T) <= alignof(max_align_t), "over-aligned type");
+            return static_cast<T *>(pool_->allocate(n * sizeof(T)));
+        }
+
+        void deallocate(T *p, size_t n) {
+            pool_->deallocate(p, n * sizeof(T));
+        }
+
+        const std::shared_ptr<SlabPool> &pool() const { return pool_; }
+
+    private:
+        std::shared_ptr<SlabPool> pool_;
+    };
+
+    template<typename T, typename U>
+    bool operator==(const SlabAllocator<T> &lhs, const SlabAllocator<U> &rhs) {
+        return lhs.pool() == rhs.pool();
+    }
+
+    template<typename T, typename U>
+    bool operator!=(const SlabAllocator<T> &lhs, const SlabAllocator<U> &rhs) {
+        return !(lhs == rhs);
+    }
+}
+
+#endif //GG_LIB_SLABPOOL_H
@@ -0,0 +1,129 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#ifndef GG_LIB_SLOTMAP_H
+#define GG_LIB_SLOTMAP_H
+
+#include "gg_lib/noncopyable.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <utility>
+#include <vector>
+
+namespace gg_lib {
+    ///
+    /// @brief Values in a flat vector, addressed by keys which go stale when they are erased.
+    ///
+    /// A key holds the slot index in its low 32 bits and the generation of the slot in the
+    /// next 24, the generation is bumped when the slot is freed, so the key of an erased
+    /// value finds nothing even after the slot is reused. The top 8 bits are a tag given
+    /// by the owner, e.g. to tell which of several maps a key comes from.
+    /// insert(), find() and erase() are O(1).
+    ///
+    template<typename T>
+    class SlotMap : noncopyable {
+    public:
+        typedef uint64_t Key;
+
+        static constexpr int kTagShift = 56;
+
+        explicit SlotMap(uint8_t tag = 0)
+                : tag_(static_cast<Key>(tag) << kTagShift),
+                  freeHead_(kNoSlot),
+                  size_(0) {}
+
+        static uint8_t tagOf(Key key) { return static_cast<uint8_t>(key >> kTagShift); }
+
+        Key insert(T value) {
+            uint32_t index;
+            if (freeHead_ != kNoSlot) {
+                index = freeHead_;
+                freeHead_ = slots_[index].nextFree;
+            } else {
+                index = static_cast<uint32_t>(slots_.size());
+                slots_.emplace_back();
+            }
+            Slot &slot = slots_[index];
+            slot.occupied = true;
+            slot.value = std::move(value);
+            ++size_;
+            return tag_ | (static_cast<Key>(slot.generation) << kGenerationShift) | index;
+        }
+
+        /// nullptr if key is stale or from another map.
+        T *find(Key key) {
+            uint32_t index = static_cast<uint32_t>(key);
+            if ((key & kTagMask) != tag_ || index >= slots_.size()) {
+                return nullptr;
+            }
+            Slot &slot = slots_[index];
+            if (!slot.occupied || slot.generation != generationOf(key)) {
+                return nullptr;
+            }
+            return &slot.value;
+        }
+
+        /// false if key is stale or from another map.
+        bool erase(Key key) {
+            if (!find(key)) {
+                return false;
+            }
+            uint32_t index = static_cast<uint32_t>(key);
+            Slot &slot = slots_[index];
+            slot.occupied = false;
+            slot.value = T();
+            slot.generation = (slot.generation + 1) & kGenerationMask;
+            slot.nextFree = freeHead_;
+            freeHead_ = index;
+            --size_;
+            return true;
+        }
+
+        template<typename F>
+        void forEach(F f) {
+            for (Slot &slot: slots_) {
+                if (slot.occupied) {
+                    f(slot.value);
+                }
+            }
+        }
+
+        void clear() {
+            for (uint32_t i = 0; i < slots_.size(); ++i) {
+                Key key = tag_ | (static_cast<Key>(slots_[i].generation) << kGenerationShift) | i;
+                erase(key);
+            }
+        }
+
+        size_t size() const { return size_; }
+
+        bool empty() const { return size_ == 0; }
+
+    private:
+        static constexpr int kGenerationShift = 32;
+        static constexpr uint32_t kGenerationMask = (1u << (kTagShift - kGenerationShift)) - 1;
+        static constexpr Key kTagMask = ~Key(0) << kTagShift;
+        static constexpr uint32_t kNoSlot = ~uint32_t(0);
+
+        static uint32_t generationOf(Key key) {
+            return static_cast<uint32_t>(key >> kGenerationShift) & kGenerationMask;
+        }
+
+        struct Slot {
+            Slot() : generation(0), nextFree(kNoSlot), occupied(false), value() {}
+
+            uint32_t generation;
+            uint32_t nextFree;
+            bool occupied;
+            T value;
+        };
+
+        const Key tag_;
+        std::vector<Slot> slots_;
+        uint32_t freeHead_;
+        size_t size_;
+    };
+}
+
+#endif //GG_LIB_SLOTMAP_H
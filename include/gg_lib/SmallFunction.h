@@ -0,0 +1,188 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#ifndef GG_LIB_SMALLFUNCTION_H
+#define GG_LIB_SMALLFUNCTION_H
+
+#include <stddef.h>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace gg_lib {
+    /// Enough for a bound member function with a shared_ptr and a string or a Buffer.
+    constexpr size_t kSmallFunctionInlineSize = 80;
+
+    template<typename Signature, size_t InlineSize = kSmallFunctionInlineSize>
+    class SmallFunction;
+
+    ///
+    /// @brief Move-only std::function with a larger inline buffer.
+    ///
+    /// Targets of at most InlineSize bytes whose move constructor doesn't throw
+    /// are stored inline, larger ones on the heap. Being move-only, it also
+    /// takes targets holding move-only state, e.g. a bound ChainBuffer.
+    ///
+    template<typename R, typename... Args, size_t InlineSize>
+    class SmallFunction<R(Args...), InlineSize> {
+    public:
+        SmallFunction() noexcept : invoker_(nullptr), manager_(nullptr) {}
+
+        SmallFunction(std::nullptr_t) noexcept : SmallFunction() {}
+
+        template<typename F, typename = typename std::enable_if<
+                !std::is_same<typename std::decay<F>::type, SmallFunction>::value>::type>
+        SmallFunction(F &&f) : SmallFunction() {
+            init(std::forward<F>(f));
+        }
+
+        SmallFunction(SmallFunction &&rhs) noexcept : SmallFunction() {
+            moveFrom(rhs);
+        }
+
+        SmallFunction &operator=(SmallFunction &&rhs) noexcept {
+            if (this != &rhs) {
+                reset();
+                moveFrom(rhs);
+            }
+            return *this;
+        }
+
+        SmallFunction &operator=(std::nullptr_t) noexcept {
+            reset();
+            return *this;
+        }
+
+        template<typename F, typename = typename std::enable_if<
+                !std::is_same<typename std::decay<F>::type, SmallFunction>::value>::type>
+        SmallFunction &operator=(F &&f) {
+            SmallFunction(std::forward<F>(f)).swap(*this);
+            return *this;
+        }
+
+        SmallFunction(const SmallFunction &) = delete;
+
+        SmallFunction &operator=(const SmallFunction &) = delete;
+
+        ~SmallFunction() { reset(); }
+
+        void swap(SmallFunction &rhs) noexcept {
+            SmallFunction tmp(std::move(rhs));
+            rhs = std::move(*this);
+            *this = std::move(tmp);
+        }
+
+        explicit operator bool() const noexcept { return invoker_ != nullptr; }
+
+        /// Like std::function, the target is called as non-const.
+        R operator()(Args... args) const {
+            return invoker_(const_cast<Storage *>(&storage_), std::forward<Args>(args)...);
+        }
+
+    private:
+        union Storage {
+            typename std::aligned_storage<InlineSize, alignof(max_align_t)>::type buf;
+            void *ptr;
+        };
+
+        enum Operation {
+            kMove, kDestroy
+        };
+
+        typedef R (*Invoker)(Storage *, Args &&...);
+
+        typedef void (*Manager)(Operation, Storage *dst, Storage *src);
+
+        template<typename F>
+        struct Inline {
+            static F *target(Storage *s) { return reinterpret_cast<F *>(&s->buf); }
+
+            static R invoke(Storage *s, Args &&... args) {
+                return (*target(s))(std::forward<Args>(args)...);
+            }
+
+            static void manage(Operation op, Storage *dst, Storage *src) {
+                if (op == kMove) {
+                    new(&dst->buf) F(std::move(*target(src)));
+                }
+                target(src)->~F();
+            }
+        };
+
+        template<typename F>
+        struct Allocated {
+            static F *target(Storage *s) { return static_cast<F *>(s->ptr); }
+
+            static R invoke(Storage *s, Args &&... args) {
+                return (*target(s))(std::forward<Args>(args)...);
+            }
+
+            static void manage(Operation op, Storage *dst, Storage *src) {
+                if (op == kMove) {
+                    dst->ptr = src->ptr;
+                } else {
+                    delete target(src);
+                }
+            }
+        };
+
+        template<typename F>
+        static bool isNull(const F &) { return false; }
+
+        template<typename Ret, typename... Params>
+        static bool isNull(Ret (*const &f)(Params...)) { return f == nullptr; }
+
+        template<typename Sig>
+        static bool isNull(const std::function<Sig> &f) { return !f; }
+
+        template<typename F>
+        void init(F &&f) {
+            typedef typename std::decay<F>::type Target;
+            if (isNull(f)) {
+                return;
+            }
+            init<Target>(std::forward<F>(f), std::integral_constant<bool,
+                    sizeof(Target) <= InlineSize && alignof(Target) <= alignof(max_align_t) &&
+                    std::is_nothrow_move_constructible<Target>::value>());
+        }
+
+        template<typename Target, typename F>
+        void init(F &&f, std::true_type) {
+            new(&storage_.buf) Target(std::forward<F>(f));
+            invoker_ = &Inline<Target>::invoke;
+            manager_ = &Inline<Target>::manage;
+        }
+
+        template<typename Target, typename F>
+        void init(F &&f, std::false_type) {
+            storage_.ptr = new Target(std::forward<F>(f));
+            invoker_ = &Allocated<Target>::invoke;
+            manager_ = &Allocated<Target>::manage;
+        }
+
+        void moveFrom(SmallFunction &rhs) noexcept {
+            if (rhs.manager_) {
+                rhs.manager_(kMove, &storage_, &rhs.storage_);
+                invoker_ = rhs.invoker_;
+                manager_ = rhs.manager_;
+                rhs.invoker_ = nullptr;
+                rhs.manager_ = nullptr;
+            }
+        }
+
+        void reset() noexcept {
+            if (manager_) {
+                manager_(kDestroy, nullptr, &storage_);
+                invoker_ = nullptr;
+                manager_ = nullptr;
+            }
+        }
+
+        Storage storage_;
+        Invoker invoker_;
+        Manager manager_;
+    };
+}
+
+#endif //GG_LIB_SMALLFUNCTION_H
@@ -4,6 +4,7 @@
 #ifndef GG_LIB_THREADPOOL_H
 #define GG_LIB_THREADPOOL_H
 
+#include "gg_lib/CpuAffinity.h"
 #include "gg_lib/ThreadHelper.h"
 #include <deque>
 #include <vector>
@@ -18,7 +19,8 @@ namespace gg_lib {
         void setMaxQueueSize(int maxSize) { maxQueueSize_ = maxSize; }
         void setThreadInitCallback(const Task& cb) { threadInitCallback_ = cb; }
 
-        void start(int numThreads);
+        /// The i-th thread is pinned by affinity before the init callback.
+        void start(int numThreads, const CpuAffinity &affinity = CpuAffinity());
         void stop();
 
         const string& name() const { return name_; }
@@ -45,7 +47,7 @@ namespace gg_lib {
 
     private:
         bool isFull() const;
-        void runInThread();
+        void runInThread(int index);
         Task take();
 
         mutable std::mutex mutex_;
@@ -53,6 +55,7 @@ namespace gg_lib {
         std::condition_variable notFull_;
         string name_;
         Task threadInitCallback_;
+        CpuAffinity affinity_;
         std::vector<std::unique_ptr<Thread> > threads_;
         std::deque<Task> queue_;
         size_t maxQueueSize_;
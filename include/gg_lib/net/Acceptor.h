@@ -17,7 +17,12 @@ namespace gg_lib {
         public:
             typedef std::function<void(int sockfd, const InetAddress &)> NewConnectionCallback;
 
-            Acceptor(EventLoop *loop, const InetAddress &listenAddr, bool reuseport = true);
+            /// An AF_UNIX path left behind by a server which is gone is removed before
+            /// binding, and the path is removed again by the destructor. socketType is
+            /// SOCK_STREAM, or SOCK_SEQPACKET for AF_UNIX. The listening socket has
+            /// SO_KEEPALIVE on, accepted sockets inherit it.
+            Acceptor(EventLoop *loop, const InetAddress &listenAddr, bool reuseport = true,
+                     int socketType = SOCK_STREAM);
 
             ~Acceptor();
 
@@ -27,10 +32,26 @@ namespace gg_lib {
 
             bool listening() const { return listening_; }
 
+            /// See Socket::setDeferAccept, handshakes which bring no data don't wake the loop.
+            bool setDeferAccept(int seconds) const { return acceptSocket_.setDeferAccept(seconds); }
+
+            /// See Socket::setFastOpen.
+            bool setFastOpen(int queueLength) const { return acceptSocket_.setFastOpen(queueLength); }
+
+            /// Accepted sockets inherit it, so connections need no setsockopt of their own.
+            void setTcpNoDelay(bool on) const { acceptSocket_.setTcpNoDelay(on); }
+
+            /// See Socket::attachReusePortCpuSteering.
+            bool attachReusePortCpuSteering(int groupSize) const {
+                return acceptSocket_.attachReusePortCpuSteering(groupSize);
+            }
+
         private:
             void handleRead();
 
             EventLoop *loop_;
+            // empty unless bound to an AF_UNIX path in the file system.
+            const string unixPath_;
             Socket acceptSocket_;
             Channel acceptChannel_;
             NewConnectionCallback newConnectionCallback_;
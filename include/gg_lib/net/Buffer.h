@@ -15,8 +15,15 @@ namespace gg_lib {
         public:
             static constexpr size_t kCheapPrepend = 8;
             static constexpr size_t kInitialSize = 1024;
+            /// readFd() reads this much more than fits into a stack buffer.
+            static constexpr size_t kExtraReadSize = 65536;
             static constexpr char kCRLF[] = "\r\n";
 
+            struct LazyTag {
+            };
+            /// Selects the constructor of a buffer without storage.
+            static constexpr LazyTag kLazy{};
+
             explicit Buffer(size_t initialSize = kInitialSize)
                     : buffer_(kCheapPrepend + initialSize),
                       readerIndex_(kCheapPrepend),
@@ -26,6 +33,12 @@ namespace gg_lib {
                 assert(prependableBytes() == kCheapPrepend);
             }
 
+            /// Holds no memory until the first write, which takes the storage from
+            /// a per-thread pool, see release().
+            explicit Buffer(LazyTag)
+                    : readerIndex_(0),
+                      writerIndex_(0) {}
+
             void swap(Buffer &rhs) {
                 buffer_.swap(rhs.buffer_);
                 std::swap(readerIndex_, rhs.readerIndex_);
@@ -82,8 +95,9 @@ namespace gg_lib {
             void retrieveInt8() { retrieve(sizeof(int8_t)); }
 
             void retrieveAll() {
-                readerIndex_ = kCheapPrepend;
-                writerIndex_ = kCheapPrepend;
+                // a buffer without storage has no prepend space either.
+                readerIndex_ = buffer_.empty() ? 0 : kCheapPrepend;
+                writerIndex_ = readerIndex_;
             }
 
             string retrieveAllAsString() { return retrieveAsString(readableBytes()); }
@@ -247,8 +261,26 @@ namespace gg_lib {
                 return buffer_.capacity();
             }
 
+            bool hasStorage() const { return !buffer_.empty(); }
+
+            /// Hands the storage of an empty buffer back to the pool of the calling
+            /// thread, storage grown large is freed instead. The next write takes
+            /// storage from the pool again, nothing can be prepended before it.
+            void release();
+
+            /// Most bytes the next readFd() can take at least, a shorter read drained fd.
+            size_t readFdCapacity() const {
+                // storage taken by readFd() holds kInitialSize at least.
+                const size_t writable = hasStorage() ? writableBytes() : kInitialSize;
+                return writable < kExtraReadSize ? writable + kExtraReadSize : writable;
+            }
+
+            /// A buffer without storage takes it from the pool first, the kernel writes into it.
             ssize_t readFd(int fd, int *savedErrno) {
-                char extrabuf[65536];
+                if (!hasStorage()) {
+                    acquire(0);
+                }
+                char extrabuf[kExtraReadSize];
                 struct iovec vec[2];
                 const size_t writable = writableBytes();
                 vec[0].iov_base = begin() + writerIndex_;
@@ -259,16 +291,17 @@ namespace gg_lib {
                 const ssize_t n = sockets::readv(fd, vec, iovcnt);
                 if (n < 0) {
                     *savedErrno = errno;
-                } else if (static_cast<size_t>(n) <= writable) {
-                    writerIndex_ += n;
                 } else {
-                    writerIndex_ = buffer_.size();
-                    append(extrabuf, n - writable);
+                    hasRead(static_cast<size_t>(n), writable, extrabuf);
                 }
                 /// Don't loop read here, cause peer may send lots of data which can crash program.
                 return n;
             }
 
+            /// Like readFd(), for AF_UNIX sockets, the descriptors passed with the bytes
+            /// are appended to fds, close-on-exec. The caller owns them.
+            ssize_t readFdWithFds(int fd, std::vector<int> *fds, int *savedErrno);
+
             /// Only for debug use.
             void reset() {
                 readerIndex_ = kCheapPrepend;
@@ -277,11 +310,25 @@ namespace gg_lib {
             }
 
         private:
+            /// n bytes were read into the writable bytes and then extrabuf.
+            void hasRead(size_t n, size_t writable, const char *extrabuf) {
+                if (n <= writable) {
+                    writerIndex_ += n;
+                } else {
+                    writerIndex_ = buffer_.size();
+                    append(extrabuf, n - writable);
+                }
+            }
+
             char *begin() { return buffer_.data(); }
 
             const char *begin() const { return buffer_.data(); }
 
             void makeSpace(size_t len) {
+                if (buffer_.empty()) {
+                    acquire(len);
+                    return;
+                }
                 if (writableBytes() + prependableBytes() < len + kCheapPrepend) {
                     buffer_.resize(writerIndex_ + len);
                 }
@@ -298,6 +345,9 @@ namespace gg_lib {
 
             }
 
+            /// Takes storage for at least len bytes from the pool.
+            void acquire(size_t len);
+
             std::vector<char> buffer_;
             size_t readerIndex_;
             size_t writerIndex_;
@@ -0,0 +1,117 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#ifndef GG_LIB_CHAINBUFFER_H
+#define GG_LIB_CHAINBUFFER_H
+
+#include "gg_lib/noncopyable.h"
+#include "gg_lib/Utils.h"
+
+#include <sys/uio.h>
+#include <memory>
+
+namespace gg_lib {
+    namespace net {
+        class Buffer;
+
+        ///
+        /// @brief Byte queue made of fixed-size blocks.
+        ///
+        /// Blocks come from a per-thread pool. Appending never moves or reallocates
+        /// the bytes already queued, so a large pending payload costs no memcpy
+        /// except the one that put it here, and readFd()/writeFd() hand the blocks
+        /// to the kernel directly as iovecs. An empty ChainBuffer holds no block.
+        ///
+        /// Bytes owned elsewhere can be queued as slices without being copied,
+        /// so a response can be gathered from a header and a separately owned body.
+        ///
+        class ChainBuffer : noncopyable {
+        public:
+            /// Size of one block including its header.
+            static constexpr size_t kBlockSize = 16 * 1024;
+            /// Most iovecs handed to the kernel by one call.
+            static constexpr int kMaxIovec = 64;
+            /// Shorter slices are copied, a slice node costs more than that.
+            static constexpr size_t kMinSliceSize = 512;
+
+            ChainBuffer() : head_(nullptr), tail_(nullptr), readable_(0) {}
+
+            ChainBuffer(ChainBuffer &&rhs) noexcept;
+
+            ChainBuffer &operator=(ChainBuffer &&rhs) noexcept;
+
+            ~ChainBuffer() { retrieveAll(); }
+
+            void swap(ChainBuffer &rhs) noexcept;
+
+            size_t readableBytes() const { return readable_; }
+
+            /// Start of the first contiguous readable segment.
+            const char *peek() const;
+
+            /// Length of the segment returned by peek(), may be less than readableBytes().
+            size_t peekableBytes() const;
+
+            void retrieve(size_t len);
+
+            /// Like retrieve(len), but blocks used up are moved to keep instead of
+            /// being freed, e.g. while a zero-copy send still reads from them.
+            /// keep only holds the blocks, its readable bytes don't change.
+            void retrieve(size_t len, ChainBuffer *keep);
+
+            void retrieveAll();
+
+            string retrieveAllAsString() { return retrieveAsString(readable_); }
+
+            string retrieveAsString(size_t len);
+
+            void append(const string_view &str) {
+                append(str.data(), str.size());
+            }
+
+            void append(const char *data, size_t len);
+
+            void append(const void *data, size_t len) {
+                append(static_cast<const char *>(data), len);
+            }
+
+            /// Queues data without copying it, owner keeps it alive until it is retrieved.
+            void appendSlice(const string_view &data, std::shared_ptr<const void> owner);
+
+            /// Queues the readable bytes of buffer without copying them, buffer is left empty.
+            void append(Buffer &&buffer);
+
+            /// Moves all blocks of other to the end of this one.
+            void append(ChainBuffer &&other);
+
+            /// Describe at most maxIovec readable segments in order,
+            /// return the number of iovecs filled.
+            int fillIovec(struct iovec *iov, int maxIovec) const;
+
+            ssize_t readFd(int fd, int *savedErrno);
+
+            ssize_t writeFd(int fd, int *savedErrno);
+
+            size_t numBlocks() const;
+
+        private:
+            struct Block;
+
+            struct SliceBlock;
+
+            static Block *newBlock();
+
+            static void freeBlock(Block *block);
+
+            Block *newTail();
+
+            void popHead();
+
+            Block *head_;
+            Block *tail_;
+            size_t readable_;
+        };
+    }
+}
+
+#endif //GG_LIB_CHAINBUFFER_H
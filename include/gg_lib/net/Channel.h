@@ -7,6 +7,7 @@
 #include "gg_lib/noncopyable.h"
 #include "gg_lib/Timestamp.h"
 
+#include <assert.h>
 #include <functional>
 #include <memory>
 #include <poll.h>
@@ -50,6 +51,14 @@ namespace gg_lib {
 
             void set_revents(int revt) { revents_ = revt; }
 
+            int revents() const { return revents_; }
+
+            /// Readiness is reported on edges only, and a peer shutdown as POLLRDHUP.
+            /// Honoured by pollers which support it, takes effect with the next update.
+            void setEdgeTriggered(bool on) { edgeTriggered_ = on; }
+
+            bool edgeTriggered() const { return edgeTriggered_; }
+
             bool isNoneEvent() const { return events_ == kNoneEvent; }
 
             void enableReading() {
@@ -94,6 +103,13 @@ namespace gg_lib {
 
             EventLoop* ownerLoop() { return loop_; }
 
+            /// Hands a channel which is not added to any loop over to loop.
+            void setOwnerLoop(EventLoop *loop) {
+                assert(!addedToLoop_);
+                loop_ = loop;
+                index_ = -1;
+            }
+
             void remove();
 
         private:
@@ -114,6 +130,7 @@ namespace gg_lib {
             int revents_;
             int index_;
             bool logHup_;
+            bool edgeTriggered_;
 
             std::weak_ptr<void> tie_;
             bool tied_;
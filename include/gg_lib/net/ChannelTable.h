@@ -0,0 +1,72 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#ifndef GG_LIB_CHANNELTABLE_H
+#define GG_LIB_CHANNELTABLE_H
+
+#include "gg_lib/noncopyable.h"
+
+#include <assert.h>
+#include <stddef.h>
+#include <vector>
+
+namespace gg_lib {
+    namespace net {
+        class Channel;
+
+        ///
+        /// @brief The channels of a Poller, indexed by fd.
+        ///
+        /// The kernel hands out the lowest free fd, so they stay small and dense and
+        /// a lookup is one bounds check and one load. The table grows by doubling
+        /// to the highest fd seen and never shrinks, null marks a free slot.
+        ///
+        class ChannelTable : noncopyable {
+        public:
+            ChannelTable() : size_(0) {}
+
+            /// nullptr if fd has no channel.
+            Channel *find(int fd) const {
+                return static_cast<size_t>(fd) < slots_.size() ? slots_[fd] : nullptr;
+            }
+
+            bool contains(int fd) const { return find(fd) != nullptr; }
+
+            void insert(int fd, Channel *channel) {
+                assert(fd >= 0 && channel != nullptr);
+                if (static_cast<size_t>(fd) >= slots_.size()) {
+                    grow(static_cast<size_t>(fd) + 1);
+                }
+                assert(slots_[fd] == nullptr);
+                slots_[fd] = channel;
+                ++size_;
+            }
+
+            void erase(int fd) {
+                assert(contains(fd));
+                slots_[fd] = nullptr;
+                --size_;
+            }
+
+            size_t size() const { return size_; }
+
+            bool empty() const { return size_ == 0; }
+
+        private:
+            static constexpr size_t kInitialSlots = 64;
+
+            void grow(size_t minSlots) {
+                size_t n = slots_.empty() ? kInitialSlots : slots_.size();
+                while (n < minSlots) {
+                    n *= 2;
+                }
+                slots_.resize(n, nullptr);
+            }
+
+            std::vector<Channel *> slots_;
+            size_t size_;
+        };
+    }
+}
+
+#endif //GG_LIB_CHANNELTABLE_H
@@ -0,0 +1,113 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#ifndef GG_LIB_CONNECTOR_H
+#define GG_LIB_CONNECTOR_H
+
+#include "gg_lib/net/NetUtils.h"
+#include "gg_lib/net/SocketsHelper.h"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+
+namespace gg_lib {
+    namespace net {
+        class Channel;
+
+        class EventLoop;
+
+        ///
+        /// @brief Connects a non-blocking socket to a server, retrying with backoff.
+        ///
+        /// A failed attempt is retried after the retry delay, which starts at the
+        /// initial delay and doubles up to the max delay with each retry. The
+        /// connected socket is handed to the new connection callback in the loop
+        /// thread, which then owns it.
+        ///
+        class Connector : noncopyable,
+                          public std::enable_shared_from_this<Connector> {
+        public:
+            typedef std::function<void(int sockfd)> NewConnectionCallback;
+            /// Called with the errno of the last attempt once the retries ran out.
+            typedef std::function<void(int savedErrno)> FailureCallback;
+
+            static constexpr double kDefaultInitRetryDelay = 0.5;
+            static constexpr double kDefaultMaxRetryDelay = 30.0;
+
+            Connector(EventLoop *loop, const InetAddress &serverAddr);
+
+            ~Connector();
+
+            void setNewConnectionCallback(const NewConnectionCallback &cb) { newConnectionCallback_ = cb; }
+
+            void setFailureCallback(const FailureCallback &cb) { failureCallback_ = cb; }
+
+            /// Must be called before start().
+            void setRetryDelay(double initDelay, double maxDelay);
+
+            /// Gives up after maxRetries failed retries, -1 retries forever, which is
+            /// the default. Must be called before start().
+            void setMaxRetries(int maxRetries) { maxRetries_ = maxRetries; }
+
+            /// SOCK_STREAM, which is the default, or SOCK_SEQPACKET for AF_UNIX.
+            /// Must be called before start().
+            void setSocketType(int socketType) { socketType_ = socketType; }
+
+            const InetAddress &serverAddress() const { return serverAddr_; }
+
+            /// Thread safe.
+            void start();
+
+            /// Starts over with the initial retry delay, must be called in the loop thread.
+            void restart();
+
+            /// Thread safe, cancels the attempt in progress and the pending retry.
+            void stop();
+
+        private:
+            enum States {
+                kDisconnected, kConnecting, kConnected
+            };
+
+            void startInLoop();
+
+            void stopInLoop();
+
+            void connect();
+
+            void connecting(int sockfd);
+
+            void handleWrite();
+
+            void handleError();
+
+            void retry(int sockfd, int savedErrno);
+
+            int removeAndResetChannel();
+
+            void resetChannel();
+
+            EventLoop *loop_;
+            const InetAddress serverAddr_;
+            int socketType_;
+            std::atomic<bool> connect_;
+            States state_;
+            std::unique_ptr<Channel> channel_;
+            NewConnectionCallback newConnectionCallback_;
+            FailureCallback failureCallback_;
+            double initRetryDelay_;
+            double maxRetryDelay_;
+            double retryDelay_;
+            int maxRetries_;
+            int retries_;
+            // valid while retryScheduled_, any id is.
+            TimerId retryTimer_;
+            bool retryScheduled_;
+        };
+
+        typedef std::shared_ptr<Connector> ConnectorPtr;
+    }
+}
+
+#endif //GG_LIB_CONNECTOR_H
@@ -5,12 +5,14 @@
 #define GG_LIB_EVENTLOOP_H
 
 #include "gg_lib/any.h"
+#include "gg_lib/MpscQueue.h"
 #include "gg_lib/noncopyable.h"
 #include "gg_lib/Timestamp.h"
 #include "gg_lib/ThreadHelper.h"
 #include "gg_lib/net/NetUtils.h"
 
-#include <mutex>
+#include <algorithm>
+#include <sys/uio.h>
 #include <vector>
 
 namespace gg_lib {
@@ -23,9 +25,18 @@ namespace gg_lib {
 
         class EventLoop : noncopyable {
         public:
-            typedef std::function<void()> Functor;
+            typedef SmallFunction<void()> Functor;
 
-            EventLoop();
+            /// Where the time of loop() went, see stats().
+            struct Stats {
+                /// Handling events, timers and functors.
+                int64_t busyMicroSeconds;
+                /// Polling without blocking and finding nothing, see setBusyPoll.
+                int64_t spinMicroSeconds;
+                int64_t emptySpins;
+            };
+
+            explicit EventLoop(TimerQueueType timerQueueType = kHeapTimerQueue);
 
             ~EventLoop();
 
@@ -39,6 +50,8 @@ namespace gg_lib {
 
             void runInLoop(Functor cb);
 
+            /// Thread safe and lock-free, a burst of calls from other threads
+            /// wakes up the loop once.
             void queueInLoop(Functor cb);
 
             TimerId runAt(Timestamp time, TimerCallback cb);
@@ -49,7 +62,35 @@ namespace gg_lib {
 
             void cancel(TimerId timerId);
 
+            /// TcpConnections constructed on this loop and not destroyed yet, thread safe.
+            int numConnections() const { return numConnections_.load(std::memory_order_relaxed); }
+
+            /// Functors queued and not run yet, thread safe.
+            int64_t numPendingFunctors() const {
+                return std::max<int64_t>(queuedFunctors_.load(std::memory_order_relaxed) -
+                                         ranFunctors_.load(std::memory_order_relaxed), 0);
+            }
+
+            /// Total time spent out of poll(2) handling events, timers and functors,
+            /// updated at the end of each iteration, thread safe.
+            int64_t busyMicroSeconds() const { return busyMicroSeconds_.load(std::memory_order_relaxed); }
+
+            /// Thread safe.
+            Stats stats() const;
+
+            /// @brief Keeps polling without blocking until nothing has happened for microSeconds,
+            /// then blocks as usual. While spinning, queueInLoop from other threads doesn't write
+            /// the eventfd either. Trades a core for wakeup latency, 0 turns it off,
+            /// which is the default. Thread safe.
+            void setBusyPoll(int64_t microSeconds) { busyPollMicroSeconds_.store(microSeconds); }
+
+            /// Kernel busy-polling of the device queues in a blocking poll, see Poller::setBusyPoll.
+            /// Must be called in the loop thread.
+            bool setKernelBusyPoll(int microSeconds, int budget = 8);
+
             // internal usage
+            void updateConnectionCount(int delta) { numConnections_.fetch_add(delta, std::memory_order_relaxed); }
+
             void wakeup() const;
 
             void updateChannel(Channel *channel);
@@ -58,6 +99,16 @@ namespace gg_lib {
 
             bool hasChannel(Channel *channel);
 
+            bool supportsCompletionIo() const;
+
+            bool supportsEdgeTriggered() const;
+
+            uint64_t submitRecv(int fd, void *buf, size_t len, IoCompletionCallback cb);
+
+            uint64_t submitSend(int fd, const struct iovec *iov, int iovcnt, IoCompletionCallback cb);
+
+            void cancelOperation(uint64_t operationId);
+
             void assertInLoopThread() {
                 if (!isInLoopThread()) {
                     abortNotInLoopThread();
@@ -79,6 +130,12 @@ namespace gg_lib {
             static EventLoop *getEventLoopOfCurrentThread();
 
         private:
+            struct PendingFunctor : MpscNode {
+                explicit PendingFunctor(Functor f) : functor(std::move(f)) {}
+
+                Functor functor;
+            };
+
             void abortNotInLoopThread();
 
             void handleRead() const;
@@ -92,6 +149,8 @@ namespace gg_lib {
             bool looping_;
             bool eventHandling_;
             bool callingPendingFunctors_;
+            // the current iteration polled without blocking.
+            bool spinning_;
 
             int64_t iteration_;
             const std::thread::id threadId_;
@@ -105,8 +164,18 @@ namespace gg_lib {
             ChannelList activeChannels_;
             Channel *currentActiveChannel_;
 
-            std::mutex mutex_;
-            std::vector<Functor> pendingFunctors_;
+            MpscQueue<PendingFunctor> pendingFunctors_;
+            // set by the first queueInLoop that writes wakeupFd_ until the queue is drained.
+            std::atomic<bool> wakeupPending_;
+
+            // load counters, read by other threads to place connections.
+            std::atomic<int> numConnections_;
+            std::atomic<int64_t> queuedFunctors_;
+            std::atomic<int64_t> ranFunctors_;
+            std::atomic<int64_t> busyMicroSeconds_;
+            std::atomic<int64_t> spinMicroSeconds_;
+            std::atomic<int64_t> emptySpins_;
+            std::atomic<int64_t> busyPollMicroSeconds_;
         };
     }
 }
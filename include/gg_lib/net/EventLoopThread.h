@@ -4,7 +4,9 @@
 #ifndef GG_LIB_EVENTLOOPTHREAD_H
 #define GG_LIB_EVENTLOOPTHREAD_H
 
+#include "gg_lib/CpuAffinity.h"
 #include "gg_lib/ThreadHelper.h"
+#include "gg_lib/net/NetUtils.h"
 
 namespace gg_lib {
     namespace net {
@@ -14,8 +16,13 @@ namespace gg_lib {
         public:
             typedef std::function<void(EventLoop *)> ThreadInitCallback;
 
+            /// The thread is pinned as the affinityIndex-th thread of affinity
+            /// before the loop is created.
             explicit EventLoopThread(ThreadInitCallback cb = ThreadInitCallback(),
-                            const string &name = string());
+                            const string &name = string(),
+                            TimerQueueType timerQueueType = kHeapTimerQueue,
+                            const CpuAffinity &affinity = CpuAffinity(),
+                            int affinityIndex = 0);
 
             ~EventLoopThread();
             EventLoop* startLoop();
@@ -29,6 +36,9 @@ namespace gg_lib {
             std::mutex mutex_;
             std::condition_variable cond_;
             ThreadInitCallback callback_;
+            const TimerQueueType timerQueueType_;
+            const CpuAffinity affinity_;
+            const int affinityIndex_;
         };
     }
 }
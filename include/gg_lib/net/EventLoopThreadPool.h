@@ -5,6 +5,7 @@
 #define GG_LIB_EVENTLOOPTHREADPOOL_H
 
 #include "gg_lib/net/NetUtils.h"
+#include "gg_lib/CpuAffinity.h"
 #include "gg_lib/noncopyable.h"
 
 #include <vector>
@@ -23,10 +24,22 @@ namespace gg_lib {
 
             ~EventLoopThreadPool();
 
-            void setThreadNum(int numThreads) { numThreads_ = numThreads; }
+            /// The i-th thread, named name-i, is pinned by affinity, see CpuAffinity.
+            void setThreadNum(int numThreads, const CpuAffinity &affinity = CpuAffinity()) {
+                numThreads_ = numThreads;
+                affinity_ = affinity;
+            }
+
+            /// Timers of the loops started later, the base loop is left alone.
+            void setTimerQueueType(TimerQueueType type) { timerQueueType_ = type; }
+
+            /// How getNextLoop() picks a loop, round-robin by default.
+            void setPlacementPolicy(LoopPlacementPolicy policy) { placementPolicy_ = policy; }
 
             void start(const ThreadInitCallback &cb = ThreadInitCallback());
 
+            /// Picks a loop by the placement policy, from the counters each loop
+            /// publishes without locking.
             EventLoop *getNextLoop();
 
             /// with the same hash code, it will always return the same EventLoop
@@ -34,18 +47,42 @@ namespace gg_lib {
 
             std::vector<EventLoop *> getAllLoops();
 
+            /// @brief Busy fraction of the index-th loop, smoothed over recent samples.
+            /// A loop is sampled at most once per kLoadSampleInterval, in between
+            /// the last score is returned.
+            double loadScore(size_t index);
+
             bool started() const { return started_; }
 
             const string &name() const { return name_; }
 
+            static constexpr int64_t kLoadSampleInterval = 10 * 1000;
+
         private:
+            struct LoadSample {
+                int64_t busyMicroSeconds;
+                int64_t time;
+                double score;
+            };
+
+            size_t leastConnectionsIndex() const;
+
+            size_t leastPendingFunctorsIndex() const;
+
+            size_t powerOfTwoChoicesIndex();
+
             EventLoop *baseLoop_;
             string name_;
             bool started_;
             int numThreads_;
             int next_;
+            TimerQueueType timerQueueType_;
+            CpuAffinity affinity_;
+            LoopPlacementPolicy placementPolicy_;
+            uint64_t randomState_;
             std::vector<std::unique_ptr<EventLoopThread>> threads_;
             std::vector<EventLoop *> loops_;
+            std::vector<LoadSample> loadSamples_;
         };
     }
 }
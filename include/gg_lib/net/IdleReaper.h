@@ -0,0 +1,67 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#ifndef GG_LIB_IDLEREAPER_H
+#define GG_LIB_IDLEREAPER_H
+
+#include "gg_lib/net/NetUtils.h"
+#include "gg_lib/noncopyable.h"
+
+#include <memory>
+#include <vector>
+
+namespace gg_lib {
+    namespace net {
+        class EventLoop;
+
+        ///
+        /// @brief Force closes the connections of one EventLoop idle for too long.
+        ///
+        /// Connections sit in time buckets by the tick their timeout may expire at,
+        /// a single timer sweeps one bucket per tick. Reads and writes only update
+        /// TcpConnection::lastActiveTime(), a swept connection that has been active
+        /// moves to the bucket of its new deadline instead of being closed.
+        /// So one timer serves all connections of the loop, and an idle connection
+        /// is closed at most timeout / kBucketsPerTimeout late.
+        ///
+        class IdleReaper : noncopyable,
+                           public std::enable_shared_from_this<IdleReaper> {
+        public:
+            static constexpr int kBucketsPerTimeout = 16;
+
+            IdleReaper(EventLoop *loop, double timeout);
+
+            double timeout() const { return timeout_; }
+
+            /// Starts the sweep timer, must be called in the loop thread.
+            void start();
+
+            /// Stops the sweep timer, must be called in the loop thread.
+            void stop();
+
+            /// Watches conn until it is closed, must be called in the loop thread.
+            void add(const TcpConnectionPtr &conn);
+
+        private:
+            typedef std::vector<std::weak_ptr<TcpConnection>> Bucket;
+
+            void sweep();
+
+            /// Returns the tick the timeout of a connection active at time ends.
+            int64_t deadlineTick(Timestamp time) const;
+
+            void insert(const TcpConnectionPtr &conn, int64_t tick);
+
+            EventLoop *loop_;
+            const double timeout_;
+            const int64_t tickMicroSeconds_;
+            std::vector<Bucket> buckets_;
+            // all buckets up to this tick have been swept.
+            int64_t sweptTick_;
+            TimerId timerId_;
+            bool started_;
+        };
+    }
+}
+
+#endif //GG_LIB_IDLEREAPER_H
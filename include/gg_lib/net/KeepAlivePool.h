@@ -0,0 +1,144 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#ifndef GG_LIB_KEEPALIVEPOOL_H
+#define GG_LIB_KEEPALIVEPOOL_H
+
+#include "gg_lib/net/Connector.h"
+#include "gg_lib/net/TcpConnection.h"
+
+#include "gg_lib/SlotMap.h"
+#include "gg_lib/noncopyable.h"
+
+#include <unordered_map>
+#include <vector>
+
+namespace gg_lib {
+    namespace net {
+        class EventLoop;
+
+        ///
+        /// @brief Outbound connections kept open for reuse, keyed by server address.
+        ///
+        /// acquire() hands out the most recently released idle connection to the
+        /// address, or connects a new one. The user sets its callbacks for the
+        /// exchange and gives it back with release(), which resets them, so a warm
+        /// connection serves many calls for one handshake. An idle connection is
+        /// closed when the server closes it, sends something, or stays idle longer
+        /// than the idle timeout.
+        ///
+        /// One pool serves the connections of one EventLoop, everything must be
+        /// called in its thread.
+        ///
+        class KeepAlivePool : noncopyable {
+        public:
+            /// Called with the connection, or null if connecting failed.
+            typedef std::function<void(const TcpConnectionPtr &)> AcquireCallback;
+
+            static constexpr size_t kDefaultMaxIdlePerAddress = 8;
+            static constexpr double kDefaultIdleTimeout = 60.0;
+
+            KeepAlivePool(EventLoop *loop, string nameArg);
+
+            /// Destroys all connections, also those acquired and not released.
+            ~KeepAlivePool();
+
+            EventLoop *getLoop() const { return loop_; }
+
+            const string &name() const { return name_; }
+
+            /// More connections released to one address are closed.
+            void setMaxIdlePerAddress(size_t maxIdle) { maxIdlePerAddress_ = maxIdle; }
+
+            /// 0 keeps idle connections until the server closes them, must be set before the first release().
+            void setIdleTimeout(double seconds) { idleTimeout_ = seconds; }
+
+            /// New connections retry failed connects maxRetries times, see Connector.
+            /// Not retried by default, a server which refuses fails the acquire().
+            void setConnectRetry(int maxRetries, double initDelay, double maxDelay);
+
+            /// cb may be called before acquire() returns.
+            void acquire(const InetAddress &serverAddr, AcquireCallback cb);
+
+            /// Gives back an acquired connection once its exchange is done. It is closed
+            /// instead if it holds unread input or unsent output, or too many are idle.
+            void release(const TcpConnectionPtr &conn);
+
+            size_t numConnections() const { return connections_.size(); }
+
+            size_t numIdle() const { return numIdle_; }
+
+            /// Connections established so far.
+            int64_t numConnects() const { return numConnects_; }
+
+            /// acquire() calls served by an idle connection so far.
+            int64_t numReuses() const { return numReuses_; }
+
+        private:
+            /// Family, port and address of an InetAddress, zero padded, plus the path of an AF_UNIX one.
+            struct AddressKey {
+                explicit AddressKey(const InetAddress &addr);
+
+                bool operator==(const AddressKey &rhs) const {
+                    return words[0] == rhs.words[0] && words[1] == rhs.words[1] && words[2] == rhs.words[2] &&
+                           path == rhs.path;
+                }
+
+                uint64_t words[3];
+                string path;
+            };
+
+            struct AddressKeyHash {
+                size_t operator()(const AddressKey &key) const;
+            };
+
+            struct IdleConnection {
+                TcpConnectionPtr conn;
+                Timestamp since;
+            };
+
+            // most recently released last.
+            typedef std::vector<IdleConnection> IdleList;
+
+            void connect(const InetAddress &serverAddr, AcquireCallback cb);
+
+            void newConnection(SlotMap<ConnectorPtr>::Key connectorKey, int sockfd, const AcquireCallback &cb);
+
+            void connectFailed(SlotMap<ConnectorPtr>::Key connectorKey, int savedErrno, const AcquireCallback &cb);
+
+            void removeConnection(const TcpConnectionPtr &conn);
+
+            /// Takes conn out of its idle list, false if it isn't idle.
+            bool removeIdle(const TcpConnectionPtr &conn);
+
+            void closeExpired();
+
+            bool expired(const IdleConnection &idle, Timestamp now) const {
+                return idleTimeout_ > 0 && Timestamp::timeDuration(now, idle.since) >= idleTimeout_;
+            }
+
+            EventLoop *loop_;
+            const string name_;
+            const std::shared_ptr<const string> namePrefix_;
+            // the callbacks of idle connections, release() restores them.
+            const std::shared_ptr<ConnectionCallbacks> idleCallbacks_;
+            size_t maxIdlePerAddress_;
+            double idleTimeout_;
+            int connectRetries_;
+            double connectInitDelay_;
+            double connectMaxDelay_;
+            // runs from the first release() on, any id is valid.
+            TimerId expireTimer_;
+            bool expireTimerArmed_;
+            uint64_t nextConnId_;
+            SlotMap<TcpConnectionPtr> connections_;
+            SlotMap<ConnectorPtr> connectors_;
+            std::unordered_map<AddressKey, IdleList, AddressKeyHash> idle_;
+            size_t numIdle_;
+            int64_t numConnects_;
+            int64_t numReuses_;
+        };
+    }
+}
+
+#endif //GG_LIB_KEEPALIVEPOOL_H
@@ -5,6 +5,7 @@
 #define GG_LIB_NETUTILS_H
 
 #include "gg_lib/Utils.h"
+#include "gg_lib/SmallFunction.h"
 #include "gg_lib/Timestamp.h"
 #include <functional>
 #include <memory>
@@ -18,12 +19,34 @@ namespace gg_lib {
 
         typedef uint64_t TimerId;
 
+        /// Implementation of the timers of an EventLoop.
+        enum TimerQueueType {
+            /// Binary heap, O(log n) add, lazy cancel.
+            kHeapTimerQueue,
+            /// Hierarchical timing wheel with 1ms ticks, O(1) add and cancel.
+            kWheelTimerQueue,
+        };
+
+        /// How EventLoopThreadPool::getNextLoop picks the loop of a new connection.
+        enum LoopPlacementPolicy {
+            kRoundRobin,
+            /// The loop with the fewest connections.
+            kLeastConnections,
+            /// The loop with the fewest functors queued and not yet run.
+            kLeastPendingFunctors,
+            /// The less busy of two random loops, see EventLoopThreadPool::loadScore.
+            kPowerOfTwoChoices,
+        };
+
         typedef std::shared_ptr<TcpConnection> TcpConnectionPtr;
-        typedef std::function<void()> TimerCallback;
+        typedef uint64_t ConnectionId;
+        typedef SmallFunction<void()> TimerCallback;
         typedef std::function<void(const TcpConnectionPtr &)> ConnectionCallback;
         typedef std::function<void(const TcpConnectionPtr &)> CloseCallback;
         typedef std::function<void(const TcpConnectionPtr &)> WriteCompleteCallback;
         typedef std::function<void(const TcpConnectionPtr &, size_t)> HighWaterMarkCallback;
+        /// result is the return value of the syscall, or -errno.
+        typedef std::function<void(int result)> IoCompletionCallback;
 
         typedef std::function<void(const TcpConnectionPtr &,
                                    Buffer *,
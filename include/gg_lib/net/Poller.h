@@ -6,9 +6,9 @@
 
 #include "gg_lib/Timestamp.h"
 #include "gg_lib/net/EventLoop.h"
+#include "gg_lib/net/ChannelTable.h"
 
 #include <vector>
-#include <unordered_map>
 
 
 namespace gg_lib {
@@ -37,6 +37,32 @@ namespace gg_lib {
 
             virtual bool hasChannel(Channel *channel) const;
 
+            /// Whether Channel::setEdgeTriggered is honoured.
+            virtual bool supportsEdgeTriggered() const { return false; }
+
+            /// Whether submitRecv/submitSend are supported.
+            virtual bool supportsCompletion() const { return false; }
+
+            /// Submits a recv(2) into buf, cb is called in the loop thread when it completes.
+            /// buf must stay valid until then. Returns an id for cancelOperation.
+            /// Must be called in the loop thread.
+            virtual uint64_t submitRecv(int fd, void *buf, size_t len, IoCompletionCallback cb);
+
+            /// Submits a sendmsg(2) gathering the iovecs, see submitRecv.
+            /// The iovec array itself may be reused once this returns.
+            virtual uint64_t submitSend(int fd, const struct iovec *iov, int iovcnt, IoCompletionCallback cb);
+
+            /// Cancels an operation in flight, its callback is still called, usually with -ECANCELED.
+            virtual void cancelOperation(uint64_t operationId);
+
+            /// Runs callbacks of completed operations, called after active channels are handled.
+            virtual void dispatchCompletions() {}
+
+            /// Lets a blocking poll busy-poll the device queues of its sockets for up to
+            /// microSeconds, budget packets at a time. Returns false if unsupported.
+            /// Must be called in the loop thread.
+            virtual bool setBusyPoll(int microSeconds, int budget) { return false; }
+
             static Poller *newDefaultPoller(EventLoop *loop);
 
             void assertInLoopThread() const {
@@ -45,8 +71,7 @@ namespace gg_lib {
 
 
         protected:
-            typedef std::unordered_map<int, Channel *> ChannelMap;
-            ChannelMap channels_;
+            ChannelTable channels_;
         private:
             EventLoop *ownerLoop_;
         };
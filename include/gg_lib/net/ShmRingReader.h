@@ -0,0 +1,76 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#ifndef GG_LIB_SHMRINGREADER_H
+#define GG_LIB_SHMRINGREADER_H
+
+#include "gg_lib/net/Buffer.h"
+#include "gg_lib/net/Channel.h"
+#include "gg_lib/ShmRing.h"
+#include "gg_lib/Timestamp.h"
+
+#include <functional>
+#include <memory>
+
+namespace gg_lib {
+    namespace net {
+        class EventLoop;
+
+        ///
+        /// @brief The consumer of a ShmRing, reading it in an EventLoop.
+        ///
+        /// The bytes are handed to the message callback in an input Buffer, like those
+        /// of a TcpConnection, what it leaves there is handed again with the next bytes.
+        /// The producer, a ShmRingWriter, signals an eventfd only when the reader has
+        /// drained the ring and is about to sleep, a busy reader takes no system calls.
+        /// Must be used in the loop thread.
+        ///
+        class ShmRingReader : noncopyable {
+        public:
+            typedef std::function<void(Buffer *buf, Timestamp receiveTime)> MessageCallback;
+
+            /// Bytes read per event before the other events of the loop are served.
+            static constexpr size_t kDefaultReadBudget = 1024 * 1024;
+
+            ShmRingReader(EventLoop *loop, std::unique_ptr<ShmRing> ring);
+
+            ~ShmRingReader();
+
+            void setMessageCallback(MessageCallback cb) { messageCallback_ = std::move(cb); }
+
+            /// The eventfd the writer signals, pass it to the producer, e.g. with
+            /// TcpConnection::sendFds or by fork(2).
+            int notifyFd() const { return eventFd_; }
+
+            ShmRing *ring() const { return ring_.get(); }
+
+            void start();
+
+            void stop();
+
+            /// Times the writer signalled the eventfd, the reader's own notifications from
+            /// start() and after the read budget ran out are not counted.
+            int64_t numWakeups() const { return numWakeups_; }
+
+        private:
+            void handleRead(Timestamp receiveTime);
+
+            void drain(Timestamp receiveTime);
+
+            void notifySelf();
+
+            EventLoop *loop_;
+            std::unique_ptr<ShmRing> ring_;
+            const int eventFd_;
+            Channel channel_;
+            MessageCallback messageCallback_;
+            // has no storage while empty.
+            Buffer inputBuffer_;
+            int64_t numWakeups_;
+            // written by notifySelf() since the eventfd was read.
+            uint64_t selfNotifies_;
+        };
+    }
+}
+
+#endif //GG_LIB_SHMRINGREADER_H
@@ -0,0 +1,52 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#ifndef GG_LIB_SHMRINGWRITER_H
+#define GG_LIB_SHMRINGWRITER_H
+
+#include "gg_lib/ShmRing.h"
+
+#include <memory>
+#include <stdint.h>
+
+namespace gg_lib {
+    namespace net {
+        ///
+        /// @brief The producer of a ShmRing, waking its ShmRingReader through an eventfd.
+        ///
+        /// Needs no EventLoop, but must be used by one thread at a time.
+        ///
+        class ShmRingWriter : noncopyable {
+        public:
+            /// notifyFd is the reader's, see ShmRingReader::notifyFd(), it is duplicated.
+            ShmRingWriter(std::unique_ptr<ShmRing> ring, int notifyFd);
+
+            ~ShmRingWriter();
+
+            /// false while the ring has no room for len bytes, the reader frees it as it reads.
+            bool append(const void *data, size_t len);
+
+            /// len contiguous bytes in the ring to write in place, null while there is no room.
+            char *beginWrite(size_t len) {
+                return ring_->writableBytes() >= len ? ring_->beginWrite() : nullptr;
+            }
+
+            /// Publishes len bytes written at beginWrite().
+            void hasWritten(size_t len);
+
+            ShmRing *ring() const { return ring_.get(); }
+
+            /// Times the reader was woken.
+            int64_t numWakeups() const { return numWakeups_; }
+
+        private:
+            void wakeReader();
+
+            std::unique_ptr<ShmRing> ring_;
+            const int notifyFd_;
+            int64_t numWakeups_;
+        };
+    }
+}
+
+#endif //GG_LIB_SHMRINGWRITER_H
@@ -10,15 +10,25 @@
 #include <netinet/in.h>
 #include <arpa/inet.h>
 #include <endian.h>
+#include <sys/socket.h>
+#include <sys/un.h>
 
 
 struct tcp_info;
 
+struct mmsghdr;
+
 namespace gg_lib {
     namespace net {
         /// @brief Socket operation wrapper
         namespace sockets {
-            int createNonblockingOrDie(sa_family_t family);
+            /// Most file descriptors passed with one message, see sendWithFds.
+            constexpr int kMaxPassedFds = 64;
+
+            /// type is SOCK_STREAM, or SOCK_SEQPACKET for AF_UNIX.
+            int createNonblockingOrDie(sa_family_t family, int type = SOCK_STREAM);
+
+            int createUdpNonblockingOrDie(sa_family_t family);
 
             int connect(int sockfd, const struct sockaddr *addr);
 
@@ -28,12 +38,32 @@ namespace gg_lib {
 
             int accept(int sockfd, struct sockaddr_in6 *addr);
 
+            /// addr of any family, addrlen is the size of its storage.
+            int accept(int sockfd, struct sockaddr *addr, socklen_t addrlen);
+
             ssize_t read(int sockfd, void *buf, size_t count);
 
             ssize_t readv(int sockfd, const struct iovec *iov, int iovcnt);
 
             ssize_t write(int sockfd, const void *buf, size_t count);
 
+            ssize_t writev(int sockfd, const struct iovec *iov, int iovcnt);
+
+            ssize_t sendfile(int sockfd, int fd, off_t *offset, size_t count);
+
+            ssize_t sendmsg(int sockfd, const struct msghdr *msg, int flags);
+
+            ssize_t recvmsg(int sockfd, struct msghdr *msg, int flags);
+
+            /// AF_UNIX only, sends iov with numFds descriptors attached as SCM_RIGHTS,
+            /// the peer receives them with the first byte. At most kMaxPassedFds.
+            ssize_t sendWithFds(int sockfd, const struct iovec *iov, int iovcnt,
+                                const int *fds, int numFds);
+
+            int recvmmsg(int sockfd, struct mmsghdr *msgvec, unsigned int vlen, int flags);
+
+            int sendmmsg(int sockfd, struct mmsghdr *msgvec, unsigned int vlen, int flags);
+
             void close(int sockfd);
 
             void shutdownWrite(int sockfd);
@@ -52,6 +82,9 @@ namespace gg_lib {
 
             int getSocketError(int sockfd);
 
+            /// The length bind(2) and connect(2) take for addr, by its family.
+            socklen_t sockaddrLength(const struct sockaddr *addr);
+
             const struct sockaddr *sockaddr_cast(const struct sockaddr_in *addr);
 
             const struct sockaddr *sockaddr_cast(const struct sockaddr_in6 *addr);
@@ -99,7 +132,7 @@ namespace gg_lib {
 #pragma GCC diagnostic pop
         }
 
-        /// @brief Wrapper of sockaddr_in.
+        /// @brief Wrapper of sockaddr_in, sockaddr_in6 or sockaddr_un.
         class InetAddress : public copyable {
         public:
             explicit InetAddress(uint16_t port = 0, bool loopbackOnly = false, bool ipv6 = false);
@@ -112,12 +145,30 @@ namespace gg_lib {
             explicit InetAddress(const struct sockaddr_in6 &addr)
                     : addr6_(addr) {}
 
+            /// sockaddr_un is the largest, addr may hold any of the families.
+            explicit InetAddress(const struct sockaddr_un &addr)
+                    : addrUnix_(addr) {}
+
+            /// AF_UNIX, a path starting with '@' names the rest in the abstract namespace.
+            static InetAddress fromUnixPath(StringArg path);
+
+            /// The address sockfd is bound to, of any family.
+            static InetAddress localAddressOf(int sockfd);
+
+            /// The address of the peer of sockfd, of any family.
+            static InetAddress peerAddressOf(int sockfd);
+
             sa_family_t family() const { return addr_.sin_family; }
 
+            /// AF_UNIX only, "@name" in the abstract namespace, empty if unnamed.
+            string unixPath() const;
+
             string toIp() const;
 
+            /// The path of an AF_UNIX address, like toIp().
             string toIpPort() const;
 
+            /// 0 for AF_UNIX.
             uint16_t port() const;
 
             const struct sockaddr *getSockAddr() const { return sockets::sockaddr_cast(&addr6_); }
@@ -126,7 +177,7 @@ namespace gg_lib {
 
             uint32_t ipv4NetEndian() const;
 
-            uint16_t portNetEndian() const { return addr_.sin_port; }
+            uint16_t portNetEndian() const { return family() == AF_UNIX ? 0 : addr_.sin_port; }
 
             static bool resolve(StringArg hostname, InetAddress *result);
 
@@ -136,6 +187,7 @@ namespace gg_lib {
             union {
                 struct sockaddr_in addr_;
                 struct sockaddr_in6 addr6_;
+                struct sockaddr_un addrUnix_;
             };
         };
 
@@ -186,6 +238,37 @@ namespace gg_lib {
 
             void setKeepAlive(bool on) const;
 
+            /// Listening TCP sockets only, a connection is accepted once its first bytes
+            /// arrive, or when it gave up waiting about seconds after the handshake.
+            /// 0 turns it off. Returns false if the kernel refuses.
+            bool setDeferAccept(int seconds) const;
+
+            /// Listening TCP sockets only, accept data carried by the SYN of clients which
+            /// hold a cookie, with up to queueLength such connections not yet accepted.
+            /// Needs the server bit, 2, of net.ipv4.tcp_fastopen. Returns false if the kernel refuses.
+            bool setFastOpen(int queueLength) const;
+
+            /// Steers each connection to the socket of a SO_REUSEPORT group whose index
+            /// is the receiving CPU modulo groupSize, sockets are indexed in bind order.
+            /// The program applies to the whole group. Returns false if the kernel refuses.
+            bool attachReusePortCpuSteering(int groupSize) const;
+
+            /// Busy-polls the device queue for up to microSeconds in blocking reads and poll(2),
+            /// raising it above net.core.busy_read needs CAP_NET_ADMIN.
+            /// Returns false if the kernel refuses.
+            bool setBusyPoll(int microSeconds) const;
+
+            /// Allow send(2) with MSG_ZEROCOPY, returns false if the kernel refuses.
+            bool setZeroCopy(bool on) const;
+
+            /// UDP only, datagrams of one flow may arrive coalesced into one read,
+            /// see UdpSocket. Returns false if the kernel refuses.
+            bool setUdpGro(bool on) const;
+
+            /// UDP only, whether sendmsg(2) takes a UDP_SEGMENT size to split a buffer
+            /// into datagrams.
+            bool supportsUdpGso() const;
+
         private:
             int sockfd_;
         };
@@ -0,0 +1,92 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#ifndef GG_LIB_TCPCLIENT_H
+#define GG_LIB_TCPCLIENT_H
+
+#include "gg_lib/net/Connector.h"
+#include "gg_lib/net/TcpConnection.h"
+
+#include "gg_lib/noncopyable.h"
+
+#include <atomic>
+#include <mutex>
+
+namespace gg_lib {
+    namespace net {
+        class EventLoop;
+
+        ///
+        /// @brief One outbound connection to a server, established on the given loop.
+        ///
+        /// A failed connect is retried by the Connector with backoff, see connector().
+        /// With enableRetry(), a connection closed after being established is
+        /// reconnected as well.
+        ///
+        class TcpClient : noncopyable {
+        public:
+            TcpClient(EventLoop *loop,
+                      const InetAddress &serverAddr,
+                      string nameArg);
+
+            ~TcpClient();
+
+            /// Thread safe.
+            void connect();
+
+            /// Thread safe, shuts the connection down once its output is sent.
+            void disconnect();
+
+            /// Thread safe, stops connecting.
+            void stop();
+
+            /// Thread safe, null while not connected.
+            TcpConnectionPtr connection() const {
+                std::lock_guard<std::mutex> lock(mutex_);
+                return connection_;
+            }
+
+            EventLoop *getLoop() const { return loop_; }
+
+            const string &name() const { return name_; }
+
+            bool retry() const { return retry_; }
+
+            void enableRetry() { retry_ = true; }
+
+            /// To set the retry delays and limit before connect().
+            const ConnectorPtr &connector() const { return connector_; }
+
+            /// Not thread safe, set before connect().
+            void setConnectionCallback(ConnectionCallback cb) { connectionCallback_ = std::move(cb); }
+
+            /// Not thread safe, set before connect().
+            void setMessageCallback(MessageCallback cb) { messageCallback_ = std::move(cb); }
+
+            /// Not thread safe, set before connect().
+            void setWriteCompleteCallback(WriteCompleteCallback cb) { writeCompleteCallback_ = std::move(cb); }
+
+        private:
+            /// In the loop thread.
+            void newConnection(int sockfd);
+
+            /// In the loop thread.
+            void removeConnection(const TcpConnectionPtr &conn);
+
+            EventLoop *loop_;
+            ConnectorPtr connector_;
+            const string name_;
+            ConnectionCallback connectionCallback_;
+            MessageCallback messageCallback_;
+            WriteCompleteCallback writeCompleteCallback_;
+            std::atomic<bool> retry_;
+            std::atomic<bool> connect_;
+            // in the loop thread.
+            int nextConnId_;
+            mutable std::mutex mutex_;
+            TcpConnectionPtr connection_;
+        };
+    }
+}
+
+#endif //GG_LIB_TCPCLIENT_H
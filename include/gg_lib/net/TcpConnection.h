@@ -7,34 +7,65 @@
 #include "gg_lib/net/NetUtils.h"
 #include "gg_lib/net/SocketsHelper.h"
 #include "gg_lib/net/Buffer.h"
+#include "gg_lib/net/ChainBuffer.h"
+#include "gg_lib/net/Channel.h"
 #include "gg_lib/any.h"
 
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 namespace gg_lib {
     namespace net {
-        class Channel;
-
         class EventLoop;
 
-        class Socket;
+        /// The callbacks a TcpServer gives its connections, shared by them instead of copied.
+        struct ConnectionCallbacks {
+            ConnectionCallback connectionCallback;
+            MessageCallback messageCallback;
+            WriteCompleteCallback writeCompleteCallback;
+            CloseCallback closeCallback;
+            /// called in the new loop after migrateTo().
+            ConnectionCallback migrateCallback;
+        };
 
         class TcpConnection : noncopyable,
                               public std::enable_shared_from_this<TcpConnection> {
         public:
+            static constexpr size_t kDefaultReadBudgetBytes = 256 * 1024;
+            static constexpr int kDefaultReadBudgetReads = 16;
+
+            /// Turns SO_KEEPALIVE on.
             TcpConnection(EventLoop *loop,
                           string name,
                           int sockfd,
                           const InetAddress &localAddr,
                           const InetAddress &peerAddr);
 
+            /// Named namePrefix followed by serial, which is formatted only when name() is called.
+            /// The local address is looked up by the first localAddress() and the socket options
+            /// are left as they are, accepted sockets inherit those of the listening socket.
+            TcpConnection(EventLoop *loop,
+                          ConnectionId id,
+                          std::shared_ptr<const string> namePrefix,
+                          uint64_t serial,
+                          int sockfd,
+                          const InetAddress &peerAddr);
+
             ~TcpConnection();
 
-            EventLoop *getLoop() const { return loop_; }
+            /// Thread safe, changes when the connection moves, see migrateTo().
+            EventLoop *getLoop() const { return loop_.load(std::memory_order_relaxed); }
 
-            const string &name() const { return name_; }
+            /// Given by the TcpServer, see TcpServer::findConnection. 0 if constructed by name.
+            ConnectionId id() const { return id_; }
 
-            const InetAddress &localAddress() const { return localAddr_; }
+            /// Formatted by each call when the connection was named by a prefix and serial.
+            string name() const;
+
+            /// Thread safe.
+            const InetAddress &localAddress() const;
 
             const InetAddress &peerAddress() const { return peerAddr_; }
 
@@ -42,11 +73,14 @@ namespace gg_lib {
 
             bool disconnected() const { return state_ == kDisconnected; }
 
-            bool getTcpInfo(struct tcp_info *tcpi) const { return socket_->getTcpInfo(tcpi); }
+            bool getTcpInfo(struct tcp_info *tcpi) const { return socket_.getTcpInfo(tcpi); }
+
+            void setTcpNoDelay(bool on) { socket_.setTcpNoDelay(on); }
 
-            void setTcpNoDelay(bool on) { socket_->setTcpNoDelay(on); }
+            void setTcpCork(bool on) { socket_.setTcpCork(on); }
 
-            void setTcpCork(bool on) { socket_->setTcpCork(on); }
+            /// See Socket::setBusyPoll.
+            bool setBusyPoll(int microSeconds) { return socket_.setBusyPoll(microSeconds); }
 
             void setContext(any context) { context_ = std::move(context); }
 
@@ -54,11 +88,11 @@ namespace gg_lib {
 
             any &getContext() { return context_; }
 
-            void setConnectionCallback(const ConnectionCallback &cb) { connectionCallback_ = cb; }
+            void setConnectionCallback(const ConnectionCallback &cb);
 
-            void setMessageCallback(const MessageCallback &cb) { messageCallback_ = cb; }
+            void setMessageCallback(const MessageCallback &cb);
 
-            void setWriteCompleteCallback(const WriteCompleteCallback &cb) { writeCompleteCallback_ = cb; }
+            void setWriteCompleteCallback(const WriteCompleteCallback &cb);
 
             void setHighWaterMarkCallback(const HighWaterMarkCallback &cb, size_t highWaterMark) {
                 highWaterMarkCallback_ = cb;
@@ -67,7 +101,7 @@ namespace gg_lib {
 
             Buffer *inputBuffer() { return &inputBuffer_; }
 
-            Buffer *outputBuffer() { return &outputBuffer_; }
+            ChainBuffer *outputBuffer() { return &outputBuffer_; }
 
             string getTcpInfoString() const;
 
@@ -79,10 +113,38 @@ namespace gg_lib {
 
             void send(const string_view &message);
 
+            /// The part the socket doesn't take at once is queued with the storage of message,
+            /// not copied, message is left empty.
             void send(Buffer &&message);
 
             void send(Buffer *message);
 
+            /// Queues the blocks and slices of message without copying them,
+            /// they are flushed together with one writev(2).
+            void send(ChainBuffer &&message);
+
+            /// Streams len bytes of fd from offset with sendfile(2), in order with
+            /// the other sends. fd is duplicated, so the caller may close it at once.
+            /// The bytes count towards the high water mark until they are sent.
+            void sendFile(int fd, off_t offset, size_t len);
+
+            /// AF_UNIX only, passes count descriptors to the peer with the first byte of
+            /// message, in order with the other sends, see sockets::kMaxPassedFds.
+            /// message must not be empty. The descriptors are duplicated, so the caller
+            /// may close them at once. Refused in completion mode.
+            void sendFds(const int *fds, int count, const string_view &message);
+
+            /// AF_UNIX only, reads with recvmsg(2) to keep the descriptors the peer passes,
+            /// see takeReceivedFds(). Off by default, the kernel closes them then.
+            /// Must be called in the loop thread or before connectEstablished(),
+            /// ignored in completion mode.
+            void setReceiveFds(bool on) { receiveFds_ = on; }
+
+            /// The descriptors received so far in order, those which came with the bytes
+            /// of a message callback are here when it runs. The caller owns them.
+            /// Must be called in the loop thread.
+            std::vector<int> takeReceivedFds();
+
             void shutdown();
 
             void shutdownAndForceCloseAfter(double seconds);
@@ -97,8 +159,51 @@ namespace gg_lib {
 
             bool isReading() const { return reading_; };
 
+            /// @brief Moves the connection to loop with its buffers and queued output.
+            /// Thread safe. The calls made meanwhile, from any thread, are held back
+            /// and run on loop in order once it is registered there. Refused, with the
+            /// connection left where it is, unless connected, in completion mode,
+            /// or while zero-copy sends are in flight.
+            void migrateTo(EventLoop *loop);
+
+            /// Last time bytes were received, queued output was flushed, or the connection was established.
+            Timestamp lastActiveTime() const { return lastActive_; }
+
+            /// Reads and writes are submitted to the loop's poller and handled when
+            /// they complete, instead of being issued after a readiness event.
+            /// Must be called before connectEstablished(), ignored if the poller
+            /// doesn't support completion-based I/O.
+            void setCompletionMode(bool on);
+
+            bool completionMode() const { return completionMode_; }
+
+            /// Readiness is reported on edges, and a read event drains the socket within
+            /// the read budget, saving the epoll_wait(2) round trip per read for peers
+            /// which stream in bulk. Must be called before connectEstablished(), ignored
+            /// in completion mode or if the poller doesn't support it.
+            void setEdgeTriggered(bool on);
+
+            bool edgeTriggered() const { return edgeTriggered_; }
+
+            /// In edge-triggered mode, a read event reads at most maxReads times or until
+            /// maxBytes were read, the rest is read after the other ready connections.
+            /// Must be called in the loop thread or before connectEstablished().
+            void setReadBudget(size_t maxBytes, int maxReads);
+
+            /// Writes of at least threshold bytes queued in ChainBuffers use MSG_ZEROCOPY,
+            /// their blocks are kept until the kernel reports it is done with them.
+            /// Turned off by 0, or when the kernel reports it copied the data anyway.
+            /// Ignored in completion mode. Must be called in the loop thread.
+            void setZeroCopyThreshold(size_t threshold);
+
             /// Internal use only.
-            void setCloseCallback(const CloseCallback &cb) { closeCallback_ = cb; }
+            void setCloseCallback(const CloseCallback &cb);
+
+            /// Internal use only, called in the new loop after migrateTo().
+            void setMigrateCallback(const ConnectionCallback &cb);
+
+            /// Internal use only, shares callbacks until one of them is set on this connection.
+            void setCallbacks(std::shared_ptr<ConnectionCallbacks> callbacks);
 
             // called when TcpServer accepts a new connection
             void connectEstablished();
@@ -107,24 +212,111 @@ namespace gg_lib {
             void connectDestroyed();
 
         private:
+            TcpConnection(EventLoop *loop,
+                          ConnectionId id,
+                          std::shared_ptr<const string> namePrefix,
+                          uint64_t serial,
+                          string name,
+                          int sockfd,
+                          const InetAddress *localAddr,
+                          const InetAddress &peerAddr);
+
             enum StateE {
                 kDisconnected, kConnecting, kConnected, kDisconnecting
             };
 
+            struct ZeroCopyHold {
+                uint32_t seq;
+                ChainBuffer blocks;
+            };
+
+            struct PendingFile {
+                // -1 when only passing fds.
+                int fd;
+                off_t offset;
+                size_t remaining;
+                // bytes sent after this file, they become outputBuffer_ once it is done.
+                ChainBuffer trailer;
+                // passed with the first byte of trailer, see sendFds().
+                std::vector<int> fds;
+            };
+
+            ssize_t readInput(int *savedErrno) {
+                return receiveFds_ ? inputBuffer_.readFdWithFds(channel_.fd(), &receivedFds_, savedErrno)
+                                   : inputBuffer_.readFd(channel_.fd(), savedErrno);
+            }
+
             void handleRead(Timestamp receiveTime);
 
+            void drainInput(Timestamp receiveTime);
+
+            void continueRead();
+
+            /// Idle connections hold no input memory, a recv posted in completion mode needs it.
+            void releaseInputIfDrained() {
+                if (inputBuffer_.readableBytes() == 0 && !recvPending_) {
+                    inputBuffer_.release();
+                }
+            }
+
             void handleWrite();
 
             void handleClose();
 
             void handleError();
 
+            ssize_t writeOutput(int *savedErrno);
+
+            ssize_t writeChain(ChainBuffer *buf, int *savedErrno);
+
+            bool readZeroCopyNotifications();
+
+            void completeZeroCopy(uint32_t lo, uint32_t hi);
+
+            void writeDone();
+
+            void submitRecv();
+
+            void submitSend();
+
+            void handleRecvComplete(int result);
+
+            void handleSendComplete(int result);
+
+            void cancelIo();
+
+            void sendFileInLoop(int fd, off_t offset, size_t len);
+
+            void sendFdsInLoop(const std::vector<int> &fds, const string &message);
+
+            /// Sends the trailer of file with its fds, -1 if nothing was sent.
+            ssize_t writeFds(PendingFile *file, int *savedErrno);
+
+            void readFileChunk(PendingFile *file);
+
+            void fillFromFiles();
+
+            void popFile();
+
+            ChainBuffer &outputTail() {
+                return pendingFiles_.empty() ? outputBuffer_ : pendingFiles_.back().trailer;
+            }
+
+            size_t queuedBytes() const;
+
+            bool writePending() const;
+
             void sendInLoop(const string_view &message);
 
             void sendInLoop(Buffer &message);
 
             void sendInLoop(const void *message, size_t len);
 
+            void sendInLoop(ChainBuffer &message);
+
+            // oldLen is the size of outputBuffer_ before the unsent bytes were queued.
+            void outputQueued(size_t oldLen);
+
             void shutdownInLoop();
 
             void shutdownAndForceCloseInLoop(double seconds);
@@ -139,24 +331,82 @@ namespace gg_lib {
 
             void stopReadInLoop();
 
-            EventLoop *loop_;
+            typedef SmallFunction<void()> Functor;
+
+            bool inLoopThread() const;
+
+            /// Like EventLoop::runInLoop, holds cb back while migrating.
+            void runInLoop(Functor cb);
+
+            void queueInLoop(Functor cb);
+
+            void setChannelCallbacks();
+
+            /// Copies shared callbacks before one of them is set.
+            ConnectionCallbacks *mutableCallbacks();
+
+            void beginMigrationInLoop(EventLoop *loop);
+
+            void detachInLoop(EventLoop *loop);
+
+            void attachInLoop();
+
+            void runMigrationStash();
+
+            std::atomic<EventLoop *> loop_;
+            const ConnectionId id_;
+            const std::shared_ptr<const string> namePrefix_;
+            const uint64_t serial_;
+            // empty when named by namePrefix_ and serial_.
             const string name_;
             std::atomic<StateE> state_;
             bool reading_;
-
-            std::unique_ptr<Socket> socket_;
-            std::unique_ptr<Channel> channel_;
-            const InetAddress localAddr_;
+            bool completionMode_;
+            bool edgeTriggered_;
+            // a drain which used up the read budget queued continueRead().
+            bool readRequeued_;
+            // the peer shut down, read until EOF even after a short read.
+            bool pendingEof_;
+            bool receiveFds_;
+            size_t readBudgetBytes_;
+            int readBudgetReads_;
+            bool recvPending_;
+            // a recv completed after stopRead(), its bytes wait in inputBuffer_ for startRead().
+            bool recvHeld_;
+            bool sendPending_;
+            uint64_t recvOperation_;
+            uint64_t sendOperation_;
+            Timestamp lastActive_;
+
+            Socket socket_;
+            // moves to the new loop in migrateTo().
+            Channel channel_;
+            // set by the constructor or the first localAddress().
+            mutable std::once_flag localAddrOnce_;
+            mutable InetAddress localAddr_;
             const InetAddress peerAddr_;
-            ConnectionCallback connectionCallback_;
-            MessageCallback messageCallback_;
-            WriteCompleteCallback writeCompleteCallback_;
+            std::shared_ptr<ConnectionCallbacks> callbacks_;
+            bool ownsCallbacks_;
             HighWaterMarkCallback highWaterMarkCallback_;
-            CloseCallback closeCallback_;
             size_t highWaterMark_;
+            // has no storage while empty, see releaseInputIfDrained().
             Buffer inputBuffer_;
-            Buffer outputBuffer_;
+            // appends never move queued bytes, a send in flight may point into it.
+            ChainBuffer outputBuffer_;
+            std::vector<PendingFile> pendingFiles_;
+            std::vector<int> receivedFds_;
+            size_t zeroCopyThreshold_;
+            // the kernel numbers zero-copy sends, all before zeroCopyDoneSeq_ are reported.
+            uint32_t zeroCopyNextSeq_;
+            uint32_t zeroCopyDoneSeq_;
+            std::vector<ZeroCopyHold> zeroCopyHolds_;
+            // [lo, hi] reported ahead of zeroCopyDoneSeq_
+            std::vector<std::pair<uint32_t, uint32_t>> zeroCopyRanges_;
             any context_;
+            // set from beginMigrationInLoop until the calls made meanwhile have run.
+            std::atomic<bool> migrating_;
+            std::mutex migrationMutex_;
+            std::vector<Functor> migrationStash_;
         };
     }
 }
@@ -7,10 +7,14 @@
 #include "gg_lib/net/NetUtils.h"
 #include "gg_lib/net/TcpConnection.h"
 
+#include "gg_lib/CpuAffinity.h"
+#include "gg_lib/SlabPool.h"
+#include "gg_lib/SlotMap.h"
 #include "gg_lib/noncopyable.h"
 
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace gg_lib {
     namespace net {
@@ -20,18 +24,28 @@ namespace gg_lib {
 
         class EventLoopThreadPool;
 
+        class IdleReaper;
+
         class TcpServer : noncopyable {
         public:
             typedef std::function<void(EventLoop *)> ThreadInitCallback;
+            /// kReusePortPerLoop binds one SO_REUSEPORT Acceptor in each I/O loop,
+            /// which also keeps the connections it accepts, so accepting, establishing
+            /// and destroying a connection never leave the I/O thread.
             enum Option {
                 kNoReusePort,
                 kReusePort,
+                kReusePortPerLoop,
             };
 
+            /// listenAddr may be AF_UNIX, except with kReusePortPerLoop. socketType is
+            /// SOCK_STREAM, or SOCK_SEQPACKET for AF_UNIX: a send is one record then,
+            /// a read takes at most one, but records are not delimited in the input Buffer.
             TcpServer(EventLoop *loop,
                       const InetAddress &listenAddr,
                       string nameArg,
-                      Option option = kNoReusePort);
+                      Option option = kNoReusePort,
+                      int socketType = SOCK_STREAM);
 
             ~TcpServer();
 
@@ -46,7 +60,8 @@ namespace gg_lib {
             /// - 0 means all I/O in loop's thread, no thread will created, this is the default value.
             /// - 1 means all I/O in another thread.
             /// - N means a thread pool with N threads, new connections are assigned on a round-robin basis.
-            void setThreadNum(int numThreads);
+            /// @param affinity pins the I/O threads, they float by default.
+            void setThreadNum(int numThreads, const CpuAffinity &affinity = CpuAffinity());
 
             void setThreadInitCallback(ThreadInitCallback cb) { threadInitCallback_ = std::move(cb); }
 
@@ -55,11 +70,66 @@ namespace gg_lib {
             /// Thread safe
             void start();
 
-            void setConnectionCallback(ConnectionCallback cb) { connectionCallback_ = std::move(cb); }
-
-            void setMessageCallback(MessageCallback cb) { messageCallback_ = std::move(cb); }
-
-            void setWriteCompleteCallback(WriteCompleteCallback cb) { writeCompleteCallback_ = std::move(cb); }
+            void setConnectionCallback(ConnectionCallback cb) {
+                connectionCallback_ = std::move(cb);
+                connCallbacks_.reset();
+            }
+
+            void setMessageCallback(MessageCallback cb) {
+                messageCallback_ = std::move(cb);
+                connCallbacks_.reset();
+            }
+
+            void setWriteCompleteCallback(WriteCompleteCallback cb) {
+                writeCompleteCallback_ = std::move(cb);
+                connCallbacks_.reset();
+            }
+
+            /// @brief Serve connections with completion-based reads and writes.
+            /// Takes effect only on loops whose poller supports it (USE_IO_URING),
+            /// the MessageCallback contract is unchanged. Must be called before start().
+            void setCompletionMode(bool on) { completionMode_ = on; }
+
+            /// @brief Serve connections edge-triggered, each read event reads within the budget.
+            /// See TcpConnection::setEdgeTriggered and TcpConnection::setReadBudget.
+            /// Must be called before start().
+            void setEdgeTriggered(bool on,
+                                  size_t readBudgetBytes = TcpConnection::kDefaultReadBudgetBytes,
+                                  int readBudgetReads = TcpConnection::kDefaultReadBudgetReads) {
+                edgeTriggered_ = on;
+                readBudgetBytes_ = readBudgetBytes;
+                readBudgetReads_ = readBudgetReads;
+            }
+
+            /// @brief Force close connections which receive nothing and flush nothing for seconds.
+            /// Each I/O loop sweeps its connections with one timer, see IdleReaper.
+            /// 0 turns it off, which is the default. Must be called before start().
+            void setIdleTimeout(double seconds) { idleTimeout_ = seconds; }
+
+            /// @brief Hand each connection to the I/O loop of the index of the CPU it arrives on,
+            /// modulo the number of loops, see Socket::attachReusePortCpuSteering.
+            /// Pays off when I/O loop i runs on CPU i. Only for kReusePortPerLoop,
+            /// must be called before start().
+            void setReusePortCpuSteering(bool on) { cpuSteering_ = on; }
+
+            /// @brief Accept a connection once its first bytes arrive, handshakes which bring
+            /// no data don't wake the loop, see Socket::setDeferAccept. For servers whose clients
+            /// speak first. 0 turns it off, which is the default. Must be called before start().
+            void setDeferAccept(int seconds) { deferAcceptSeconds_ = seconds; }
+
+            /// @brief Take the first request in the SYN from clients which connect with TCP Fast Open,
+            /// see Socket::setFastOpen. 0 turns it off, which is the default.
+            /// Must be called before start().
+            void setFastOpen(int queueLength) { fastOpenQueueLength_ = queueLength; }
+
+            /// @brief Set TCP_NODELAY on the listening sockets, the accepted ones inherit it
+            /// instead of each connection setting it. Must be called before start().
+            void setTcpNoDelay(bool on) { tcpNoDelay_ = on; }
+
+            /// @brief The connection with id, null once it has been removed.
+            /// Must be called in the loop which accepted it, getLoop(), or in
+            /// kReusePortPerLoop mode the I/O loop it was established in.
+            TcpConnectionPtr findConnection(ConnectionId id);
 #ifndef NDEBUG
             void checkConnAlive();
 #endif
@@ -72,20 +142,54 @@ namespace gg_lib {
 
             void removeConnectionInLoop(const TcpConnectionPtr& conn);
 
-            typedef std::unordered_map<string, TcpConnectionPtr> ConnectionMap;
+            void startPerLoopAcceptors();
+
+            /// Applies the listening socket options, which accepted sockets inherit.
+            void configureAcceptor(const Acceptor &acceptor) const;
+
+            typedef std::unordered_map<EventLoop *, std::shared_ptr<IdleReaper>> IdleReaperMap;
+
+            /// Watches conn by the reaper of its loop, in that loop.
+            static void addToIdleReaper(const IdleReaperMap &reapers, const TcpConnectionPtr &conn);
+
+            class LoopShard;
+
+            // keys are the connection ids, tagged by the shard index in kReusePortPerLoop mode.
+            typedef SlotMap<TcpConnectionPtr> ConnectionMap;
 
             EventLoop *loop_;
             const string ipPort_;
             const string name_;
+            // "name-ipPort#", the serial number of a connection follows it in its name.
+            const std::shared_ptr<const string> namePrefix_;
+            const InetAddress listenAddr_;
+            const Option option_;
+            // null in kReusePortPerLoop mode.
             std::unique_ptr<Acceptor> acceptor_;
             std::shared_ptr<EventLoopThreadPool> threadPool_;
             ConnectionCallback connectionCallback_;
             MessageCallback messageCallback_;
             WriteCompleteCallback writeCompleteCallback_;
             ThreadInitCallback threadInitCallback_;
+            // shared by the connections, rebuilt after a callback was set.
+            std::shared_ptr<ConnectionCallbacks> connCallbacks_;
+            // connections are allocated in the loop thread, from its slabs.
+            std::shared_ptr<SlabPool> connectionPool_;
             AtomicInt32 started_;
-            int nextConnId_;
+            bool completionMode_;
+            bool edgeTriggered_;
+            size_t readBudgetBytes_;
+            int readBudgetReads_;
+            bool cpuSteering_;
+            double idleTimeout_;
+            int deferAcceptSeconds_;
+            int fastOpenQueueLength_;
+            bool tcpNoDelay_;
+            uint64_t nextConnId_;
             ConnectionMap connections_;
+            // written by start(), read-only afterwards.
+            IdleReaperMap idleReapers_;
+            std::vector<std::shared_ptr<LoopShard>> shards_;
 #ifndef NDEBUG
             typedef std::weak_ptr<TcpConnection> WeakTcpConnectionPtr;
             typedef std::vector<WeakTcpConnectionPtr> WeakVec;
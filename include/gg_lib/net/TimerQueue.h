@@ -4,64 +4,47 @@
 #ifndef GG_LIB_TIMERQUEUE_H
 #define GG_LIB_TIMERQUEUE_H
 
-#include <vector>
-#include <typeinfo>
-#include <memory>
-
 #include "gg_lib/Timestamp.h"
 #include "gg_lib/net/Channel.h"
 #include "gg_lib/net/NetUtils.h"
 
-#include <unordered_map>
-#include <queue>
-
 namespace gg_lib {
     namespace net {
         class EventLoop;
 
-        class Timer;
-
+        ///
+        /// @brief Timers of one EventLoop, woken up by a timerfd.
+        ///
         class TimerQueue : noncopyable {
         public:
-            // FIXME use unique_ptr instead.
-            typedef std::unique_ptr<Timer> TimerPtr;
-
             explicit TimerQueue(EventLoop *loop);
 
-            ~TimerQueue();
+            virtual ~TimerQueue();
 
-            TimerId addTimer(TimerCallback cb,
-                             Timestamp when,
-                             double interval);
-
-            void cancel(TimerId timerId);
-
-        private:
-            typedef std::pair<Timestamp, TimerId> Entry;
-            typedef std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> TimerMap;
-            typedef std::unordered_map<TimerId, TimerPtr> ActiveTimerMap;
+            /// Thread safe, the callback is always run in the loop thread.
+            virtual TimerId addTimer(TimerCallback cb,
+                                     Timestamp when,
+                                     double interval) = 0;
 
-            void addTimerInLoop(Timer *timer);
+            /// Thread safe, cancelling a timer that has expired does nothing.
+            virtual void cancel(TimerId timerId) = 0;
 
-            void cancelInLoop(TimerId timerId);
+            static TimerQueue *newTimerQueue(EventLoop *loop, TimerQueueType type);
 
-            void handleRead();
+        protected:
+            /// Runs the timers expired at now, called in the loop thread.
+            virtual void handleExpired(Timestamp now) = 0;
 
-            std::vector<Timer*> getExpired(Timestamp now);
+            /// Wakes up the loop at expiration, replacing the former expiration.
+            void resetTimerfd(Timestamp expiration);
 
-            void reset(const std::vector<Timer*> &expired, Timestamp now);
+            EventLoop *loop_;
 
-            bool insert(TimerPtr &timer);
+        private:
+            void handleRead();
 
-            EventLoop *loop_;
             const int timerfd_;
             Channel timerfdChannel_;
-
-            // Btree map sorted by expiration
-            TimerMap timers_;
-
-            // Own all timers
-            ActiveTimerMap activeTimers_;
         };
     }
 }
@@ -0,0 +1,84 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#ifndef GG_LIB_UDPSERVER_H
+#define GG_LIB_UDPSERVER_H
+
+#include "gg_lib/net/UdpSocket.h"
+
+#include "gg_lib/CpuAffinity.h"
+#include "gg_lib/noncopyable.h"
+
+#include <atomic>
+#include <vector>
+
+namespace gg_lib {
+    namespace net {
+        class EventLoop;
+
+        class EventLoopThreadPool;
+
+        ///
+        /// @brief Receives datagrams on one port in every I/O loop.
+        ///
+        /// Each loop binds its own UdpSocket to the port with SO_REUSEPORT, the kernel
+        /// spreads the flows over them, so datagrams are received and answered
+        /// without leaving the I/O thread.
+        ///
+        class UdpServer : noncopyable {
+        public:
+            typedef std::function<void(EventLoop *)> ThreadInitCallback;
+
+            UdpServer(EventLoop *loop, const InetAddress &listenAddr, string nameArg);
+
+            /// Must be called in the loop thread.
+            ~UdpServer();
+
+            const string &name() const { return name_; }
+
+            EventLoop *getLoop() const { return loop_; }
+
+            /// 0 receives in loop's thread, which is the default, N in N threads.
+            void setThreadNum(int numThreads, const CpuAffinity &affinity = CpuAffinity());
+
+            void setThreadInitCallback(ThreadInitCallback cb) { threadInitCallback_ = std::move(cb); }
+
+            /// Not thread safe, called in the I/O thread of the socket.
+            void setMessageCallback(UdpMessageCallback cb) { messageCallback_ = std::move(cb); }
+
+            /// See UdpSocket::setRecvBatch, must be called before start().
+            void setRecvBatch(int datagrams, size_t maxDatagramSize) {
+                recvBatch_ = datagrams;
+                maxDatagramSize_ = maxDatagramSize;
+            }
+
+            /// See UdpSocket::setGro, must be called before start().
+            void setGro(bool on) { gro_ = on; }
+
+            /// See UdpSocket::setGso, must be called before start().
+            void setGso(bool on) { gso_ = on; }
+
+            /// Thread safe, the port is bound once it returns.
+            void start();
+
+            /// One per I/O loop in the order of EventLoopThreadPool::getAllLoops(), empty until start().
+            const std::vector<UdpSocketPtr> &sockets() const { return sockets_; }
+
+        private:
+            EventLoop *loop_;
+            const string name_;
+            const InetAddress listenAddr_;
+            std::shared_ptr<EventLoopThreadPool> threadPool_;
+            ThreadInitCallback threadInitCallback_;
+            UdpMessageCallback messageCallback_;
+            int recvBatch_;
+            size_t maxDatagramSize_;
+            bool gro_;
+            bool gso_;
+            std::atomic<int> started_;
+            std::vector<UdpSocketPtr> sockets_;
+        };
+    }
+}
+
+#endif //GG_LIB_UDPSERVER_H
@@ -0,0 +1,149 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#ifndef GG_LIB_UDPSOCKET_H
+#define GG_LIB_UDPSOCKET_H
+
+#include "gg_lib/net/Channel.h"
+#include "gg_lib/net/SocketsHelper.h"
+#include "gg_lib/Timestamp.h"
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace gg_lib {
+    namespace net {
+        class EventLoop;
+
+        class UdpSocket;
+
+        /// One datagram of a received batch, data is only valid during the callback.
+        struct UdpDatagram {
+            const char *data;
+            size_t len;
+            InetAddress peer;
+        };
+
+        typedef std::shared_ptr<UdpSocket> UdpSocketPtr;
+        typedef std::function<void(const UdpSocketPtr &socket,
+                                   const UdpDatagram *datagrams,
+                                   int count,
+                                   Timestamp receiveTime)> UdpMessageCallback;
+
+        ///
+        /// @brief A bound UDP socket of one EventLoop, receiving and sending in batches.
+        ///
+        /// A read event takes up to a batch of datagrams with one recvmmsg(2) into
+        /// buffers shared by all UDP sockets of the thread, and hands them to the
+        /// message callback at once. With GRO, the kernel coalesces datagrams of
+        /// one flow, they are split up again before the callback.
+        ///
+        /// send() only queues, the datagrams queued in one loop iteration go out
+        /// with one sendmmsg(2). With GSO, equal sized datagrams queued back to
+        /// back for one peer share one message which the kernel segments.
+        ///
+        /// Must be owned by a shared_ptr, everything but the setters must be
+        /// called in the loop thread.
+        ///
+        class UdpSocket : noncopyable,
+                          public std::enable_shared_from_this<UdpSocket> {
+        public:
+            static constexpr int kDefaultRecvBatch = 64;
+            static constexpr size_t kDefaultMaxDatagramSize = 2048;
+            /// The receive buffers needed with GRO.
+            static constexpr size_t kGroDatagramSize = 65536;
+            static constexpr size_t kDefaultSendQueueBytes = 4 * 1024 * 1024;
+
+            /// Binds the socket, with SO_REUSEPORT sockets of several loops share the port.
+            UdpSocket(EventLoop *loop, const InetAddress &bindAddr, bool reusePort = false);
+
+            ~UdpSocket();
+
+            EventLoop *getLoop() const { return loop_; }
+
+            int fd() const { return socket_.fd(); }
+
+            /// The bound address, with the port picked by the kernel for port 0.
+            const InetAddress &localAddress() const { return localAddr_; }
+
+            void setMessageCallback(UdpMessageCallback cb) { messageCallback_ = std::move(cb); }
+
+            /// Datagrams taken per recvmmsg(2), and the largest taken, longer ones
+            /// are dropped. The thread keeps datagrams * maxDatagramSize bytes of
+            /// buffers. Must be called before start().
+            void setRecvBatch(int datagrams, size_t maxDatagramSize);
+
+            /// Must be called before start(), raises the largest datagram to
+            /// kGroDatagramSize. Returns false if the kernel refuses.
+            bool setGro(bool on);
+
+            /// Returns false if the kernel doesn't support it.
+            bool setGso(bool on);
+
+            /// Datagrams sent while this much is queued are dropped.
+            void setSendQueueLimit(size_t bytes) { sendQueueLimit_ = bytes; }
+
+            void start();
+
+            void stop();
+
+            /// Queues a datagram for peer, false if dropped since the send queue is full.
+            bool send(const void *data, size_t len, const InetAddress &peer);
+
+            /// Sends the queued datagrams now instead of at the end of the loop iteration.
+            void flush();
+
+            /// Datagrams received.
+            int64_t numReceived() const { return numReceived_; }
+
+            /// Datagrams sent.
+            int64_t numSent() const { return numSent_; }
+
+            /// Datagrams dropped, too long to receive or not fitting the send queue.
+            int64_t numDropped() const { return numDropped_; }
+
+            int64_t numRecvCalls() const { return numRecvCalls_; }
+
+            int64_t numSendCalls() const { return numSendCalls_; }
+
+        private:
+            struct PendingDatagram {
+                size_t offset;
+                size_t len;
+                InetAddress peer;
+            };
+
+            void handleRead(Timestamp receiveTime);
+
+            void handleWrite();
+
+            /// Fills the batch of mmsghdrs from the head of the send queue,
+            /// returns the number of messages and sets the datagrams each one holds.
+            int fillSendBatch();
+
+            EventLoop *loop_;
+            Socket socket_;
+            Channel channel_;
+            InetAddress localAddr_;
+            UdpMessageCallback messageCallback_;
+            int recvBatch_;
+            size_t maxDatagramSize_;
+            bool gro_;
+            bool gso_;
+            // datagram bytes queued back to back, sendHead_ is the first one not sent.
+            std::vector<char> sendData_;
+            std::vector<PendingDatagram> sendQueue_;
+            size_t sendHead_;
+            size_t sendQueueLimit_;
+            bool flushQueued_;
+            int64_t numReceived_;
+            int64_t numSent_;
+            int64_t numDropped_;
+            int64_t numRecvCalls_;
+            int64_t numSendCalls_;
+        };
+    }
+}
+
+#endif //GG_LIB_UDPSOCKET_H
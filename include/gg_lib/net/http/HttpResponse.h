@@ -13,6 +13,8 @@ namespace gg_lib {
     namespace net {
         class Buffer;
 
+        class ChainBuffer;
+
         class HttpResponse : noncopyable {
         public:
             enum HttpStatusCode {
@@ -43,9 +45,16 @@ namespace gg_lib {
 
             void appendToBuffer(Buffer *output) const;
 
+            /// Like appendToBuffer, but a large body is queued without being copied.
+            /// The body is moved out, call reset() before reusing the response.
+            void moveToBuffer(ChainBuffer *output);
+
             void reset();
 
         private:
+            template<typename BUFFER>
+            void appendHeadersTo(BUFFER *output) const;
+
             std::unordered_map<string, string> headers_;
             HttpStatusCode statusCode_;
             string statusMessage_;
@@ -23,6 +23,11 @@ namespace gg_lib {
 
             void removeChannel(Channel *channel) override;
 
+            bool supportsEdgeTriggered() const override { return true; }
+
+            /// EPIOCSPARAMS, Linux 6.9 and later.
+            bool setBusyPoll(int microSeconds, int budget) override;
+
         private:
             static constexpr int kInitEventListSize = 64;
 
@@ -0,0 +1,137 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#ifndef GG_LIB_IOURINGPOLLER_H
+#define GG_LIB_IOURINGPOLLER_H
+
+#include "gg_lib/net/Poller.h"
+
+#include <sys/socket.h>
+#include <memory>
+#include <vector>
+#include <unordered_map>
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+namespace gg_lib {
+    namespace net {
+        ///
+        /// @brief IO Multiplexing with io_uring(7) one-shot poll requests.
+        ///
+        /// Interest changes are only recorded by updateChannel(), the poll
+        /// requests are queued in the submission ring and handed to the kernel
+        /// together with the wait, so one loop iteration costs one io_uring_enter(2)
+        /// no matter how many channels toggled their events.
+        /// One-shot requests are re-armed after they fire, which keeps the
+        /// level-triggered semantics of PollPoller and EPollPoller.
+        ///
+        /// It also supports completion-based recv/send, whose results are
+        /// delivered by dispatchCompletions() instead of readiness events.
+        ///
+        class IoUringPoller : public Poller {
+        public:
+            explicit IoUringPoller(EventLoop *loop);
+
+            ~IoUringPoller() override;
+
+            Timestamp poll(int timeoutMs, ChannelList *activeChannels) override;
+
+            void updateChannel(Channel *channel) override;
+
+            void removeChannel(Channel *channel) override;
+
+            bool supportsCompletion() const override { return true; }
+
+            uint64_t submitRecv(int fd, void *buf, size_t len, IoCompletionCallback cb) override;
+
+            uint64_t submitSend(int fd, const struct iovec *iov, int iovcnt, IoCompletionCallback cb) override;
+
+            void cancelOperation(uint64_t operationId) override;
+
+            void dispatchCompletions() override;
+
+            /// Whether the running kernel supports everything this poller needs.
+            static bool isSupported();
+
+        private:
+            static constexpr int kMaxSendIovec = 64;
+
+            /// sendmsg arguments, kept until the kernel completes the request.
+            struct SendMessage {
+                struct msghdr header;
+                struct iovec iov[kMaxSendIovec];
+            };
+
+            struct Operation {
+                IoCompletionCallback callback;
+                uint32_t generation;
+                // allocated by the first send using this slot.
+                std::unique_ptr<SendMessage> message;
+            };
+
+            struct PollState {
+                uint64_t armedUserData; // 0 means no poll request in flight
+                int armedEvents;
+                bool dirty;
+            };
+
+            static constexpr unsigned kSubmissionEntries = 512;
+            static constexpr unsigned kCompletionEntries = 4096;
+
+            void markDirty(int fd, PollState *state);
+
+            void flushInterest();
+
+            void fillActiveChannels(ChannelList *activeChannels);
+
+            io_uring_sqe *getSqe();
+
+            void prepPollAdd(int fd, int events, uint64_t userData);
+
+            void prepPollRemove(uint64_t userData);
+
+            int enter(unsigned toSubmit, int timeoutMs);
+
+            unsigned pendingSubmissions() const;
+
+            uint64_t addOperation(IoCompletionCallback cb);
+
+            void completeOperation(uint64_t userData, int result);
+
+            typedef std::unordered_map<int, PollState> PollStateMap;
+
+            int ringFd_;
+            uint32_t nextSeq_;
+
+            // submission ring
+            void *sqRing_;
+            size_t sqRingSize_;
+            unsigned *sqHead_;
+            unsigned *sqTail_;
+            unsigned sqMask_;
+            unsigned sqEntries_;
+            unsigned *sqArray_;
+            io_uring_sqe *sqes_;
+            unsigned sqeTail_;
+
+            // completion ring, may share the mapping of submission ring
+            void *cqRing_;
+            size_t cqRingSize_;
+            unsigned *cqHead_;
+            unsigned *cqTail_;
+            unsigned cqMask_;
+            io_uring_cqe *cqes_;
+
+            PollStateMap pollStates_;
+            std::vector<int> dirtyFds_;
+
+            // slots of recv/send in flight, indexed by the low bits of user data
+            std::vector<Operation> operations_;
+            std::vector<uint32_t> freeOperations_;
+            std::vector<std::pair<IoCompletionCallback, int>> completions_;
+        };
+    }
+}
+
+#endif //GG_LIB_IOURINGPOLLER_H
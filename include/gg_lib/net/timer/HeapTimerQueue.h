@@ -0,0 +1,63 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#ifndef GG_LIB_HEAPTIMERQUEUE_H
+#define GG_LIB_HEAPTIMERQUEUE_H
+
+#include "gg_lib/net/TimerQueue.h"
+
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <queue>
+
+namespace gg_lib {
+    namespace net {
+        class Timer;
+
+        ///
+        /// @brief Timers kept in a binary heap sorted by expiration.
+        ///
+        /// Cancelled timers stay in the heap until they reach its top.
+        ///
+        class HeapTimerQueue : public TimerQueue {
+        public:
+            typedef std::unique_ptr<Timer> TimerPtr;
+
+            explicit HeapTimerQueue(EventLoop *loop);
+
+            ~HeapTimerQueue() override;
+
+            TimerId addTimer(TimerCallback cb,
+                             Timestamp when,
+                             double interval) override;
+
+            void cancel(TimerId timerId) override;
+
+        private:
+            typedef std::pair<Timestamp, TimerId> Entry;
+            typedef std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> TimerMap;
+            typedef std::unordered_map<TimerId, TimerPtr> ActiveTimerMap;
+
+            void addTimerInLoop(Timer *timer);
+
+            void cancelInLoop(TimerId timerId);
+
+            void handleExpired(Timestamp now) override;
+
+            std::vector<Timer*> getExpired(Timestamp now);
+
+            void reset(const std::vector<Timer*> &expired, Timestamp now);
+
+            bool insert(TimerPtr &timer);
+
+            // Btree map sorted by expiration
+            TimerMap timers_;
+
+            // Own all timers
+            ActiveTimerMap activeTimers_;
+        };
+    }
+}
+
+#endif //GG_LIB_HEAPTIMERQUEUE_H
@@ -0,0 +1,94 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#ifndef GG_LIB_WHEELTIMERQUEUE_H
+#define GG_LIB_WHEELTIMERQUEUE_H
+
+#include "gg_lib/net/TimerQueue.h"
+
+#include <deque>
+#include <unordered_map>
+
+namespace gg_lib {
+    namespace net {
+        ///
+        /// @brief Timers kept in a hierarchical timing wheel with 1ms ticks.
+        ///
+        /// Each level has kSlots slots, a slot of level n spans kSlots^n ticks.
+        /// A timer sits in the level its delay falls into and moves down
+        /// when the loop reaches its slot, so adding and cancelling a timer
+        /// are O(1), and neither allocates once the node pool is warm.
+        /// It suits timeouts which are re-armed on every message.
+        ///
+        /// A timer id carries the index and the generation of its node,
+        /// so cancelling an expired timer whose node is reused does nothing.
+        /// Timers added in other threads get a provisional id first,
+        /// it is mapped to the node when the timer is added in the loop thread.
+        ///
+        class WheelTimerQueue : public TimerQueue {
+        public:
+            static constexpr int kLevelBits = 6;
+            static constexpr int kSlots = 1 << kLevelBits;
+            /// Delays up to 2^24ms (4.6h) need no extra cascade.
+            static constexpr int kLevels = 4;
+
+            explicit WheelTimerQueue(EventLoop *loop);
+
+            ~WheelTimerQueue() override;
+
+            TimerId addTimer(TimerCallback cb,
+                             Timestamp when,
+                             double interval) override;
+
+            void cancel(TimerId timerId) override;
+
+        private:
+            struct Node;
+
+            TimerId addTimerInLoop(TimerCallback cb, Timestamp when, double interval);
+
+            void addProvisionalTimer(TimerCallback &cb, Timestamp when,
+                                     double interval, TimerId provisionalId);
+
+            void cancelInLoop(TimerId timerId);
+
+            void handleExpired(Timestamp now) override;
+
+            /// Links the node into the slot of its expiration, but not before minTick.
+            /// Returns the tick the slot is reached.
+            int64_t place(int index, int64_t minTick);
+
+            void cascade(int level);
+
+            void runSlot(Timestamp now);
+
+            /// The first tick after currentTick_ at which a slot holding timers is reached.
+            int64_t nextTick() const;
+
+            void rearm(int64_t tick);
+
+            int newNode();
+
+            void freeNode(int index);
+
+            void link(int index, int list);
+
+            void unlink(int index);
+
+            // nodes never move, a callback may add timers while it runs.
+            std::deque<Node> nodes_;
+            int freeNodes_;
+            int slots_[kLevels * kSlots];
+            // bit n is set if slot n of the level holds timers.
+            uint64_t occupied_[kLevels];
+            int64_t currentTick_;
+            int64_t armedTick_;
+            bool callingExpiredTimers_;
+
+            std::atomic<uint64_t> nextProvisionalId_;
+            std::unordered_map<TimerId, TimerId> provisionalIds_;
+        };
+    }
+}
+
+#endif //GG_LIB_WHEELTIMERQUEUE_H
@@ -0,0 +1,47 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#include "gg_lib/CpuAffinity.h"
+
+#include <gtest/gtest.h>
+#include <sched.h>
+#include <thread>
+
+using namespace gg_lib;
+
+TEST(CpuAffinityTest, ParseCpuList) {
+    EXPECT_EQ(CpuAffinity::parseCpuList("0-3,8,10-11\n"), (std::vector<int>{0, 1, 2, 3, 8, 10, 11}));
+    EXPECT_EQ(CpuAffinity::parseCpuList("5"), std::vector<int>{5});
+    EXPECT_TRUE(CpuAffinity::parseCpuList("").empty());
+}
+
+TEST(CpuAffinityTest, Topology) {
+    size_t numCpus = CpuAffinity::onlineCpus().size();
+    ASSERT_GT(numCpus, 0);
+    size_t inCores = 0;
+    for (const auto &core: CpuAffinity::physicalCores()) {
+        inCores += core.size();
+    }
+    EXPECT_EQ(inCores, numCpus);
+    EXPECT_FALSE(CpuAffinity::numaNodes().empty());
+}
+
+TEST(CpuAffinityTest, Policies) {
+    EXPECT_TRUE(CpuAffinity().cpusOf(3).empty());
+    CpuAffinity list = CpuAffinity::cpuList({2, 5});
+    EXPECT_EQ(list.cpusOf(0), std::vector<int>{2});
+    EXPECT_EQ(list.cpusOf(3), std::vector<int>{5});
+    size_t numCores = CpuAffinity::physicalCores().size();
+    CpuAffinity perCore = CpuAffinity::perCore();
+    EXPECT_EQ(perCore.cpusOf(0), perCore.cpusOf(static_cast<int>(numCores)));
+    EXPECT_EQ(CpuAffinity::spreadNodes().cpusOf(0), CpuAffinity::numaNodes().front());
+}
+
+TEST(CpuAffinityTest, Apply) {
+    int cpu = CpuAffinity::onlineCpus().back();
+    std::thread thread([cpu] {
+        EXPECT_TRUE(CpuAffinity::cpuList({cpu}).applyToCurrentThread(0));
+        EXPECT_EQ(::sched_getcpu(), cpu);
+    });
+    thread.join();
+}
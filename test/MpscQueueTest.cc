@@ -0,0 +1,104 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#include "gg_lib/MpscQueue.h"
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace gg_lib;
+
+namespace {
+    struct Item : MpscNode {
+        Item(int p, int s) : producer(p), seq(s) {}
+
+        int producer;
+        int seq;
+    };
+
+    /// Pushes node while pop() is about to queue the stub, as a producer on
+    /// another thread may.
+    struct PushBeforeStub {
+        static Item *node;
+
+        template<typename Queue>
+        static void beforeStubPush(Queue &queue) {
+            if (node) {
+                Item *pushed = node;
+                node = nullptr;
+                queue.push(pushed);
+            }
+        }
+    };
+
+    Item *PushBeforeStub::node = nullptr;
+}
+
+TEST(MpscQueueTest, PushPop) {
+    MpscQueue<Item> queue;
+    EXPECT_EQ(queue.pop(), nullptr);
+    EXPECT_TRUE(queue.empty());
+
+    Item a(0, 0), b(0, 1), c(0, 2);
+    queue.push(&a);
+    EXPECT_FALSE(queue.empty());
+    queue.push(&b);
+    EXPECT_EQ(queue.pop(), &a);
+    queue.push(&c);
+    EXPECT_FALSE(queue.empty());
+    EXPECT_EQ(queue.pop(), &b);
+    EXPECT_EQ(queue.pop(), &c);
+    EXPECT_EQ(queue.pop(), nullptr);
+    EXPECT_TRUE(queue.empty());
+
+    // nodes can be queued again once popped.
+    queue.push(&a);
+    EXPECT_EQ(queue.pop(), &a);
+    EXPECT_EQ(queue.pop(), nullptr);
+}
+
+TEST(MpscQueueTest, PushBeforeStub) {
+    MpscQueue<Item, PushBeforeStub> queue;
+    Item a(0, 0), b(1, 0);
+    queue.push(&a);
+    PushBeforeStub::node = &b;
+    EXPECT_EQ(queue.pop(), &a);
+    // b is queued ahead of the stub, which is the node pushed last.
+    EXPECT_FALSE(queue.empty());
+    EXPECT_EQ(queue.pop(), &b);
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.pop(), nullptr);
+}
+
+TEST(MpscQueueTest, MultiProducer) {
+    constexpr int kProducers = 4;
+    constexpr int kItems = 100000;
+    MpscQueue<Item> queue;
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&queue, p] {
+            for (int i = 0; i < kItems; ++i) {
+                queue.push(new Item(p, i));
+            }
+        });
+    }
+    std::vector<int> next(kProducers, 0);
+    int total = 0;
+    while (total < kProducers * kItems) {
+        std::unique_ptr<Item> item(queue.pop());
+        if (!item) {
+            std::this_thread::yield();
+            continue;
+        }
+        // each producer's items come out in the order it pushed them.
+        ASSERT_EQ(item->seq, next[item->producer]);
+        ++next[item->producer];
+        ++total;
+    }
+    for (auto &producer: producers) {
+        producer.join();
+    }
+    EXPECT_EQ(queue.pop(), nullptr);
+}
@@ -0,0 +1,78 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#include "gg_lib/ShmRing.h"
+#include "gg_lib/Logging.h"
+
+#include <gtest/gtest.h>
+#include <string.h>
+#include <unistd.h>
+
+using namespace gg_lib;
+
+namespace {
+    string ringName(const char *test) {
+        return fmt::format("/gg_lib_{}_{}", test, ::getpid());
+    }
+}
+
+TEST(ShmRingTest, WrapsContiguously) {
+    const string name = ringName("wrap");
+    std::unique_ptr<ShmRing> producer = ShmRing::create(name, 5000);
+    ASSERT_TRUE(producer);
+    std::unique_ptr<ShmRing> consumer = ShmRing::open(name);
+    ShmRing::unlink(name);
+    ASSERT_TRUE(consumer);
+    EXPECT_EQ(producer->capacity(), 8192u);
+    EXPECT_EQ(consumer->capacity(), 8192u);
+
+    const string first(6000, 'a');
+    bool wake = false;
+    ASSERT_TRUE(producer->append(first.data(), first.size(), &wake));
+    ASSERT_EQ(consumer->readableBytes(), first.size());
+    consumer->retrieve(first.size());
+
+    // runs over the end of the data pages, and is read back in one piece.
+    string second(6000, 'b');
+    second.back() = 'z';
+    ASSERT_TRUE(producer->append(second.data(), second.size(), &wake));
+    ASSERT_EQ(consumer->readableBytes(), second.size());
+    EXPECT_EQ(string(consumer->peek(), second.size()), second);
+
+    // 2192 bytes are left.
+    EXPECT_FALSE(producer->append(first.data(), 2193, &wake));
+    EXPECT_TRUE(producer->append(first.data(), 2192, &wake));
+    EXPECT_EQ(producer->writableBytes(), 0u);
+    consumer->retrieve(second.size());
+    EXPECT_EQ(producer->writableBytes(), second.size());
+}
+
+TEST(ShmRingTest, WakesOnlyWaitingConsumer) {
+    const string name = ringName("wake");
+    std::unique_ptr<ShmRing> producer = ShmRing::create(name, 4096);
+    std::unique_ptr<ShmRing> consumer = ShmRing::open(name);
+    ShmRing::unlink(name);
+    ASSERT_TRUE(producer && consumer);
+
+    bool wake = true;
+    ASSERT_TRUE(producer->append("x", 1, &wake));
+    EXPECT_FALSE(wake);
+    // the byte must be read before sleeping.
+    EXPECT_FALSE(consumer->prepareWait());
+    ASSERT_EQ(consumer->readableBytes(), 1u);
+    consumer->retrieve(1);
+
+    EXPECT_TRUE(consumer->prepareWait());
+    ASSERT_TRUE(producer->append("y", 1, &wake));
+    EXPECT_TRUE(wake);
+    // woken once.
+    ASSERT_TRUE(producer->append("z", 1, &wake));
+    EXPECT_FALSE(wake);
+    EXPECT_EQ(consumer->readableBytes(), 2u);
+}
+
+TEST(ShmRingTest, OpenMissing) {
+    Logger::setLogLevel(Logger::FATAL);
+    EXPECT_FALSE(ShmRing::open(ringName("missing")));
+    Logger::setLogLevel(Logger::INFO);
+}
@@ -0,0 +1,79 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#include "gg_lib/SlabPool.h"
+
+#include <gtest/gtest.h>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace gg_lib;
+
+namespace {
+    struct Object {
+        explicit Object(int v) : value(v) { ++alive; }
+
+        ~Object() { --alive; }
+
+        static int alive;
+        int value;
+        char payload[100];
+    };
+
+    int Object::alive = 0;
+}
+
+TEST(SlabPoolTest, Reuse) {
+    SlabPool pool(4);
+    std::vector<void *> blocks;
+    for (int i = 0; i < 6; ++i) {
+        blocks.push_back(pool.allocate(40));
+    }
+    EXPECT_EQ(pool.blockSize(), 48u);
+    EXPECT_EQ(pool.numSlabs(), 2u);
+    EXPECT_EQ(std::set<void *>(blocks.begin(), blocks.end()).size(), blocks.size());
+    // larger than the block size, from operator new.
+    void *large = pool.allocate(1000);
+    pool.deallocate(large, 1000);
+
+    for (void *p: blocks) {
+        pool.deallocate(p, 40);
+    }
+    std::set<void *> reused;
+    for (int i = 0; i < 6; ++i) {
+        reused.insert(pool.allocate(40));
+    }
+    EXPECT_EQ(reused, std::set<void *>(blocks.begin(), blocks.end()));
+    EXPECT_EQ(pool.numSlabs(), 2u);
+}
+
+TEST(SlabPoolTest, AllocateShared) {
+    auto pool = std::make_shared<SlabPool>(16);
+    std::vector<std::shared_ptr<Object>> objects;
+    for (int i = 0; i < 100; ++i) {
+        objects.push_back(std::allocate_shared<Object>(SlabAllocator<Object>(pool), i));
+    }
+    EXPECT_EQ(Object::alive, 100);
+    size_t slabs = pool->numSlabs();
+    EXPECT_EQ(slabs, 7u);
+
+    // the last owners go away in another thread.
+    std::weak_ptr<Object> weak = objects.front();
+    std::thread releaser([&objects] { objects.clear(); });
+    releaser.join();
+    EXPECT_EQ(Object::alive, 0);
+    EXPECT_TRUE(weak.expired());
+    weak.reset();
+    for (int i = 0; i < 100; ++i) {
+        objects.push_back(std::allocate_shared<Object>(SlabAllocator<Object>(pool), i));
+    }
+    EXPECT_EQ(pool->numSlabs(), slabs);
+
+    // the objects keep the pool alive.
+    std::weak_ptr<SlabPool> weakPool = pool;
+    pool.reset();
+    EXPECT_FALSE(weakPool.expired());
+    objects.clear();
+    EXPECT_TRUE(weakPool.expired());
+}
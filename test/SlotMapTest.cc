@@ -0,0 +1,69 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#include "gg_lib/SlotMap.h"
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+using namespace gg_lib;
+
+TEST(SlotMapTest, InsertFindErase) {
+    SlotMap<int> map;
+    EXPECT_TRUE(map.empty());
+    auto a = map.insert(1);
+    auto b = map.insert(2);
+    EXPECT_NE(a, b);
+    EXPECT_EQ(map.size(), 2u);
+    ASSERT_NE(map.find(a), nullptr);
+    EXPECT_EQ(*map.find(a), 1);
+    EXPECT_EQ(*map.find(b), 2);
+
+    EXPECT_TRUE(map.erase(a));
+    EXPECT_FALSE(map.erase(a));
+    EXPECT_EQ(map.find(a), nullptr);
+    EXPECT_EQ(map.size(), 1u);
+
+    // the slot is reused, the stale key still finds nothing.
+    auto c = map.insert(3);
+    EXPECT_EQ(static_cast<uint32_t>(c), static_cast<uint32_t>(a));
+    EXPECT_NE(c, a);
+    EXPECT_EQ(map.find(a), nullptr);
+    EXPECT_EQ(*map.find(c), 3);
+}
+
+TEST(SlotMapTest, Tag) {
+    SlotMap<int> first(1);
+    SlotMap<int> second(2);
+    auto a = first.insert(1);
+    auto b = second.insert(2);
+    EXPECT_EQ(SlotMap<int>::tagOf(a), 1);
+    EXPECT_EQ(SlotMap<int>::tagOf(b), 2);
+    // same index and generation, other map.
+    EXPECT_EQ(second.find(a), nullptr);
+    EXPECT_FALSE(second.erase(a));
+    EXPECT_EQ(*first.find(a), 1);
+}
+
+TEST(SlotMapTest, ForEachClear) {
+    SlotMap<std::shared_ptr<int>> map;
+    std::vector<SlotMap<std::shared_ptr<int>>::Key> keys;
+    for (int i = 0; i < 10; ++i) {
+        keys.push_back(map.insert(std::make_shared<int>(i)));
+    }
+    auto held = *map.find(keys[3]);
+    for (int i = 0; i < 10; i += 2) {
+        map.erase(keys[i]);
+    }
+    int sum = 0;
+    map.forEach([&sum](std::shared_ptr<int> &v) { sum += *v; });
+    EXPECT_EQ(sum, 1 + 3 + 5 + 7 + 9);
+
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(held.use_count(), 1);
+    for (auto key: keys) {
+        EXPECT_EQ(map.find(key), nullptr);
+    }
+}
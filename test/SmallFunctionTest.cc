@@ -0,0 +1,77 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#include "gg_lib/SmallFunction.h"
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+
+using namespace gg_lib;
+
+namespace {
+    /// Counts live copies, so that leaks and double destruction show up.
+    struct Counted {
+        explicit Counted(int *live) : live_(live) { ++*live_; }
+
+        Counted(const Counted &rhs) : live_(rhs.live_) { ++*live_; }
+
+        ~Counted() { --*live_; }
+
+        int *live_;
+    };
+
+    int add(int a, int b) { return a + b; }
+}
+
+TEST(SmallFunctionTest, Empty) {
+    SmallFunction<void()> f;
+    EXPECT_FALSE(f);
+    SmallFunction<void()> g(nullptr);
+    EXPECT_FALSE(g);
+    int (*nullFn)(int, int) = nullptr;
+    SmallFunction<int(int, int)> h(nullFn);
+    EXPECT_FALSE(h);
+    SmallFunction<void()> i{std::function<void()>()};
+    EXPECT_FALSE(i);
+}
+
+TEST(SmallFunctionTest, Call) {
+    SmallFunction<int(int, int)> f(add);
+    EXPECT_EQ(f(1, 2), 3);
+    int base = 10;
+    f = [base](int a, int b) { return base + a + b; };
+    EXPECT_EQ(f(1, 2), 13);
+    std::string str;
+    SmallFunction<void(const std::string &)> g([&str](const std::string &s) { str += s; });
+    g("ab");
+    g("c");
+    EXPECT_EQ(str, "abc");
+}
+
+TEST(SmallFunctionTest, MoveOnly) {
+    std::unique_ptr<int> value(new int(42));
+    SmallFunction<int()> f(std::bind([](std::unique_ptr<int> &p) { return *p; }, std::move(value)));
+    SmallFunction<int()> g(std::move(f));
+    EXPECT_FALSE(f);
+    EXPECT_EQ(g(), 42);
+}
+
+TEST(SmallFunctionTest, Lifetime) {
+    int live = 0;
+    {
+        Counted small(&live);
+        char large[256] = {};
+        SmallFunction<size_t()> inlined([small] { return sizeof small; });
+        SmallFunction<size_t()> allocated([small, large] { return sizeof large; });
+        EXPECT_EQ(live, 3);
+        SmallFunction<size_t()> moved(std::move(allocated));
+        EXPECT_EQ(moved(), 256);
+        inlined.swap(moved);
+        EXPECT_EQ(inlined(), 256);
+        EXPECT_EQ(moved(), sizeof(Counted));
+        moved = nullptr;
+        EXPECT_EQ(live, 2);
+    }
+    EXPECT_EQ(live, 0);
+}
@@ -6,6 +6,7 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 #include <string>
+#include <unistd.h>
 
 using namespace gg_lib;
 using namespace gg_lib::net;
@@ -156,3 +157,61 @@ TEST(BufferTest, BufferFmt) {
     buf.append(Fmt("{}{}{}", "AA", "BB", 1));
     EXPECT_EQ(buf.retrieveAllAsString(), "1-2AABB1");
 }
+
+TEST(BufferTest, BufferLazy) {
+    Buffer buf(Buffer::kLazy);
+    EXPECT_FALSE(buf.hasStorage());
+    EXPECT_EQ(buf.internalCapacity(), 0);
+    EXPECT_EQ(buf.readableBytes(), 0);
+    EXPECT_EQ(buf.writableBytes(), 0);
+    buf.retrieveAll();
+    EXPECT_FALSE(buf.hasStorage());
+
+    buf.append("hello", 5);
+    EXPECT_TRUE(buf.hasStorage());
+    EXPECT_EQ(buf.prependableBytes(), kCheapPrepend);
+    EXPECT_EQ(buf.writableBytes(), kInitialSize - 5);
+    buf.prependInt8(1);
+    EXPECT_EQ(buf.readInt8(), 1);
+    EXPECT_EQ(buf.retrieveAllAsString(), "hello");
+
+    // the released storage is reused by the next buffer of this thread.
+    const void *storage = buf.peek() - kCheapPrepend;
+    buf.release();
+    EXPECT_FALSE(buf.hasStorage());
+    Buffer other(Buffer::kLazy);
+    other.append("x", 1);
+    EXPECT_EQ(other.peek() - kCheapPrepend, storage);
+}
+
+TEST(BufferTest, BufferLazyReadFd) {
+    int fds[2];
+    ASSERT_EQ(::pipe(fds), 0);
+    Buffer buf(Buffer::kLazy);
+    buf.append("x", 1);
+    const void *storage = buf.peek() - kCheapPrepend;
+    buf.retrieveAll();
+    buf.release();
+    EXPECT_EQ(buf.readFdCapacity(), kInitialSize + Buffer::kExtraReadSize);
+
+    // read into the pooled storage taken first.
+    ASSERT_EQ(::write(fds[1], "hello", 5), 5);
+    int savedErrno = 0;
+    EXPECT_EQ(buf.readFd(fds[0], &savedErrno), 5);
+    EXPECT_EQ(buf.peek() - kCheapPrepend, storage);
+    EXPECT_EQ(buf.retrieveAllAsString(), "hello");
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+
+TEST(BufferTest, BufferReleaseLarge) {
+    Buffer buf(Buffer::kLazy);
+    buf.append(string(4 * 1024 * 1024, 'x'));
+    buf.retrieveAll();
+    // grown storage is freed rather than kept in the pool.
+    buf.release();
+    EXPECT_FALSE(buf.hasStorage());
+    Buffer other(Buffer::kLazy);
+    other.append("x", 1);
+    EXPECT_LE(other.internalCapacity(), kCheapPrepend + Buffer::kExtraReadSize);
+}
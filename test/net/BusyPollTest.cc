@@ -0,0 +1,52 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#include "gg_lib/net/EventLoop.h"
+#include "gg_lib/Logging.h"
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace gg_lib;
+using namespace gg_lib::net;
+
+TEST(BusyPollTest, SpinThenBlock) {
+    Logger::setLogLevel(Logger::WARN);
+    EventLoop loop;
+    loop.setBusyPoll(20 * 1000);
+    int ran = 0;
+    EventLoop::Stats spun{};
+    std::thread producer([&] {
+        // while spinning, then after the loop went back to blocking.
+        for (int i = 0; i < 10; ++i) {
+            loop.queueInLoop([&ran] { ++ran; });
+            ::usleep(1000);
+        }
+        ::usleep(100 * 1000);
+        loop.queueInLoop([&] {
+            spun = loop.stats();
+            ++ran;
+        });
+        ::usleep(100 * 1000);
+        loop.queueInLoop([&loop] { loop.quit(); });
+    });
+    loop.loop();
+    producer.join();
+
+    EXPECT_EQ(ran, 11);
+    EXPECT_GT(spun.emptySpins, 0);
+    EXPECT_GT(spun.spinMicroSeconds, 10 * 1000);
+    // spun for about 20ms after each burst, then blocked.
+    EXPECT_LT(spun.spinMicroSeconds, 80 * 1000);
+    EventLoop::Stats end = loop.stats();
+    EXPECT_LT(end.spinMicroSeconds - spun.spinMicroSeconds, 40 * 1000);
+}
+
+TEST(BusyPollTest, Off) {
+    EventLoop loop;
+    loop.runAfter(0.02, [&loop] { loop.quit(); });
+    loop.loop();
+    EXPECT_EQ(loop.stats().emptySpins, 0);
+    EXPECT_EQ(loop.stats().spinMicroSeconds, 0);
+}
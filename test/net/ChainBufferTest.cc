@@ -0,0 +1,193 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#include "gg_lib/net/ChainBuffer.h"
+#include "gg_lib/net/Buffer.h"
+
+#include <gtest/gtest.h>
+#include <string>
+#include <unistd.h>
+
+using namespace gg_lib;
+using namespace gg_lib::net;
+
+static string makePattern(size_t len) {
+    string str(len, '\0');
+    for (size_t i = 0; i < len; ++i) {
+        str[i] = static_cast<char>('a' + i % 26);
+    }
+    return str;
+}
+
+TEST(ChainBufferTest, AppendRetrieve) {
+    ChainBuffer buf;
+    EXPECT_EQ(buf.readableBytes(), 0);
+    EXPECT_EQ(buf.numBlocks(), 0);
+    EXPECT_EQ(buf.peek(), nullptr);
+
+    const string str(200, 'x');
+    buf.append(str);
+    EXPECT_EQ(buf.readableBytes(), str.size());
+    EXPECT_EQ(buf.peekableBytes(), str.size());
+    EXPECT_EQ(buf.numBlocks(), 1);
+
+    const string str2 = buf.retrieveAsString(50);
+    EXPECT_EQ(str2, string(50, 'x'));
+    EXPECT_EQ(buf.readableBytes(), str.size() - str2.size());
+
+    buf.append(str);
+    EXPECT_EQ(buf.readableBytes(), 2 * str.size() - str2.size());
+
+    const string str3 = buf.retrieveAllAsString();
+    EXPECT_EQ(str3, string(350, 'x'));
+    EXPECT_EQ(buf.readableBytes(), 0);
+    EXPECT_EQ(buf.numBlocks(), 0);
+}
+
+TEST(ChainBufferTest, AppendNeverMoves) {
+    ChainBuffer buf;
+    buf.append(string(100, 'y'));
+    const char *first = buf.peek();
+    const string large = makePattern(5 * ChainBuffer::kBlockSize);
+    buf.append(large);
+    EXPECT_EQ(buf.peek(), first);
+    EXPECT_EQ(buf.readableBytes(), 100 + large.size());
+    EXPECT_EQ(buf.numBlocks(), 6);
+    EXPECT_LT(buf.peekableBytes(), buf.readableBytes());
+
+    buf.retrieve(100);
+    EXPECT_EQ(buf.retrieveAllAsString(), large);
+}
+
+TEST(ChainBufferTest, RetrieveAcrossBlocks) {
+    ChainBuffer buf;
+    const string data = makePattern(3 * ChainBuffer::kBlockSize);
+    buf.append(data);
+    size_t blocks = buf.numBlocks();
+
+    buf.retrieve(buf.peekableBytes());
+    EXPECT_EQ(buf.numBlocks(), blocks - 1);
+    size_t retrieved = data.size() - buf.readableBytes();
+    EXPECT_EQ(string(buf.peek(), 10), data.substr(retrieved, 10));
+
+    string rest = buf.retrieveAsString(buf.readableBytes() - 1);
+    EXPECT_EQ(rest, data.substr(retrieved, data.size() - retrieved - 1));
+    EXPECT_EQ(buf.readableBytes(), 1);
+    EXPECT_EQ(*buf.peek(), data.back());
+}
+
+TEST(ChainBufferTest, FillIovec) {
+    ChainBuffer buf;
+    const string data = makePattern(4 * ChainBuffer::kBlockSize);
+    buf.append(data);
+
+    struct iovec vec[2];
+    EXPECT_EQ(buf.fillIovec(vec, 2), 2);
+    EXPECT_EQ(vec[0].iov_base, buf.peek());
+    EXPECT_EQ(vec[0].iov_len, buf.peekableBytes());
+
+    struct iovec all[ChainBuffer::kMaxIovec];
+    int iovcnt = buf.fillIovec(all, ChainBuffer::kMaxIovec);
+    EXPECT_EQ(static_cast<size_t>(iovcnt), buf.numBlocks());
+    string joined;
+    for (int i = 0; i < iovcnt; ++i) {
+        joined.append(static_cast<const char *>(all[i].iov_base), all[i].iov_len);
+    }
+    EXPECT_EQ(joined, data);
+}
+
+TEST(ChainBufferTest, Move) {
+    ChainBuffer buf;
+    buf.append(string(1000, 'z'));
+    ChainBuffer other(std::move(buf));
+    EXPECT_EQ(buf.readableBytes(), 0);
+    EXPECT_EQ(other.readableBytes(), 1000);
+
+    buf.append("abc", 3);
+    buf = std::move(other);
+    EXPECT_EQ(buf.retrieveAllAsString(), string(1000, 'z'));
+}
+
+TEST(ChainBufferTest, AppendSlice) {
+    ChainBuffer buf;
+    auto body = std::make_shared<string>(makePattern(10000));
+    buf.append("header", 6);
+    buf.appendSlice(*body, body);
+    EXPECT_EQ(body.use_count(), 2);
+    buf.append("trailer", 7);
+    EXPECT_EQ(buf.numBlocks(), 3);
+
+    struct iovec vec[ChainBuffer::kMaxIovec];
+    EXPECT_EQ(buf.fillIovec(vec, ChainBuffer::kMaxIovec), 3);
+    EXPECT_EQ(vec[1].iov_base, body->data());
+
+    buf.retrieve(6 + 100);
+    EXPECT_EQ(buf.peek(), body->data() + 100);
+    EXPECT_EQ(buf.retrieveAsString(body->size() - 100), body->substr(100));
+    EXPECT_EQ(body.use_count(), 1);
+    EXPECT_EQ(buf.retrieveAllAsString(), "trailer");
+
+    const string small(10, 's');
+    buf.appendSlice(small, nullptr);
+    EXPECT_NE(buf.peek(), small.data());
+    EXPECT_EQ(buf.retrieveAllAsString(), small);
+}
+
+TEST(ChainBufferTest, AppendBuffer) {
+    const string data = makePattern(5000);
+    Buffer buffer;
+    buffer.append(data);
+    const char *bytes = buffer.peek();
+
+    ChainBuffer buf;
+    buf.append(std::move(buffer));
+    EXPECT_EQ(buffer.readableBytes(), 0);
+    EXPECT_EQ(buf.peek(), bytes);
+    buffer.append("reused", 6);
+    EXPECT_EQ(buf.retrieveAllAsString(), data);
+}
+
+TEST(ChainBufferTest, AppendChain) {
+    ChainBuffer buf;
+    ChainBuffer other;
+    buf.append(std::move(other));
+    EXPECT_EQ(buf.readableBytes(), 0);
+
+    other.append("world", 5);
+    buf.append(std::move(other));
+    EXPECT_EQ(other.readableBytes(), 0);
+    EXPECT_EQ(other.numBlocks(), 0);
+
+    other.append("hello ", 6);
+    other.append(std::move(buf));
+    other.append("!", 1);
+    EXPECT_EQ(other.retrieveAllAsString(), "hello world!");
+}
+
+TEST(ChainBufferTest, ReadWriteFd) {
+    int fds[2];
+    ASSERT_EQ(::pipe(fds), 0);
+    const string data = makePattern(40000);
+
+    ChainBuffer out;
+    out.append("hello", 5);
+    out.append(data);
+    int savedErrno = 0;
+    ssize_t n = out.writeFd(fds[1], &savedErrno);
+    ASSERT_EQ(n, static_cast<ssize_t>(data.size() + 5));
+    EXPECT_EQ(out.readableBytes(), 0);
+
+    ChainBuffer in;
+    in.append("x", 1);
+    size_t total = 0;
+    while (total < data.size() + 5) {
+        n = in.readFd(fds[0], &savedErrno);
+        ASSERT_GT(n, 0);
+        total += static_cast<size_t>(n);
+    }
+    EXPECT_EQ(in.readableBytes(), total + 1);
+    EXPECT_EQ(in.retrieveAllAsString(), "xhello" + data);
+
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
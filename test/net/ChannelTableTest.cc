@@ -0,0 +1,60 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#include "gg_lib/net/ChannelTable.h"
+#include "gg_lib/net/Channel.h"
+#include "gg_lib/net/EventLoop.h"
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+using namespace gg_lib;
+using namespace gg_lib::net;
+
+TEST(ChannelTableTest, InsertFindErase) {
+    EventLoop loop;
+    Channel low(&loop, 3);
+    Channel high(&loop, 1000);
+    ChannelTable table;
+    EXPECT_TRUE(table.empty());
+    EXPECT_EQ(table.find(3), nullptr);
+    EXPECT_EQ(table.find(-1), nullptr);
+
+    table.insert(3, &low);
+    // grows past the initial slots.
+    table.insert(1000, &high);
+    EXPECT_EQ(table.size(), 2u);
+    EXPECT_EQ(table.find(3), &low);
+    EXPECT_EQ(table.find(1000), &high);
+    EXPECT_EQ(table.find(4), nullptr);
+    EXPECT_EQ(table.find(1 << 20), nullptr);
+
+    table.erase(3);
+    EXPECT_FALSE(table.contains(3));
+    EXPECT_TRUE(table.contains(1000));
+    // fds are reused once closed.
+    table.insert(3, &high);
+    EXPECT_EQ(table.find(3), &high);
+    table.erase(3);
+    table.erase(1000);
+    EXPECT_TRUE(table.empty());
+}
+
+TEST(ChannelTableTest, ManyChannels) {
+    EventLoop loop;
+    constexpr int kChannels = 100000;
+    std::vector<std::unique_ptr<Channel>> channels;
+    ChannelTable table;
+    for (int fd = 0; fd < kChannels; ++fd) {
+        channels.emplace_back(new Channel(&loop, fd));
+        table.insert(fd, channels.back().get());
+    }
+    EXPECT_EQ(table.size(), static_cast<size_t>(kChannels));
+    for (int fd = 0; fd < kChannels; fd += 2) {
+        table.erase(fd);
+    }
+    for (int fd = 0; fd < kChannels; ++fd) {
+        EXPECT_EQ(table.find(fd), fd % 2 ? channels[fd].get() : nullptr);
+    }
+}
@@ -0,0 +1,108 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#include <benchmark/benchmark.h>
+#include "gg_lib/net/EventLoop.h"
+#include "gg_lib/net/EventLoopThread.h"
+#include "gg_lib/net/TcpServer.h"
+#include "gg_lib/CountDownLatch.h"
+#include "gg_lib/Logging.h"
+#include "TestUtils.h"
+
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace gg_lib;
+using namespace gg_lib::net;
+
+namespace {
+    constexpr size_t kRequestSize = 64;
+
+    enum Mode {
+        kDefault,
+        kDeferAccept,
+        kDeferAcceptFastOpen,
+    };
+
+    /// One connection per iteration: a blocking client connects, sends a request and
+    /// reads the reply until the server closes. The server closes first and keeps the
+    /// TIME_WAIT, so the client doesn't run out of ports.
+    void runConnections(benchmark::State &state, Mode mode) {
+        Logger::setLogLevel(Logger::WARN);
+        const InetAddress serverAddr(freePort(), true);
+        EventLoopThread thread;
+        EventLoop *loop = thread.startLoop();
+        std::unique_ptr<TcpServer> server;
+        CountDownLatch started(1);
+        loop->runInLoop([&] {
+            server.reset(new TcpServer(loop, serverAddr, "ConnServer"));
+            if (mode == kDefault) {
+                server->setConnectionCallback([](const TcpConnectionPtr &conn) {
+                    if (conn->connected()) {
+                        conn->setTcpNoDelay(true);
+                    }
+                });
+            } else {
+                server->setTcpNoDelay(true);
+                server->setDeferAccept(1);
+                if (mode == kDeferAcceptFastOpen) {
+                    server->setFastOpen(256);
+                }
+            }
+            server->setMessageCallback([](const TcpConnectionPtr &conn, Buffer *buf, Timestamp) {
+                conn->send(buf);
+                conn->shutdown();
+            });
+            server->start();
+            started.countDown();
+        });
+        started.wait();
+
+        char request[kRequestSize] = {};
+        char reply[kRequestSize * 2];
+        for (auto _: state) {
+            int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, IPPROTO_TCP);
+            if (mode == kDeferAcceptFastOpen) {
+                // connect(2) returns at once, the first write carries the request in the SYN.
+                int on = 1;
+                ::setsockopt(fd, IPPROTO_TCP, TCP_FASTOPEN_CONNECT, &on, sizeof on);
+            }
+            if (sockets::connect(fd, serverAddr.getSockAddr()) < 0 ||
+                ::write(fd, request, sizeof request) != sizeof request) {
+                state.SkipWithError("connect");
+                ::close(fd);
+                break;
+            }
+            while (::read(fd, reply, sizeof reply) > 0) {}
+            ::close(fd);
+        }
+        state.SetItemsProcessed(state.iterations());
+
+        CountDownLatch stopped(1);
+        loop->runInLoop([&] {
+            server.reset();
+            stopped.countDown();
+        });
+        stopped.wait();
+    }
+}
+
+static void BM_ConnectDefault(benchmark::State &state) {
+    runConnections(state, kDefault);
+}
+
+static void BM_ConnectDeferAccept(benchmark::State &state) {
+    runConnections(state, kDeferAccept);
+}
+
+/// The client gets its cookie in the first iteration, needs net.ipv4.tcp_fastopen = 3.
+static void BM_ConnectDeferAcceptFastOpen(benchmark::State &state) {
+    runConnections(state, kDeferAcceptFastOpen);
+}
+
+BENCHMARK(BM_ConnectDefault)->UseRealTime()->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ConnectDeferAccept)->UseRealTime()->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ConnectDeferAcceptFastOpen)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -60,5 +60,25 @@ int main() {
         assert(nextLoop == model.getNextLoop());
     }
 
+    {
+        LOG_INFO << "Least connections";
+        EventLoopThreadPool model(&loop, "least");
+        model.setThreadNum(3);
+        model.setPlacementPolicy(kLeastConnections);
+        model.start(init);
+        EventLoop *busyLoop = model.getNextLoop();
+        busyLoop->updateConnectionCount(2);
+        EventLoop *first = model.getNextLoop();
+        EventLoop *second = model.getNextLoop();
+        assert(first != busyLoop && second != busyLoop && first != second);
+        first->updateConnectionCount(1);
+        second->updateConnectionCount(1);
+        first->updateConnectionCount(1);
+        assert(model.getNextLoop() == second);
+        busyLoop->updateConnectionCount(-2);
+        first->updateConnectionCount(-2);
+        second->updateConnectionCount(-1);
+    }
+
     loop.loop();
 }
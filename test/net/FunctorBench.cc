@@ -0,0 +1,122 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#include <benchmark/benchmark.h>
+#include "gg_lib/net/TcpConnection.h"
+#include "gg_lib/net/EventLoop.h"
+#include "gg_lib/net/EventLoopThread.h"
+#include "gg_lib/Logging.h"
+#include "gg_lib/CountDownLatch.h"
+
+#include <stdlib.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace gg_lib;
+using namespace gg_lib::net;
+
+// Count heap allocations of the whole process.
+static std::atomic<int64_t> g_allocations(0);
+
+void *operator new(size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    void *p = ::malloc(size ? size : 1);
+    if (!p) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void *p) noexcept {
+    ::free(p);
+}
+
+void operator delete(void *p, size_t) noexcept {
+    ::free(p);
+}
+
+namespace {
+    struct Sink {
+        void sendInLoop(const string_view &message) {
+            benchmark::DoNotOptimize(message.data());
+        }
+    };
+
+    /// The payload of a cross-thread TcpConnection::send(string&&):
+    /// a member function bound to a shared_ptr and a string.
+    template<typename Function>
+    void runWrap(benchmark::State &state) {
+        auto sink = std::make_shared<Sink>();
+        void (Sink::*fp)(const string_view &) = &Sink::sendInLoop;
+        const string message(static_cast<size_t>(state.range(0)), 'x');
+        int64_t allocations = 0;
+        for (auto _: state) {
+            string copy(message);
+            int64_t before = g_allocations.load(std::memory_order_relaxed);
+            Function f(std::bind(fp, sink, std::move(copy)));
+            allocations += g_allocations.load(std::memory_order_relaxed) - before;
+            f();
+        }
+        state.counters["allocs_per_op"] = benchmark::Counter(
+                static_cast<double>(allocations), benchmark::Counter::kAvgIterations);
+    }
+}
+
+static void BM_StdFunctionWrap(benchmark::State &state) {
+    runWrap<std::function<void()>>(state);
+}
+
+static void BM_SmallFunctionWrap(benchmark::State &state) {
+    runWrap<SmallFunction<void()>>(state);
+}
+
+/// Allocations of TcpConnection::send(string&&) called outside the loop thread,
+/// the message fits in the small string buffer so only the send path allocates.
+static void BM_CrossThreadSend(benchmark::State &state) {
+    Logger::setLogLevel(Logger::WARN);
+    int fds[2];
+    ::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0, fds);
+    EventLoopThread loopThread;
+    EventLoop *loop = loopThread.startLoop();
+    auto conn = std::make_shared<TcpConnection>(loop, "bench", fds[0], InetAddress(), InetAddress());
+    conn->setConnectionCallback(defaultConnectionCallback);
+    conn->setMessageCallback(defaultMessageCallback);
+    conn->setCloseCallback([](const TcpConnectionPtr &) {});
+    CountDownLatch established(1);
+    loop->runInLoop([&conn, &established] {
+        conn->connectEstablished();
+        established.countDown();
+    });
+    established.wait();
+    std::atomic<bool> done(false);
+    std::thread drainer([&] {
+        char buf[65536];
+        while (!done) {
+            if (::read(fds[1], buf, sizeof buf) < 0) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    int64_t allocations = 0;
+    for (auto _: state) {
+        string message("ping\r\n");
+        int64_t before = g_allocations.load(std::memory_order_relaxed);
+        conn->send(std::move(message));
+        allocations += g_allocations.load(std::memory_order_relaxed) - before;
+    }
+    state.counters["allocs_per_send"] = benchmark::Counter(
+            static_cast<double>(allocations), benchmark::Counter::kAvgIterations);
+
+    loop->runInLoop(std::bind(&TcpConnection::connectDestroyed, conn));
+    done = true;
+    drainer.join();
+    ::close(fds[1]);
+}
+
+BENCHMARK(BM_StdFunctionWrap)->Arg(8)->Arg(256);
+BENCHMARK(BM_SmallFunctionWrap)->Arg(8)->Arg(256);
+BENCHMARK(BM_CrossThreadSend);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,97 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#include <benchmark/benchmark.h>
+#include "gg_lib/net/EventLoop.h"
+#include "gg_lib/net/TcpConnection.h"
+#include "gg_lib/Logging.h"
+
+#include <malloc.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace gg_lib;
+using namespace gg_lib::net;
+
+namespace {
+    /// Heap bytes in use by this thread's arena.
+    size_t heapInUse() {
+        return mallinfo2().uordblks;
+    }
+
+    /// Every iteration opens range(0) connections, each receives one message of
+    /// messageSize and then idles, the heap grown meanwhile is reported per connection.
+    void runIdle(benchmark::State &state, size_t messageSize, bool retain) {
+        Logger::setLogLevel(Logger::WARN);
+        const int numConns = static_cast<int>(state.range(0));
+        const string message(messageSize, 'x');
+        EventLoop loop;
+        double bytesPerConn = 0;
+        for (auto _: state) {
+            const size_t heapBefore = heapInUse();
+            std::vector<TcpConnectionPtr> conns;
+            std::vector<int> peers;
+            int received = 0;
+            for (int i = 0; i < numConns; ++i) {
+                int fds[2];
+                if (::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0, fds) < 0) {
+                    LOG_SYSFATAL << "socketpair";
+                }
+                auto conn = std::make_shared<TcpConnection>(&loop, "idle", fds[0], InetAddress(), InetAddress());
+                conn->setConnectionCallback([](const TcpConnectionPtr &) {});
+                conn->setMessageCallback([&](const TcpConnectionPtr &, Buffer *buf, Timestamp) {
+                    if (buf->readableBytes() < messageSize) {
+                        return;
+                    }
+                    if (!retain) {
+                        buf->retrieveAll();
+                    }
+                    if (++received == numConns) {
+                        loop.quit();
+                    }
+                });
+                conn->connectEstablished();
+                conns.push_back(conn);
+                peers.push_back(fds[1]);
+                if (::write(fds[1], message.data(), message.size()) != static_cast<ssize_t>(message.size())) {
+                    LOG_SYSFATAL << "write";
+                }
+            }
+            loop.loop();
+            bytesPerConn = static_cast<double>(heapInUse() - heapBefore) / numConns;
+
+            state.PauseTiming();
+            for (auto &conn: conns) {
+                conn->connectDestroyed();
+            }
+            conns.clear();
+            for (int fd: peers) {
+                ::close(fd);
+            }
+            state.ResumeTiming();
+        }
+        state.counters["heap_bytes/conn"] = bytesPerConn;
+    }
+}
+
+/// The input buffer goes back to the pool once drained.
+static void BM_IdleAfterSmallMessage(benchmark::State &state) {
+    runIdle(state, 64, false);
+}
+
+/// A large message grows the input buffer, draining still gives it back.
+static void BM_IdleAfterLargeMessage(benchmark::State &state) {
+    runIdle(state, 60 * 1024, false);
+}
+
+/// Bytes left in the input buffer keep its storage, as every buffer did before.
+static void BM_IdleWithPendingBytes(benchmark::State &state) {
+    runIdle(state, 64, true);
+}
+
+BENCHMARK(BM_IdleAfterSmallMessage)->Arg(5000)->Iterations(3)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_IdleAfterLargeMessage)->Arg(1000)->Iterations(3)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_IdleWithPendingBytes)->Arg(5000)->Iterations(3)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
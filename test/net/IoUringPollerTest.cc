@@ -0,0 +1,147 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#include "gg_lib/net/EventLoop.h"
+#include "gg_lib/net/Channel.h"
+#include "gg_lib/Logging.h"
+
+#include <gtest/gtest.h>
+#include <fcntl.h>
+#include <memory>
+#include <stdlib.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace gg_lib;
+using namespace gg_lib::net;
+
+namespace {
+    /// A loop whose poller is IoUringPoller, null if the kernel doesn't support it.
+    std::unique_ptr<EventLoop> makeIoUringLoop() {
+        ::setenv("USE_IO_URING", "1", 1);
+        std::unique_ptr<EventLoop> loop(new EventLoop);
+        ::unsetenv("USE_IO_URING");
+        if (!loop->supportsCompletionIo()) {
+            loop.reset();
+        }
+        return loop;
+    }
+
+    void runFor(EventLoop *loop, double seconds) {
+        TimerId timeout = loop->runAfter(seconds, [loop] { loop->quit(); });
+        loop->loop();
+        loop->cancel(timeout);
+    }
+}
+
+TEST(IoUringPollerTest, OneShotRearm) {
+    Logger::setLogLevel(Logger::WARN);
+    std::unique_ptr<EventLoop> loop = makeIoUringLoop();
+    if (!loop) {
+        GTEST_SKIP() << "no io_uring";
+    }
+    int fds[2];
+    ASSERT_EQ(::pipe2(fds, O_NONBLOCK | O_CLOEXEC), 0);
+    Channel channel(loop.get(), fds[0]);
+    // one byte per event, the rest is only seen if the fired request is armed again.
+    string received;
+    channel.setReadCallback([&](Timestamp) {
+        char c;
+        if (::read(fds[0], &c, 1) == 1) {
+            received += c;
+        }
+        if (received.size() == 3) {
+            loop->quit();
+        }
+    });
+    channel.enableReading();
+    ASSERT_EQ(::write(fds[1], "abc", 3), 3);
+    runFor(loop.get(), 5.0);
+    EXPECT_EQ(received, "abc");
+
+    channel.disableAll();
+    channel.remove();
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+
+TEST(IoUringPollerTest, AddModifyRemove) {
+    Logger::setLogLevel(Logger::WARN);
+    std::unique_ptr<EventLoop> loop = makeIoUringLoop();
+    if (!loop) {
+        GTEST_SKIP() << "no io_uring";
+    }
+    int fds[2];
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0, fds), 0);
+    Channel channel(loop.get(), fds[0]);
+    int writes = 0;
+    int reads = 0;
+    channel.setWriteCallback([&] {
+        ++writes;
+        // replaces the armed POLLOUT request with a POLLIN one.
+        channel.disableWriting();
+        channel.enableReading();
+        ASSERT_EQ(::write(fds[1], "x", 1), 1);
+    });
+    channel.setReadCallback([&](Timestamp) {
+        ++reads;
+        char c;
+        EXPECT_EQ(::read(fds[0], &c, 1), 1);
+        loop->quit();
+    });
+
+    channel.enableWriting();
+    EXPECT_TRUE(loop->hasChannel(&channel));
+    runFor(loop.get(), 5.0);
+    EXPECT_EQ(writes, 1);
+    EXPECT_EQ(reads, 1);
+
+    // no interest left, readable data must not fire the channel.
+    channel.disableAll();
+    ASSERT_EQ(::write(fds[1], "y", 1), 1);
+    runFor(loop.get(), 0.05);
+    EXPECT_EQ(reads, 1);
+
+    // enabled again the pending byte shows up.
+    channel.enableReading();
+    runFor(loop.get(), 5.0);
+    EXPECT_EQ(reads, 2);
+
+    channel.disableAll();
+    channel.remove();
+    EXPECT_FALSE(loop->hasChannel(&channel));
+    ASSERT_EQ(::write(fds[1], "z", 1), 1);
+    runFor(loop.get(), 0.05);
+    EXPECT_EQ(reads, 2);
+    EXPECT_EQ(writes, 1);
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+
+TEST(IoUringPollerTest, TimerAndWakeup) {
+    Logger::setLogLevel(Logger::WARN);
+    std::unique_ptr<EventLoop> loop = makeIoUringLoop();
+    if (!loop) {
+        GTEST_SKIP() << "no io_uring";
+    }
+    Timestamp start = Timestamp::now();
+    double queuedAt = 0;
+    double firedAt = 0;
+    loop->runAfter(0.1, [&] {
+        firedAt = Timestamp::timeDuration(Timestamp::now(), start);
+        loop->quit();
+    });
+    // the loop blocks in io_uring_enter(2) until the wakeup fd becomes readable.
+    std::thread other([&] {
+        ::usleep(20 * 1000);
+        loop->queueInLoop([&] { queuedAt = Timestamp::timeDuration(Timestamp::now(), start); });
+    });
+    loop->loop();
+    other.join();
+
+    EXPECT_GT(queuedAt, 0.015);
+    EXPECT_LT(queuedAt, 0.09);
+    EXPECT_GE(firedAt, 0.09);
+    EXPECT_LT(firedAt, 1.0);
+}
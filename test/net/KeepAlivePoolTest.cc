@@ -0,0 +1,217 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#include "gg_lib/net/KeepAlivePool.h"
+#include "gg_lib/net/TcpServer.h"
+#include "gg_lib/net/EventLoop.h"
+#include "gg_lib/Logging.h"
+#include "TestUtils.h"
+
+#include <gtest/gtest.h>
+#include <string.h>
+#include <type_traits>
+#include <unistd.h>
+
+using namespace gg_lib;
+using namespace gg_lib::net;
+
+namespace {
+    /// Sends request over a connection of pool and calls done with the echo.
+    void call(KeepAlivePool *pool, const InetAddress &addr, const string &request,
+              const std::function<void(const string &)> &done) {
+        pool->acquire(addr, [pool, request, done](const TcpConnectionPtr &conn) {
+            if (!conn) {
+                done(string());
+                return;
+            }
+            conn->setMessageCallback([pool, request, done](const TcpConnectionPtr &c, Buffer *buf, Timestamp) {
+                if (buf->readableBytes() < request.size()) {
+                    return;
+                }
+                string response = buf->retrieveAllAsString();
+                pool->release(c);
+                done(response);
+            });
+            conn->send(request);
+        });
+    }
+}
+
+TEST(KeepAlivePoolTest, Reuse) {
+    Logger::setLogLevel(Logger::WARN);
+    EventLoop loop;
+    InetAddress serverAddr(freePort(), true);
+    TcpServer server(&loop, serverAddr, "EchoServer");
+    int accepted = 0;
+    server.setConnectionCallback([&accepted](const TcpConnectionPtr &conn) {
+        accepted += conn->connected();
+    });
+    server.setMessageCallback([](const TcpConnectionPtr &conn, Buffer *buf, Timestamp) {
+        conn->send(buf);
+    });
+    server.start();
+
+    KeepAlivePool pool(&loop, "Upstream");
+    std::vector<string> responses;
+    constexpr int kCalls = 10;
+    std::function<void(const string &)> next = [&](const string &response) {
+        responses.push_back(response);
+        if (responses.size() == kCalls) {
+            loop.quit();
+        } else {
+            call(&pool, serverAddr, "call" + std::to_string(responses.size()), next);
+        }
+    };
+    call(&pool, serverAddr, "call0", next);
+    loop.runAfter(5.0, [&loop] { loop.quit(); });
+    loop.loop();
+
+    ASSERT_EQ(responses.size(), kCalls);
+    for (int i = 0; i < kCalls; ++i) {
+        EXPECT_EQ(responses[i], "call" + std::to_string(i));
+    }
+    EXPECT_EQ(pool.numConnects(), 1);
+    EXPECT_EQ(pool.numReuses(), kCalls - 1);
+    EXPECT_EQ(pool.numIdle(), 1u);
+    EXPECT_EQ(accepted, 1);
+}
+
+TEST(KeepAlivePoolTest, ClosedByServer) {
+    Logger::setLogLevel(Logger::ERROR);
+    EventLoop loop;
+    InetAddress serverAddr(freePort(), true);
+    TcpServer server(&loop, serverAddr, "ClosingServer");
+    server.setMessageCallback([](const TcpConnectionPtr &conn, Buffer *buf, Timestamp) {
+        conn->send(buf);
+        conn->shutdown();
+    });
+    server.start();
+
+    KeepAlivePool pool(&loop, "Upstream");
+    string first;
+    call(&pool, serverAddr, "one", [&](const string &response) {
+        first = response;
+        // the idle connection goes once the server's FIN arrives.
+        loop.runAfter(0.1, [&loop] { loop.quit(); });
+    });
+    loop.loop();
+    EXPECT_EQ(first, "one");
+    EXPECT_EQ(pool.numIdle(), 0u);
+    EXPECT_EQ(pool.numConnections(), 0u);
+
+    string second;
+    call(&pool, serverAddr, "two", [&](const string &response) {
+        second = response;
+        loop.quit();
+    });
+    loop.runAfter(5.0, [&loop] { loop.quit(); });
+    loop.loop();
+    EXPECT_EQ(second, "two");
+    EXPECT_EQ(pool.numConnects(), 2);
+    EXPECT_EQ(pool.numReuses(), 0);
+}
+
+TEST(KeepAlivePoolTest, IdleTimeout) {
+    Logger::setLogLevel(Logger::ERROR);
+    EventLoop loop;
+    InetAddress serverAddr(freePort(), true);
+    TcpServer server(&loop, serverAddr, "EchoServer");
+    server.setMessageCallback([](const TcpConnectionPtr &conn, Buffer *buf, Timestamp) {
+        conn->send(buf);
+    });
+    server.start();
+
+    KeepAlivePool pool(&loop, "Upstream");
+    pool.setIdleTimeout(0.05);
+    call(&pool, serverAddr, "ping", [&](const string &) {
+        EXPECT_EQ(pool.numIdle(), 1u);
+        loop.runAfter(0.2, [&loop] { loop.quit(); });
+    });
+    loop.loop();
+    EXPECT_EQ(pool.numIdle(), 0u);
+    EXPECT_EQ(pool.numConnections(), 0u);
+}
+
+TEST(KeepAlivePoolTest, UnixPaths) {
+    Logger::setLogLevel(Logger::WARN);
+    EventLoop loop;
+    const string suffix = std::to_string(::getpid());
+    const InetAddress addrA = InetAddress::fromUnixPath("@gg_lib_pool_a_" + suffix);
+    const InetAddress addrB = InetAddress::fromUnixPath("@gg_lib_pool_b_" + suffix);
+    // each server answers with its own name, a request routed to the wrong path shows up.
+    TcpServer serverA(&loop, addrA, "a");
+    TcpServer serverB(&loop, addrB, "b");
+    for (TcpServer *server: {&serverA, &serverB}) {
+        server->setMessageCallback([server](const TcpConnectionPtr &conn, Buffer *buf, Timestamp) {
+            buf->retrieveAll();
+            conn->send(server->name());
+        });
+        server->start();
+    }
+
+    KeepAlivePool pool(&loop, "Upstream");
+    std::vector<string> responses;
+    constexpr int kCalls = 6;
+    std::function<void(const string &)> next = [&](const string &response) {
+        responses.push_back(response);
+        if (responses.size() == kCalls) {
+            loop.quit();
+        } else {
+            call(&pool, responses.size() % 2 ? addrB : addrA, "x", next);
+        }
+    };
+    call(&pool, addrA, "x", next);
+    loop.runAfter(5.0, [&loop] { loop.quit(); });
+    loop.loop();
+
+    ASSERT_EQ(responses.size(), kCalls);
+    for (int i = 0; i < kCalls; ++i) {
+        EXPECT_EQ(responses[i], i % 2 ? "b" : "a");
+    }
+    EXPECT_EQ(pool.numConnects(), 2);
+    EXPECT_EQ(pool.numReuses(), kCalls - 2);
+    EXPECT_EQ(pool.numIdle(), 2u);
+}
+
+TEST(KeepAlivePoolTest, DestroyedWithTimerOnWheel) {
+    Logger::setLogLevel(Logger::ERROR);
+    // the first timer of a wheel loop has id 0.
+    EventLoop loop(kWheelTimerQueue);
+    InetAddress serverAddr(freePort(), true);
+    TcpServer server(&loop, serverAddr, "EchoServer");
+    server.setMessageCallback([](const TcpConnectionPtr &conn, Buffer *buf, Timestamp) {
+        conn->send(buf);
+    });
+    server.start();
+
+    // poisoned once destroyed, a timer left armed crashes instead of reading a stale pool.
+    std::aligned_storage<sizeof(KeepAlivePool), alignof(KeepAlivePool)>::type storage;
+    KeepAlivePool *pool = new(&storage) KeepAlivePool(&loop, "Upstream");
+    pool->setIdleTimeout(0.05);
+    call(pool, serverAddr, "ping", [&](const string &) {
+        EXPECT_EQ(pool->numIdle(), 1u);
+        loop.quit();
+    });
+    // no timeout timer, the pool must arm the first one.
+    loop.loop();
+    pool->~KeepAlivePool();
+    ::memset(&storage, 0xff, sizeof storage);
+
+    loop.runAfter(0.2, [&loop] { loop.quit(); });
+    loop.loop();
+}
+
+TEST(KeepAlivePoolTest, ConnectFailure) {
+    Logger::setLogLevel(Logger::FATAL);
+    EventLoop loop;
+    KeepAlivePool pool(&loop, "Upstream");
+    bool failed = false;
+    pool.acquire(InetAddress(freePort(), true), [&](const TcpConnectionPtr &conn) {
+        failed = !conn;
+        loop.quit();
+    });
+    loop.runAfter(5.0, [&loop] { loop.quit(); });
+    loop.loop();
+    EXPECT_TRUE(failed);
+    EXPECT_EQ(pool.numConnections(), 0u);
+}
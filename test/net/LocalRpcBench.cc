@@ -0,0 +1,97 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#include <benchmark/benchmark.h>
+#include "gg_lib/net/EventLoop.h"
+#include "gg_lib/net/EventLoopThread.h"
+#include "gg_lib/net/TcpServer.h"
+#include "gg_lib/CountDownLatch.h"
+#include "gg_lib/Logging.h"
+#include "TestUtils.h"
+
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace gg_lib;
+using namespace gg_lib::net;
+
+namespace {
+    constexpr size_t kRequestSize = 64;
+
+    /// A blocking client sends a request to an echo TcpServer and waits for the
+    /// reply, one round trip per iteration.
+    void runRoundTrips(benchmark::State &state, const InetAddress &serverAddr, int socketType) {
+        Logger::setLogLevel(Logger::WARN);
+        EventLoopThread thread;
+        EventLoop *loop = thread.startLoop();
+        std::unique_ptr<TcpServer> server;
+        CountDownLatch started(1);
+        loop->runInLoop([&] {
+            server.reset(new TcpServer(loop, serverAddr, "RpcServer", TcpServer::kNoReusePort, socketType));
+            server->setConnectionCallback([](const TcpConnectionPtr &conn) {
+                if (conn->connected()) {
+                    conn->setTcpNoDelay(true);
+                }
+            });
+            server->setMessageCallback([](const TcpConnectionPtr &conn, Buffer *buf, Timestamp) {
+                conn->send(buf);
+            });
+            server->start();
+            started.countDown();
+        });
+        started.wait();
+
+        int fd = ::socket(serverAddr.family(), socketType | SOCK_CLOEXEC, 0);
+        if (sockets::connect(fd, serverAddr.getSockAddr()) < 0) {
+            LOG_SYSFATAL << "connect";
+        }
+        if (serverAddr.family() != AF_UNIX) {
+            int on = 1;
+            ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof on);
+        }
+        char request[kRequestSize] = {};
+        char reply[kRequestSize];
+        for (auto _: state) {
+            if (::write(fd, request, sizeof request) != sizeof request) {
+                state.SkipWithError("write");
+                break;
+            }
+            for (size_t received = 0; received < sizeof reply;) {
+                ssize_t n = ::read(fd, reply + received, sizeof reply - received);
+                if (n <= 0) {
+                    state.SkipWithError("read");
+                    break;
+                }
+                received += static_cast<size_t>(n);
+            }
+        }
+        state.SetItemsProcessed(state.iterations());
+        ::close(fd);
+
+        CountDownLatch stopped(1);
+        loop->runInLoop([&] {
+            server.reset();
+            stopped.countDown();
+        });
+        stopped.wait();
+    }
+}
+
+static void BM_TcpLoopbackRoundTrip(benchmark::State &state) {
+    runRoundTrips(state, InetAddress(freePort(), true), SOCK_STREAM);
+}
+
+static void BM_UnixStreamRoundTrip(benchmark::State &state) {
+    runRoundTrips(state, InetAddress::fromUnixPath(fmt::format("@gg_lib_rpc_{}", ::getpid())), SOCK_STREAM);
+}
+
+static void BM_UnixSeqPacketRoundTrip(benchmark::State &state) {
+    runRoundTrips(state, InetAddress::fromUnixPath(fmt::format("@gg_lib_rpc_{}", ::getpid())), SOCK_SEQPACKET);
+}
+
+BENCHMARK(BM_TcpLoopbackRoundTrip)->UseRealTime()->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_UnixStreamRoundTrip)->UseRealTime()->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_UnixSeqPacketRoundTrip)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
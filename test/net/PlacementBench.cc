@@ -0,0 +1,116 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#include <benchmark/benchmark.h>
+#include "gg_lib/net/EventLoop.h"
+#include "gg_lib/net/EventLoopThreadPool.h"
+#include "gg_lib/CountDownLatch.h"
+#include "gg_lib/Logging.h"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+using namespace gg_lib;
+using namespace gg_lib::net;
+
+namespace {
+    constexpr int kLoops = 4;
+    constexpr int kConnections = 32;
+    /// Every kHeavyEvery-th connection to arrive is heavy, which lines the
+    /// heavy ones up on one loop under round-robin.
+    constexpr int kHeavyEvery = kLoops;
+
+    void spin(int64_t microSeconds) {
+        int64_t end = Timestamp::now().microSecondsSinceEpoch() + microSeconds;
+        while (Timestamp::now().microSecondsSinceEpoch() < end) {
+        }
+    }
+
+    double percentile(std::vector<int64_t> &sorted, double p) {
+        return static_cast<double>(sorted[static_cast<size_t>(p * static_cast<double>(sorted.size() - 1))]);
+    }
+
+    ///
+    /// Places kConnections simulated connections, the heavy ones burn 0.5ms of
+    /// their loop every 10ms. Each iteration then measures how long a functor
+    /// posted to the loop of a light connection waits before it runs.
+    /// The loops need a core each for the tail latencies to mean anything.
+    ///
+    void runPlacement(benchmark::State &state, LoopPlacementPolicy policy) {
+        Logger::setLogLevel(Logger::WARN);
+        EventLoop baseLoop;
+        EventLoopThreadPool pool(&baseLoop, "placement");
+        pool.setThreadNum(kLoops);
+        pool.setPlacementPolicy(policy);
+        pool.start();
+
+        std::vector<EventLoop *> lightLoops;
+        std::vector<int> heavyPerLoop(kLoops);
+        std::vector<EventLoop *> allLoops = pool.getAllLoops();
+        for (int i = 0; i < kConnections; ++i) {
+            EventLoop *loop = pool.getNextLoop();
+            loop->updateConnectionCount(1);
+            if (i % kHeavyEvery == 0) {
+                loop->runEvery(0.01, [] { spin(500); });
+                ++heavyPerLoop[std::find(allLoops.begin(), allLoops.end(), loop) - allLoops.begin()];
+            } else {
+                lightLoops.push_back(loop);
+            }
+            // lets the load of the new connection show up.
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+
+        std::vector<int64_t> latencies;
+        latencies.reserve(static_cast<size_t>(state.max_iterations));
+        size_t next = 0;
+        for (auto _: state) {
+            EventLoop *loop = lightLoops[next++ % lightLoops.size()];
+            CountDownLatch latch(1);
+            int64_t posted = Timestamp::now().microSecondsSinceEpoch();
+            int64_t latency = 0;
+            loop->queueInLoop([posted, &latency, &latch] {
+                latency = Timestamp::now().microSecondsSinceEpoch() - posted;
+                latch.countDown();
+            });
+            latch.wait();
+            latencies.push_back(latency);
+            // spreads the probes over many periods of the heavy connections.
+            state.PauseTiming();
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+            state.ResumeTiming();
+        }
+
+        std::sort(latencies.begin(), latencies.end());
+        state.counters["p50_us"] = percentile(latencies, 0.5);
+        state.counters["p99_us"] = percentile(latencies, 0.99);
+        state.counters["p999_us"] = percentile(latencies, 0.999);
+        state.counters["max_heavy_per_loop"] = *std::max_element(heavyPerLoop.begin(), heavyPerLoop.end());
+        for (EventLoop *loop: allLoops) {
+            loop->updateConnectionCount(-loop->numConnections());
+        }
+    }
+}
+
+static void BM_RoundRobin(benchmark::State &state) {
+    runPlacement(state, kRoundRobin);
+}
+
+static void BM_LeastConnections(benchmark::State &state) {
+    runPlacement(state, kLeastConnections);
+}
+
+static void BM_LeastPendingFunctors(benchmark::State &state) {
+    runPlacement(state, kLeastPendingFunctors);
+}
+
+static void BM_PowerOfTwoChoices(benchmark::State &state) {
+    runPlacement(state, kPowerOfTwoChoices);
+}
+
+BENCHMARK(BM_RoundRobin)->Iterations(2000)->UseRealTime();
+BENCHMARK(BM_LeastConnections)->Iterations(2000)->UseRealTime();
+BENCHMARK(BM_LeastPendingFunctors)->Iterations(2000)->UseRealTime();
+BENCHMARK(BM_PowerOfTwoChoices)->Iterations(2000)->UseRealTime();
+
+BENCHMARK_MAIN();
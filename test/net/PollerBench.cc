@@ -0,0 +1,154 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#include <benchmark/benchmark.h>
+#include "gg_lib/net/EventLoop.h"
+#include "gg_lib/net/Channel.h"
+#include "gg_lib/net/SocketsHelper.h"
+#include "gg_lib/Logging.h"
+
+#include <dlfcn.h>
+#include <stdarg.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace gg_lib;
+using namespace gg_lib::net;
+
+// Count the syscalls issued by pollers, these wrappers take precedence
+// over libc since gg_lib is linked statically into this binary.
+static int64_t g_pollerSyscalls = 0;
+
+extern "C" int epoll_wait(int epfd, struct epoll_event *events, int maxevents, int timeout) {
+    typedef int (*Fn)(int, struct epoll_event *, int, int);
+    static Fn real = reinterpret_cast<Fn>(dlsym(RTLD_NEXT, "epoll_wait"));
+    ++g_pollerSyscalls;
+    return real(epfd, events, maxevents, timeout);
+}
+
+extern "C" int epoll_ctl(int epfd, int op, int fd, struct epoll_event *event) throw() {
+    typedef int (*Fn)(int, int, int, struct epoll_event *);
+    static Fn real = reinterpret_cast<Fn>(dlsym(RTLD_NEXT, "epoll_ctl"));
+    ++g_pollerSyscalls;
+    return real(epfd, op, fd, event);
+}
+
+extern "C" long syscall(long number, ...) throw() {
+    typedef long (*Fn)(long, ...);
+    static Fn real = reinterpret_cast<Fn>(dlsym(RTLD_NEXT, "syscall"));
+    va_list ap;
+    va_start(ap, number);
+    long args[6];
+    for (long &arg: args) {
+        arg = va_arg(ap, long);
+    }
+    va_end(ap);
+    if (number == __NR_io_uring_enter) {
+        ++g_pollerSyscalls;
+    }
+    return real(number, args[0], args[1], args[2], args[3], args[4], args[5]);
+}
+
+namespace {
+    /// One request is a byte from client to server, the server enables writing
+    /// to answer it like TcpConnection::sendInLoop does when the output buffer
+    /// is not empty, then disables writing once the answer is written.
+    class PingPong : noncopyable {
+    public:
+        PingPong(EventLoop *loop, int numPairs)
+                : loop_(loop), numPairs_(numPairs), done_(0) {
+            for (int i = 0; i < numPairs; ++i) {
+                int fds[2];
+                if (::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0, fds) < 0) {
+                    LOG_SYSFATAL << "socketpair";
+                }
+                clients_.emplace_back(new Channel(loop, fds[0]));
+                servers_.emplace_back(new Channel(loop, fds[1]));
+                Channel *client = clients_.back().get();
+                Channel *server = servers_.back().get();
+                client->setReadCallback([this, client](Timestamp) { onClientRead(client); });
+                server->setReadCallback([server](Timestamp) {
+                    char buf[64];
+                    if (sockets::read(server->fd(), buf, sizeof buf) > 0) {
+                        server->enableWriting();
+                    }
+                });
+                server->setWriteCallback([server] {
+                    sockets::write(server->fd(), "x", 1);
+                    server->disableWriting();
+                });
+                client->enableReading();
+                server->enableReading();
+            }
+        }
+
+        ~PingPong() {
+            for (auto *channels: {&clients_, &servers_}) {
+                for (auto &channel: *channels) {
+                    channel->disableAll();
+                    channel->remove();
+                    ::close(channel->fd());
+                }
+            }
+        }
+
+        void round() {
+            done_ = 0;
+            for (auto &client: clients_) {
+                sockets::write(client->fd(), "x", 1);
+            }
+            loop_->loop();
+        }
+
+    private:
+        void onClientRead(Channel *client) {
+            char buf[64];
+            if (sockets::read(client->fd(), buf, sizeof buf) > 0 && ++done_ == numPairs_) {
+                loop_->quit();
+            }
+        }
+
+        EventLoop *loop_;
+        int numPairs_;
+        int done_;
+        std::vector<std::unique_ptr<Channel>> clients_;
+        std::vector<std::unique_ptr<Channel>> servers_;
+    };
+
+    void runPingPong(benchmark::State &state, bool useIoUring) {
+        if (useIoUring) {
+            ::setenv("USE_IO_URING", "1", 1);
+        } else {
+            ::unsetenv("USE_IO_URING");
+        }
+        Logger::setLogLevel(Logger::WARN);
+        int numPairs = static_cast<int>(state.range(0));
+        EventLoop loop;
+        PingPong pingPong(&loop, numPairs);
+        pingPong.round();
+        int64_t syscallsBefore = g_pollerSyscalls;
+        for (auto _: state) {
+            pingPong.round();
+        }
+        double requests = static_cast<double>(state.iterations()) * numPairs;
+        state.counters["poller_syscalls/req"] =
+                static_cast<double>(g_pollerSyscalls - syscallsBefore) / requests;
+        state.SetItemsProcessed(static_cast<int64_t>(requests));
+    }
+}
+
+static void BM_EPollPingPong(benchmark::State &state) {
+    runPingPong(state, false);
+}
+
+static void BM_IoUringPingPong(benchmark::State &state) {
+    runPingPong(state, true);
+}
+
+BENCHMARK(BM_EPollPingPong)->Arg(1)->Arg(64)->Arg(1024);
+BENCHMARK(BM_IoUringPingPong)->Arg(1)->Arg(64)->Arg(1024);
+
+BENCHMARK_MAIN();
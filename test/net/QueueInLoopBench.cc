@@ -0,0 +1,117 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#include <benchmark/benchmark.h>
+#include "gg_lib/net/EventLoop.h"
+#include "gg_lib/net/EventLoopThread.h"
+#include "gg_lib/Logging.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace gg_lib;
+using namespace gg_lib::net;
+
+namespace {
+    AtomicInt64 g_ran;
+
+    /// Every thread runs the same number of iterations.
+    void waitDrained(const benchmark::State &state) {
+        while (g_ran.load() < state.iterations() * state.threads()) {
+            std::this_thread::yield();
+        }
+    }
+
+    /// The former queueInLoop: a vector behind a mutex, swapped out by the consumer.
+    class MutexQueue : noncopyable {
+    public:
+        MutexQueue() : quit_(false), consumer_([this] { consume(); }) {}
+
+        ~MutexQueue() {
+            {
+                std::lock_guard<std::mutex> lk(mutex_);
+                quit_ = true;
+            }
+            cond_.notify_one();
+            consumer_.join();
+        }
+
+        void post(std::function<void()> cb) {
+            {
+                std::lock_guard<std::mutex> lk(mutex_);
+                functors_.push_back(std::move(cb));
+            }
+            cond_.notify_one();
+        }
+
+    private:
+        void consume() {
+            std::vector<std::function<void()>> functors;
+            while (true) {
+                {
+                    std::unique_lock<std::mutex> lk(mutex_);
+                    while (functors_.empty() && !quit_) {
+                        cond_.wait(lk);
+                    }
+                    if (functors_.empty()) {
+                        return;
+                    }
+                    functors.swap(functors_);
+                }
+                for (const auto &functor: functors) {
+                    functor();
+                }
+                functors.clear();
+            }
+        }
+
+        std::mutex mutex_;
+        std::condition_variable cond_;
+        std::vector<std::function<void()>> functors_;
+        bool quit_;
+        std::thread consumer_;
+    };
+}
+
+/// Every benchmark thread posts into one loop running in its own thread.
+static void BM_QueueInLoop(benchmark::State &state) {
+    static EventLoopThread *loopThread = nullptr;
+    static EventLoop *loop = nullptr;
+    if (state.thread_index() == 0) {
+        Logger::setLogLevel(Logger::WARN);
+        g_ran = 0;
+        loopThread = new EventLoopThread;
+        loop = loopThread->startLoop();
+    }
+    for (auto _: state) {
+        loop->queueInLoop([] { g_ran.fetch_add(1, std::memory_order_relaxed); });
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) {
+        waitDrained(state);
+        delete loopThread;
+    }
+}
+
+static void BM_MutexQueue(benchmark::State &state) {
+    static MutexQueue *queue = nullptr;
+    if (state.thread_index() == 0) {
+        g_ran = 0;
+        queue = new MutexQueue;
+    }
+    for (auto _: state) {
+        queue->post([] { g_ran.fetch_add(1, std::memory_order_relaxed); });
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) {
+        waitDrained(state);
+        delete queue;
+    }
+}
+
+BENCHMARK(BM_MutexQueue)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_QueueInLoop)->ThreadRange(1, 8)->UseRealTime();
+
+BENCHMARK_MAIN();
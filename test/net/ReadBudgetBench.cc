@@ -0,0 +1,100 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#include <benchmark/benchmark.h>
+#include "gg_lib/net/EventLoop.h"
+#include "gg_lib/net/TcpConnection.h"
+#include "gg_lib/Logging.h"
+
+#include <dlfcn.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace gg_lib;
+using namespace gg_lib::net;
+
+// Count the epoll_wait calls of the loop, this wrapper takes precedence
+// over libc since gg_lib is linked statically into this binary.
+static int64_t g_epollWaits = 0;
+
+extern "C" int epoll_wait(int epfd, struct epoll_event *events, int maxevents, int timeout) {
+    typedef int (*Fn)(int, struct epoll_event *, int, int);
+    static Fn real = reinterpret_cast<Fn>(dlsym(RTLD_NEXT, "epoll_wait"));
+    ++g_epollWaits;
+    return real(epfd, events, maxevents, timeout);
+}
+
+namespace {
+    constexpr size_t kStreamBytes = 32 * 1024 * 1024;
+
+    /// A peer streams kStreamBytes over loopback into a TcpConnection per iteration.
+    void runStream(benchmark::State &state, bool edgeTriggered) {
+        Logger::setLogLevel(Logger::WARN);
+        InetAddress listenAddr(0, true);
+        Socket listener(sockets::createNonblockingOrDie(listenAddr.family()));
+        listener.bindAddress(listenAddr);
+        listener.listen();
+        struct sockaddr_in6 addr = sockets::getLocalAddr(listener.fd());
+        int peer = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (::connect(peer, sockets::sockaddr_cast(&addr), sizeof addr) < 0) {
+            LOG_SYSFATAL << "connect";
+        }
+        struct pollfd pfd = {listener.fd(), POLLIN, 0};
+        ::poll(&pfd, 1, -1);
+        InetAddress peerAddr;
+        int sockfd = listener.accept(&peerAddr);
+
+        EventLoop loop;
+        auto conn = std::make_shared<TcpConnection>(&loop, "stream", sockfd, InetAddress(), peerAddr);
+        conn->setEdgeTriggered(edgeTriggered);
+        size_t received = 0;
+        conn->setConnectionCallback(defaultConnectionCallback);
+        conn->setMessageCallback([&loop, &received](const TcpConnectionPtr &, Buffer *buf, Timestamp) {
+            received += buf->readableBytes();
+            buf->retrieveAll();
+            if (received >= kStreamBytes) {
+                loop.quit();
+            }
+        });
+        conn->setCloseCallback([](const TcpConnectionPtr &) {});
+        conn->connectEstablished();
+
+        const string chunk(1024 * 1024, 'x');
+        int64_t waitsBefore = g_epollWaits;
+        for (auto _: state) {
+            received = 0;
+            std::thread writer([peer, &chunk] {
+                for (size_t sent = 0; sent < kStreamBytes;) {
+                    ssize_t n = ::write(peer, chunk.data(), std::min(chunk.size(), kStreamBytes - sent));
+                    if (n <= 0) {
+                        break;
+                    }
+                    sent += static_cast<size_t>(n);
+                }
+            });
+            loop.loop();
+            writer.join();
+        }
+        double megabytes = static_cast<double>(state.iterations()) * kStreamBytes / (1024 * 1024);
+        state.counters["epoll_waits/MB"] = static_cast<double>(g_epollWaits - waitsBefore) / megabytes;
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * kStreamBytes));
+        conn->connectDestroyed();
+        ::close(peer);
+    }
+}
+
+static void BM_LevelTriggeredStream(benchmark::State &state) {
+    runStream(state, false);
+}
+
+static void BM_EdgeTriggeredStream(benchmark::State &state) {
+    runStream(state, true);
+}
+
+BENCHMARK(BM_LevelTriggeredStream)->UseRealTime();
+BENCHMARK(BM_EdgeTriggeredStream)->UseRealTime();
+
+BENCHMARK_MAIN();
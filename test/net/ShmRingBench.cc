@@ -0,0 +1,108 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#include <benchmark/benchmark.h>
+#include "gg_lib/net/EventLoop.h"
+#include "gg_lib/net/ShmRingReader.h"
+#include "gg_lib/net/ShmRingWriter.h"
+#include "gg_lib/net/TcpConnection.h"
+#include "gg_lib/Logging.h"
+
+#include <fcntl.h>
+#include <sched.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace gg_lib;
+using namespace gg_lib::net;
+
+namespace {
+    constexpr size_t kMessageSize = 64;
+    constexpr size_t kMessages = 256 * 1024;
+    constexpr size_t kStreamBytes = kMessageSize * kMessages;
+}
+
+/// A producer thread hands kMessages messages to a reader in the loop, one append each.
+static void BM_ShmRingStream(benchmark::State &state) {
+    Logger::setLogLevel(Logger::WARN);
+    const string name = fmt::format("/gg_lib_bench_{}", ::getpid());
+    EventLoop loop;
+    ShmRingReader reader(&loop, ShmRing::create(name, 256 * 1024));
+    ShmRingWriter writer(ShmRing::open(name), reader.notifyFd());
+    ShmRing::unlink(name);
+    size_t received = 0;
+    reader.setMessageCallback([&](Buffer *buf, Timestamp) {
+        received += buf->readableBytes();
+        buf->retrieveAll();
+        if (received == kStreamBytes) {
+            loop.quit();
+        }
+    });
+    reader.start();
+
+    const char message[kMessageSize] = {};
+    for (auto _: state) {
+        received = 0;
+        std::thread producer([&writer, &message] {
+            for (size_t i = 0; i < kMessages; ++i) {
+                while (!writer.append(message, sizeof message)) {
+                    sched_yield();
+                }
+            }
+        });
+        loop.loop();
+        producer.join();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kMessages));
+    // eventfd signals of the writer only, not those the reader posts itself.
+    state.counters["writer wakeups/message"] =
+            static_cast<double>(writer.numWakeups()) / static_cast<double>(state.iterations() * kMessages);
+    state.counters["reader wakeups/message"] =
+            static_cast<double>(reader.numWakeups()) / static_cast<double>(state.iterations() * kMessages);
+}
+
+/// The same over an AF_UNIX socket pair, one write(2) a message.
+static void BM_UnixSocketStream(benchmark::State &state) {
+    Logger::setLogLevel(Logger::WARN);
+    int fds[2];
+    if (::socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds) < 0) {
+        LOG_SYSFATAL << "socketpair";
+    }
+    ::fcntl(fds[0], F_SETFL, O_NONBLOCK);
+    EventLoop loop;
+    auto conn = std::make_shared<TcpConnection>(&loop, "stream", fds[0], InetAddress(), InetAddress());
+    size_t received = 0;
+    conn->setMessageCallback([&](const TcpConnectionPtr &, Buffer *buf, Timestamp) {
+        received += buf->readableBytes();
+        buf->retrieveAll();
+        if (received == kStreamBytes) {
+            loop.quit();
+        }
+    });
+    conn->setCloseCallback([](const TcpConnectionPtr &) {});
+    conn->connectEstablished();
+
+    const char message[kMessageSize] = {};
+    const int peer = fds[1];
+    for (auto _: state) {
+        received = 0;
+        std::thread producer([peer, &message] {
+            for (size_t i = 0; i < kMessages; ++i) {
+                if (::write(peer, message, sizeof message) != sizeof message) {
+                    break;
+                }
+            }
+        });
+        loop.loop();
+        producer.join();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kMessages));
+    conn->connectDestroyed();
+    ::close(peer);
+}
+
+BENCHMARK(BM_ShmRingStream)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_UnixSocketStream)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
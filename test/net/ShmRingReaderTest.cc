@@ -0,0 +1,69 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#include "gg_lib/net/ShmRingReader.h"
+#include "gg_lib/net/ShmRingWriter.h"
+#include "gg_lib/net/EventLoop.h"
+#include "gg_lib/Logging.h"
+
+#include <gtest/gtest.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace gg_lib;
+using namespace gg_lib::net;
+
+TEST(ShmRingReaderTest, CrossProcess) {
+    Logger::setLogLevel(Logger::WARN);
+    constexpr int kMessages = 20000;
+    const string name = fmt::format("/gg_lib_reader_{}", ::getpid());
+    EventLoop loop;
+    std::unique_ptr<ShmRing> ring = ShmRing::create(name, 4096);
+    ASSERT_TRUE(ring);
+    ShmRingReader reader(&loop, std::move(ring));
+
+    // the writer gets the eventfd by fork(2), and maps the ring by its name.
+    pid_t child = ::fork();
+    ASSERT_GE(child, 0);
+    if (child == 0) {
+        std::unique_ptr<ShmRing> producerRing = ShmRing::open(name);
+        if (!producerRing) {
+            ::_exit(1);
+        }
+        ShmRingWriter writer(std::move(producerRing), reader.notifyFd());
+        for (int i = 0; i < kMessages; ++i) {
+            string message = fmt::format("{:08d}", i);
+            while (!writer.append(message.data(), message.size())) {
+                // full, the reader is behind.
+                ::usleep(10);
+            }
+        }
+        ::_exit(0);
+    }
+
+    int received = 0;
+    bool inOrder = true;
+    reader.setMessageCallback([&](Buffer *buf, Timestamp) {
+        // 8 bytes a message, a partial one waits for the rest.
+        while (buf->readableBytes() >= 8) {
+            inOrder = inOrder && buf->retrieveAsString(8) == fmt::format("{:08d}", received);
+            ++received;
+        }
+        if (received == kMessages) {
+            loop.quit();
+        }
+    });
+    reader.start();
+    loop.runAfter(10.0, [&loop] { loop.quit(); });
+    loop.loop();
+
+    int status = 0;
+    ASSERT_EQ(::waitpid(child, &status, 0), child);
+    ShmRing::unlink(name);
+    EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    EXPECT_EQ(received, kMessages);
+    EXPECT_TRUE(inOrder);
+    // far fewer than one wakeup a message.
+    EXPECT_GE(reader.numWakeups(), 1);
+    EXPECT_LT(reader.numWakeups(), kMessages);
+}
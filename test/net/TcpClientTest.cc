@@ -0,0 +1,105 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#include "gg_lib/net/TcpClient.h"
+#include "gg_lib/net/TcpServer.h"
+#include "gg_lib/net/EventLoop.h"
+#include "gg_lib/Logging.h"
+#include "TestUtils.h"
+
+#include <gtest/gtest.h>
+
+using namespace gg_lib;
+using namespace gg_lib::net;
+
+TEST(TcpClientTest, Echo) {
+    Logger::setLogLevel(Logger::WARN);
+    EventLoop loop;
+    InetAddress serverAddr(freePort(), true);
+    TcpServer server(&loop, serverAddr, "EchoServer");
+    server.setMessageCallback([](const TcpConnectionPtr &conn, Buffer *buf, Timestamp) {
+        conn->send(buf);
+    });
+    server.start();
+
+    TcpClient client(&loop, serverAddr, "EchoClient");
+    string echoed;
+    int disconnects = 0;
+    client.setConnectionCallback([&](const TcpConnectionPtr &conn) {
+        if (conn->connected()) {
+            conn->send("hello");
+        } else {
+            ++disconnects;
+            loop.quit();
+        }
+    });
+    client.setMessageCallback([&](const TcpConnectionPtr &, Buffer *buf, Timestamp) {
+        echoed += buf->retrieveAllAsString();
+        if (echoed.size() == 5) {
+            client.disconnect();
+        }
+    });
+    client.connect();
+    loop.runAfter(5.0, [&loop] { loop.quit(); });
+    loop.loop();
+
+    EXPECT_EQ(echoed, "hello");
+    EXPECT_EQ(disconnects, 1);
+    EXPECT_FALSE(client.connection());
+}
+
+TEST(TcpClientTest, RetryUntilListening) {
+    Logger::setLogLevel(Logger::ERROR);
+    EventLoop loop;
+    InetAddress serverAddr(freePort(), true);
+    TcpServer server(&loop, serverAddr, "LateServer");
+
+    TcpClient client(&loop, serverAddr, "RetryClient");
+    client.connector()->setRetryDelay(0.01, 0.04);
+    bool connected = false;
+    client.setConnectionCallback([&](const TcpConnectionPtr &conn) {
+        if (conn->connected()) {
+            connected = true;
+            client.disconnect();
+        } else {
+            loop.quit();
+        }
+    });
+    client.connect();
+    // refused until the server listens.
+    loop.runAfter(0.1, [&server] { server.start(); });
+    TimerId timeout = loop.runAfter(5.0, [&loop] { loop.quit(); });
+    loop.loop();
+    loop.cancel(timeout);
+    // the connection is destroyed by a functor queued after the disconnect callback.
+    loop.runAfter(0.05, [&loop] { loop.quit(); });
+    loop.loop();
+
+    EXPECT_TRUE(connected);
+    EXPECT_FALSE(client.connection());
+}
+
+TEST(TcpClientTest, ConnectorGivesUp) {
+    Logger::setLogLevel(Logger::ERROR);
+    EventLoop loop;
+    auto connector = std::make_shared<Connector>(&loop, InetAddress(freePort(), true));
+    connector->setRetryDelay(0.01, 0.02);
+    connector->setMaxRetries(3);
+    int savedErrno = 0;
+    Timestamp start = Timestamp::now();
+    connector->setNewConnectionCallback([](int sockfd) {
+        sockets::close(sockfd);
+        ADD_FAILURE() << "nobody listens";
+    });
+    connector->setFailureCallback([&](int err) {
+        savedErrno = err;
+        loop.quit();
+    });
+    connector->start();
+    loop.runAfter(5.0, [&loop] { loop.quit(); });
+    loop.loop();
+
+    EXPECT_EQ(savedErrno, ECONNREFUSED);
+    // delays 0.01, 0.02 and 0.02 between the attempts.
+    EXPECT_GE(Timestamp::timeDuration(Timestamp::now(), start), 0.05);
+}
@@ -0,0 +1,381 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#include "gg_lib/net/TcpConnection.h"
+#include "gg_lib/net/EventLoop.h"
+#include "gg_lib/net/EventLoopThread.h"
+#include "gg_lib/CountDownLatch.h"
+#include "gg_lib/Logging.h"
+
+#include <gtest/gtest.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace gg_lib;
+using namespace gg_lib::net;
+
+namespace {
+    string makePattern(size_t len) {
+        string str(len, '\0');
+        for (size_t i = 0; i < len; ++i) {
+            str[i] = static_cast<char>('a' + i % 26);
+        }
+        return str;
+    }
+
+    int makeTempFile(const string &content) {
+        char path[] = "/tmp/gg_lib_sendfile_XXXXXX";
+        int fd = ::mkstemp(path);
+        EXPECT_GE(fd, 0);
+        ::unlink(path);
+        EXPECT_EQ(::write(fd, content.data(), content.size()), static_cast<ssize_t>(content.size()));
+        return fd;
+    }
+
+    /// A connected TCP pair over loopback, fds[0] is non-blocking.
+    void makeTcpPair(int fds[2]) {
+        InetAddress listenAddr(0, true);
+        Socket listener(sockets::createNonblockingOrDie(listenAddr.family()));
+        listener.bindAddress(listenAddr);
+        listener.listen();
+        struct sockaddr_in6 addr = sockets::getLocalAddr(listener.fd());
+        fds[1] = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        ASSERT_EQ(::connect(fds[1], sockets::sockaddr_cast(&addr), sizeof addr), 0);
+        InetAddress peerAddr;
+        do {
+            fds[0] = listener.accept(&peerAddr);
+        } while (fds[0] < 0 && errno == EAGAIN);
+        ASSERT_GE(fds[0], 0);
+    }
+
+    /// Queues "head", a slice of a file and "tail" on one end of a socketpair,
+    /// and checks the other end receives them in order.
+    void runSendFile(bool completionMode) {
+        Logger::setLogLevel(Logger::WARN);
+        const string content = makePattern(3 * 1024 * 1024);
+        int fileFd = makeTempFile(content);
+        int fds[2];
+        ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0, fds), 0);
+
+        EventLoop loop;
+        auto conn = std::make_shared<TcpConnection>(&loop, "test", fds[0], InetAddress(), InetAddress());
+        conn->setCompletionMode(completionMode);
+        conn->setConnectionCallback(defaultConnectionCallback);
+        conn->setMessageCallback(defaultMessageCallback);
+        conn->setCloseCallback([](const TcpConnectionPtr &) {});
+        int writeCompletes = 0;
+        size_t highWaterMark = 0;
+        conn->setWriteCompleteCallback([&writeCompletes](const TcpConnectionPtr &) { ++writeCompletes; });
+        conn->setHighWaterMarkCallback([&highWaterMark](const TcpConnectionPtr &, size_t len) {
+            highWaterMark = len;
+        }, 1024 * 1024);
+        conn->connectEstablished();
+
+        const string expected = "head" + content.substr(1000, content.size() - 2000) + "tail";
+        string received;
+        std::thread reader([&] {
+            char buf[65536];
+            while (received.size() < expected.size()) {
+                ssize_t n = ::read(fds[1], buf, sizeof buf);
+                if (n > 0) {
+                    received.append(buf, static_cast<size_t>(n));
+                } else if (n == 0 || errno != EAGAIN) {
+                    break;
+                }
+            }
+            loop.quit();
+        });
+
+        conn->send("head");
+        conn->sendFile(fileFd, 1000, content.size() - 2000);
+        ::close(fileFd);
+        conn->send("tail");
+        loop.loop();
+        reader.join();
+        // run the callbacks queued by the last write.
+        loop.runAfter(0.01, [&loop] { loop.quit(); });
+        loop.loop();
+
+        EXPECT_EQ(received.size(), expected.size());
+        EXPECT_TRUE(received == expected);
+        EXPECT_GT(highWaterMark, 1024 * 1024);
+        EXPECT_GE(writeCompletes, 1);
+        conn->connectDestroyed();
+        ::close(fds[1]);
+    }
+}
+
+TEST(TcpConnectionTest, SendFile) {
+    runSendFile(false);
+}
+
+TEST(TcpConnectionTest, ZeroCopySend) {
+    Logger::setLogLevel(Logger::WARN);
+    int fds[2];
+    makeTcpPair(fds);
+    EventLoop loop;
+    auto conn = std::make_shared<TcpConnection>(&loop, "test", fds[0], InetAddress(), InetAddress());
+    conn->setConnectionCallback(defaultConnectionCallback);
+    conn->setMessageCallback(defaultMessageCallback);
+    conn->setCloseCallback([](const TcpConnectionPtr &) {});
+    conn->connectEstablished();
+    conn->setZeroCopyThreshold(64 * 1024);
+
+    const string frame = makePattern(4 * 1024 * 1024 + 7);
+    string received;
+    std::thread reader([&] {
+        char buf[65536];
+        while (received.size() < 3 * frame.size()) {
+            ssize_t n = ::read(fds[1], buf, sizeof buf);
+            if (n <= 0) {
+                break;
+            }
+            received.append(buf, static_cast<size_t>(n));
+        }
+        loop.quit();
+    });
+    for (int i = 0; i < 3; ++i) {
+        Buffer buffer;
+        buffer.append(frame);
+        conn->send(std::move(buffer));
+        // its storage went to the output chain, the unsent part was not copied.
+        EXPECT_EQ(buffer.readableBytes(), 0u);
+    }
+    loop.loop();
+    reader.join();
+
+    EXPECT_EQ(received.size(), 3 * frame.size());
+    EXPECT_TRUE(received == frame + frame + frame);
+    conn->connectDestroyed();
+    ::close(fds[1]);
+}
+
+TEST(TcpConnectionTest, SendFileCompletionMode) {
+    ::setenv("USE_IO_URING", "1", 1);
+    runSendFile(true);
+    ::unsetenv("USE_IO_URING");
+}
+
+TEST(TcpConnectionTest, CompletionModeEcho) {
+    Logger::setLogLevel(Logger::WARN);
+    ::setenv("USE_IO_URING", "1", 1);
+    EventLoop loop;
+    ::unsetenv("USE_IO_URING");
+    if (!loop.supportsCompletionIo()) {
+        GTEST_SKIP() << "no io_uring";
+    }
+    int fds[2];
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0, fds), 0);
+    auto conn = std::make_shared<TcpConnection>(&loop, "test", fds[0], InetAddress(), InetAddress());
+    conn->setCompletionMode(true);
+    ASSERT_TRUE(conn->completionMode());
+    int messages = 0;
+    bool closed = false;
+    conn->setConnectionCallback(defaultConnectionCallback);
+    conn->setMessageCallback([&messages](const TcpConnectionPtr &conn, Buffer *buf, Timestamp) {
+        ++messages;
+        conn->send(buf);
+    });
+    conn->setWriteCompleteCallback([&loop](const TcpConnectionPtr &) { loop.quit(); });
+    conn->setCloseCallback([&](const TcpConnectionPtr &) {
+        closed = true;
+        loop.quit();
+    });
+    conn->connectEstablished();
+
+    auto runFor = [&loop](double seconds) {
+        TimerId timeout = loop.runAfter(seconds, [&loop] { loop.quit(); });
+        loop.loop();
+        loop.cancel(timeout);
+    };
+    auto readPeer = [&fds] {
+        char buf[64];
+        ssize_t n = ::read(fds[1], buf, sizeof buf);
+        return n > 0 ? string(buf, static_cast<size_t>(n)) : string();
+    };
+
+    // the posted recv completes and the echo goes out through a posted send.
+    ASSERT_EQ(::write(fds[1], "ping", 4), 4);
+    runFor(5.0);
+    EXPECT_EQ(messages, 1);
+    EXPECT_EQ(readPeer(), "ping");
+
+    // stopRead() cancels the posted recv, the data waits in the socket.
+    conn->stopRead();
+    EXPECT_FALSE(conn->isReading());
+    ASSERT_EQ(::write(fds[1], "pong", 4), 4);
+    runFor(0.05);
+    EXPECT_EQ(messages, 1);
+    EXPECT_EQ(readPeer(), "");
+
+    conn->startRead();
+    EXPECT_TRUE(conn->isReading());
+    runFor(5.0);
+    EXPECT_EQ(messages, 2);
+    EXPECT_EQ(readPeer(), "pong");
+
+    // the recv sees the peer close, nothing stays posted for the closed connection.
+    ::close(fds[1]);
+    runFor(5.0);
+    EXPECT_TRUE(closed);
+    EXPECT_FALSE(conn->connected());
+    conn->connectDestroyed();
+    runFor(0.05);
+    EXPECT_EQ(conn.use_count(), 1);
+}
+
+TEST(TcpConnectionTest, Migrate) {
+    Logger::setLogLevel(Logger::WARN);
+    int fds[2];
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds), 0);
+    ::fcntl(fds[0], F_SETFL, O_NONBLOCK);
+    EventLoopThread thread1, thread2;
+    EventLoop *loop1 = thread1.startLoop();
+    EventLoop *loop2 = thread2.startLoop();
+
+    auto conn = std::make_shared<TcpConnection>(loop1, "test", fds[0], InetAddress(), InetAddress());
+    std::atomic<EventLoop *> echoLoop(nullptr);
+    conn->setConnectionCallback(defaultConnectionCallback);
+    conn->setMessageCallback([&echoLoop](const TcpConnectionPtr &conn, Buffer *buf, Timestamp) {
+        echoLoop = EventLoop::getEventLoopOfCurrentThread();
+        conn->send(buf);
+    });
+    conn->setCloseCallback([](const TcpConnectionPtr &) {});
+    CountDownLatch established(1);
+    loop1->runInLoop([&conn, &established] {
+        conn->connectEstablished();
+        established.countDown();
+    });
+    established.wait();
+
+    // sends from another thread keep their order across the move.
+    constexpr int kMessages = 20000;
+    string expected;
+    for (int i = 0; i < kMessages; ++i) {
+        expected += fmt::format("{:05d}", i);
+    }
+    std::thread sender([&] {
+        for (int i = 0; i < kMessages; ++i) {
+            if (i == kMessages / 2) {
+                conn->migrateTo(loop2);
+            }
+            conn->send(fmt::format("{:05d}", i));
+        }
+    });
+    string received;
+    char buf[65536];
+    while (received.size() < expected.size()) {
+        ssize_t n = ::read(fds[1], buf, sizeof buf);
+        ASSERT_GT(n, 0);
+        received.append(buf, static_cast<size_t>(n));
+    }
+    sender.join();
+    EXPECT_TRUE(received == expected);
+
+    while (conn->getLoop() != loop2) {
+        ::usleep(1000);
+    }
+    EXPECT_EQ(loop1->numConnections(), 0);
+    EXPECT_EQ(loop2->numConnections(), 1);
+    ASSERT_EQ(::write(fds[1], "ping", 4), 4);
+    ASSERT_EQ(::read(fds[1], buf, sizeof buf), 4);
+    EXPECT_EQ(echoLoop, loop2);
+
+    CountDownLatch destroyed(1);
+    loop2->runInLoop([&conn, &destroyed] {
+        conn->connectDestroyed();
+        destroyed.countDown();
+    });
+    destroyed.wait();
+    ::close(fds[1]);
+}
+
+TEST(TcpConnectionTest, EdgeTriggered) {
+    Logger::setLogLevel(Logger::WARN);
+    int bulkFds[2], pingFds[2], tailFds[2];
+    makeTcpPair(bulkFds);
+    makeTcpPair(pingFds);
+    makeTcpPair(tailFds);
+    // the last bytes come with the FIN, no edge follows the short read of them.
+    ASSERT_EQ(::write(tailFds[1], "tail", 4), 4);
+    ::shutdown(tailFds[1], SHUT_WR);
+
+    EventLoop loop;
+    int closed = 0;
+    auto onClose = [&loop, &closed](const TcpConnectionPtr &) {
+        if (++closed == 2) {
+            loop.quit();
+        }
+    };
+    size_t bulkReceived = 0;
+    auto bulk = std::make_shared<TcpConnection>(&loop, "bulk", bulkFds[0], InetAddress(), InetAddress());
+    bulk->setEdgeTriggered(true);
+    bulk->setReadBudget(64 * 1024, 2);
+    bulk->setConnectionCallback(defaultConnectionCallback);
+    bulk->setMessageCallback([&bulkReceived](const TcpConnectionPtr &, Buffer *buf, Timestamp) {
+        bulkReceived += buf->readableBytes();
+        buf->retrieveAll();
+    });
+    bulk->setCloseCallback(onClose);
+    string tailReceived;
+    auto tail = std::make_shared<TcpConnection>(&loop, "tail", tailFds[0], InetAddress(), InetAddress());
+    tail->setEdgeTriggered(true);
+    tail->setConnectionCallback(defaultConnectionCallback);
+    tail->setMessageCallback([&tailReceived](const TcpConnectionPtr &, Buffer *buf, Timestamp) {
+        tailReceived += buf->retrieveAllAsString();
+    });
+    tail->setCloseCallback(onClose);
+    auto ping = std::make_shared<TcpConnection>(&loop, "ping", pingFds[0], InetAddress(), InetAddress());
+    ping->setEdgeTriggered(true);
+    ping->setConnectionCallback(defaultConnectionCallback);
+    ping->setMessageCallback([](const TcpConnectionPtr &conn, Buffer *buf, Timestamp) {
+        conn->send(buf);
+    });
+    ping->setCloseCallback([](const TcpConnectionPtr &) {});
+    EXPECT_TRUE(bulk->edgeTriggered());
+    bulk->connectEstablished();
+    tail->connectEstablished();
+    ping->connectEstablished();
+
+    // the echo of the other connection keeps coming while the bulk one streams.
+    constexpr int kChunks = 64;
+    const string chunk = makePattern(256 * 1024);
+    int pongs = 0;
+    std::thread client([&] {
+        for (int i = 0; i < kChunks; ++i) {
+            size_t written = 0;
+            while (written < chunk.size()) {
+                ssize_t n = ::write(bulkFds[1], chunk.data() + written, chunk.size() - written);
+                ASSERT_GT(n, 0);
+                written += static_cast<size_t>(n);
+            }
+            char buf[4];
+            ASSERT_EQ(::write(pingFds[1], "ping", 4), 4);
+            if (::read(pingFds[1], buf, sizeof buf) == 4) {
+                ++pongs;
+            }
+        }
+        ::shutdown(bulkFds[1], SHUT_WR);
+    });
+    TimerId timeout = loop.runAfter(10.0, [&loop] { loop.quit(); });
+    loop.loop();
+    loop.cancel(timeout);
+    client.join();
+
+    EXPECT_EQ(closed, 2);
+    EXPECT_EQ(bulkReceived, kChunks * chunk.size());
+    EXPECT_EQ(pongs, kChunks);
+    EXPECT_EQ(tailReceived, "tail");
+    bulk->connectDestroyed();
+    tail->connectDestroyed();
+    ping->forceClose();
+    loop.runAfter(0.01, [&loop] { loop.quit(); });
+    loop.loop();
+    ping->connectDestroyed();
+    for (int fd: {bulkFds[1], pingFds[1], tailFds[1]}) {
+        ::close(fd);
+    }
+}
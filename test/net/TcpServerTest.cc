@@ -0,0 +1,222 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#include "gg_lib/net/TcpServer.h"
+#include "gg_lib/net/Acceptor.h"
+#include "gg_lib/net/EventLoop.h"
+#include "gg_lib/Logging.h"
+#include "TestUtils.h"
+
+#include <atomic>
+
+#include <gtest/gtest.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace gg_lib;
+using namespace gg_lib::net;
+
+namespace {
+    int connectTo(const InetAddress &addr) {
+        int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        EXPECT_EQ(::connect(fd, addr.getSockAddr(), sizeof(struct sockaddr_in)), 0);
+        return fd;
+    }
+}
+
+TEST(TcpServerTest, IdleTimeout) {
+    Logger::setLogLevel(Logger::WARN);
+    EventLoop loop;
+    InetAddress listenAddr(freePort(), true);
+    TcpServer server(&loop, listenAddr, "IdleTimeout");
+    server.setIdleTimeout(0.2);
+    server.start();
+
+    double idleClosedAfter = 0.0;
+    bool activeClosed = true;
+    std::thread client([&] {
+        int idle = connectTo(listenAddr);
+        int active = connectTo(listenAddr);
+        Timestamp start = Timestamp::now();
+        std::thread idleReader([&] {
+            char buf[16];
+            EXPECT_EQ(::read(idle, buf, sizeof buf), 0);
+            idleClosedAfter = Timestamp::timeDuration(Timestamp::now(), start);
+        });
+        // keep the other one busy for twice the timeout.
+        for (int i = 0; i < 10; ++i) {
+            EXPECT_EQ(::write(active, "x", 1), 1);
+            ::usleep(40 * 1000);
+        }
+        idleReader.join();
+        char buf[16];
+        activeClosed = ::recv(active, buf, sizeof buf, MSG_DONTWAIT) == 0;
+        ::close(idle);
+        ::close(active);
+        loop.quit();
+    });
+    loop.loop();
+    client.join();
+
+    EXPECT_GE(idleClosedAfter, 0.19);
+    EXPECT_LT(idleClosedAfter, 0.3);
+    EXPECT_FALSE(activeClosed);
+}
+
+TEST(TcpServerTest, IdleTimeoutAfterShutdown) {
+    Logger::setLogLevel(Logger::WARN);
+    EventLoop loop;
+    InetAddress listenAddr(freePort(), true);
+    TcpServer server(&loop, listenAddr, "IdleTimeoutAfterShutdown");
+    server.setIdleTimeout(0.2);
+    Timestamp establishTime;
+    double closedAfter = 0.0;
+    server.setConnectionCallback([&](const TcpConnectionPtr &conn) {
+        if (conn->connected()) {
+            establishTime = Timestamp::now();
+            // more than the socket buffers hold, the rest waits for a peer which never reads.
+            conn->send(string(32 * 1024 * 1024, 'x'));
+            conn->shutdown();
+        } else {
+            closedAfter = Timestamp::timeDuration(Timestamp::now(), establishTime);
+            loop.quit();
+        }
+    });
+    server.start();
+
+    int fd = connectTo(listenAddr);
+    TimerId timeout = loop.runAfter(2.0, [&loop] { loop.quit(); });
+    loop.loop();
+    loop.cancel(timeout);
+    // the connection is destroyed by a functor queued after the disconnect callback.
+    loop.runAfter(0.05, [&loop] { loop.quit(); });
+    loop.loop();
+    ::close(fd);
+
+    EXPECT_GE(closedAfter, 0.19);
+    EXPECT_LT(closedAfter, 0.5);
+}
+
+TEST(TcpServerTest, ReusePortPerLoop) {
+    Logger::setLogLevel(Logger::WARN);
+    EventLoop loop;
+    InetAddress listenAddr(freePort(), true);
+    TcpServer server(&loop, listenAddr, "ReusePortPerLoop", TcpServer::kReusePortPerLoop);
+    server.setThreadNum(2);
+    server.setReusePortCpuSteering(true);
+    std::atomic<int> connected(0);
+    std::atomic<int> disconnected(0);
+    std::atomic<bool> foreignThread(false);
+    std::atomic<bool> lookupFailed(false);
+    server.setConnectionCallback([&](const TcpConnectionPtr &conn) {
+        // establish and destroy both run in the I/O thread which accepted.
+        if (!conn->getLoop()->isInLoopThread() || conn->getLoop() == &loop) {
+            foreignThread = true;
+        }
+        // the id routes to the shard which accepted.
+        if (conn->connected() && server.findConnection(conn->id()) != conn) {
+            lookupFailed = true;
+        }
+        ++(conn->connected() ? connected : disconnected);
+    });
+    server.setMessageCallback([](const TcpConnectionPtr &conn, Buffer *buf, Timestamp) {
+        conn->send(buf);
+    });
+    server.start();
+
+    constexpr int kClients = 8;
+    int echoed = 0;
+    std::thread client([&] {
+        std::vector<int> fds;
+        for (int i = 0; i < kClients; ++i) {
+            fds.push_back(connectTo(listenAddr));
+        }
+        for (int fd: fds) {
+            char buf[4];
+            EXPECT_EQ(::write(fd, "ping", 4), 4);
+            if (::read(fd, buf, sizeof buf) == 4) {
+                ++echoed;
+            }
+            ::close(fd);
+        }
+        while (disconnected < kClients) {
+            ::usleep(1000);
+        }
+        loop.quit();
+    });
+    loop.loop();
+    client.join();
+
+    EXPECT_EQ(echoed, kClients);
+    EXPECT_EQ(connected, kClients);
+    EXPECT_FALSE(foreignThread);
+    EXPECT_FALSE(lookupFailed);
+}
+
+TEST(TcpServerTest, DeferAccept) {
+    Logger::setLogLevel(Logger::WARN);
+    EventLoop loop;
+    InetAddress listenAddr(freePort(), true);
+    TcpServer server(&loop, listenAddr, "DeferAccept");
+    server.setDeferAccept(1);
+    server.setTcpNoDelay(true);
+    std::atomic<int> connected(0);
+    uint16_t localPort = 0;
+    server.setConnectionCallback([&](const TcpConnectionPtr &conn) {
+        if (conn->connected()) {
+            ++connected;
+            localPort = conn->localAddress().port();
+        }
+    });
+    server.setMessageCallback([](const TcpConnectionPtr &conn, Buffer *buf, Timestamp) {
+        conn->send(buf);
+    });
+    server.start();
+
+    int connectedWhileIdle = -1;
+    std::thread client([&] {
+        int fd = connectTo(listenAddr);
+        // the handshake is done, but nothing arrived to accept for.
+        ::usleep(100 * 1000);
+        connectedWhileIdle = connected;
+        char buf[4];
+        EXPECT_EQ(::write(fd, "ping", 4), 4);
+        EXPECT_EQ(::read(fd, buf, sizeof buf), 4);
+        ::close(fd);
+        loop.quit();
+    });
+    loop.loop();
+    client.join();
+
+    EXPECT_EQ(connectedWhileIdle, 0);
+    EXPECT_EQ(connected, 1);
+    EXPECT_EQ(localPort, listenAddr.port());
+}
+
+TEST(TcpServerTest, AcceptedSocketsInheritOptions) {
+    Logger::setLogLevel(Logger::WARN);
+    EventLoop loop;
+    InetAddress listenAddr(freePort(), true);
+    Acceptor acceptor(&loop, listenAddr, false);
+    acceptor.setTcpNoDelay(true);
+    int noDelay = 0;
+    int keepAlive = 0;
+    acceptor.setNewConnectionCallback([&](int sockfd, const InetAddress &) {
+        socklen_t len = sizeof noDelay;
+        ::getsockopt(sockfd, IPPROTO_TCP, TCP_NODELAY, &noDelay, &len);
+        len = sizeof keepAlive;
+        ::getsockopt(sockfd, SOL_SOCKET, SO_KEEPALIVE, &keepAlive, &len);
+        sockets::close(sockfd);
+        loop.quit();
+    });
+    acceptor.listen();
+
+    std::thread client([&] { ::close(connectTo(listenAddr)); });
+    loop.loop();
+    client.join();
+
+    EXPECT_NE(noDelay, 0);
+    EXPECT_NE(keepAlive, 0);
+}
@@ -0,0 +1,23 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#ifndef GG_LIB_TEST_NET_TESTUTILS_H
+#define GG_LIB_TEST_NET_TESTUTILS_H
+
+#include "gg_lib/net/SocketsHelper.h"
+
+#include <stdint.h>
+
+namespace gg_lib {
+    namespace net {
+        /// A loopback port which was free a moment ago.
+        inline uint16_t freePort() {
+            InetAddress addr(0, true);
+            Socket socket(sockets::createNonblockingOrDie(addr.family()));
+            socket.bindAddress(addr);
+            return InetAddress(sockets::getLocalAddr(socket.fd())).port();
+        }
+    }
+}
+
+#endif //GG_LIB_TEST_NET_TESTUTILS_H
@@ -0,0 +1,75 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#include <benchmark/benchmark.h>
+#include "gg_lib/net/EventLoop.h"
+#include "gg_lib/Logging.h"
+
+#include <vector>
+
+using namespace gg_lib;
+using namespace gg_lib::net;
+
+namespace {
+    /// Idle timeouts of state.range(0) connections, one iteration re-arms
+    /// the timeout of one connection like a message arriving does.
+    void runRearm(benchmark::State &state, TimerQueueType type) {
+        Logger::setLogLevel(Logger::WARN);
+        EventLoop loop(type);
+        const auto numConns = static_cast<size_t>(state.range(0));
+        std::vector<TimerId> timeouts(numConns);
+        for (size_t i = 0; i < numConns; ++i) {
+            timeouts[i] = loop.runAfter(30.0 + i * 0.001, [] {});
+        }
+        size_t next = 0;
+        for (auto _: state) {
+            loop.cancel(timeouts[next]);
+            timeouts[next] = loop.runAfter(30.0, [] {});
+            if (++next == numConns) {
+                next = 0;
+            }
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    /// One iteration adds state.range(0) timers due at once and runs them.
+    void runExpire(benchmark::State &state, TimerQueueType type) {
+        Logger::setLogLevel(Logger::WARN);
+        EventLoop loop(type);
+        const auto numTimers = static_cast<int>(state.range(0));
+        int fired = 0;
+        for (auto _: state) {
+            Timestamp when = Timestamp::addTime(Timestamp::now(), 0.001);
+            for (int i = 0; i < numTimers; ++i) {
+                loop.runAt(when, [&fired] { ++fired; });
+            }
+            loop.runAt(when, [&loop] { loop.quit(); });
+            loop.loop();
+        }
+        benchmark::DoNotOptimize(fired);
+        state.SetItemsProcessed(state.iterations() * numTimers);
+    }
+}
+
+static void BM_HeapRearm(benchmark::State &state) {
+    runRearm(state, kHeapTimerQueue);
+}
+
+static void BM_WheelRearm(benchmark::State &state) {
+    runRearm(state, kWheelTimerQueue);
+}
+
+static void BM_HeapExpire(benchmark::State &state) {
+    runExpire(state, kHeapTimerQueue);
+}
+
+static void BM_WheelExpire(benchmark::State &state) {
+    runExpire(state, kWheelTimerQueue);
+}
+
+BENCHMARK(BM_HeapRearm)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+BENCHMARK(BM_WheelRearm)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+BENCHMARK(BM_HeapExpire)->RangeMultiplier(8)->Range(64, 1 << 15);
+BENCHMARK(BM_WheelExpire)->RangeMultiplier(8)->Range(64, 1 << 15);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,133 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#include <benchmark/benchmark.h>
+#include "gg_lib/net/EventLoop.h"
+#include "gg_lib/net/UdpSocket.h"
+#include "gg_lib/Logging.h"
+
+#include <atomic>
+#include <netinet/udp.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace gg_lib;
+using namespace gg_lib::net;
+
+namespace {
+    constexpr int kDatagrams = 256 * 1024;
+    constexpr size_t kDatagramSize = 64;
+    constexpr int kSendBatch = 64;
+
+    /// Sends kDatagrams to addr, kSendBatch per system call.
+    void sendAll(const InetAddress &addr, bool gso) {
+        int fd = ::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+        char payload[kSendBatch * kDatagramSize];
+        memset(payload, 'x', sizeof payload);
+        struct iovec iovecs[kSendBatch];
+        struct mmsghdr msgs[kSendBatch];
+        memset(msgs, 0, sizeof msgs);
+        for (int i = 0; i < kSendBatch; ++i) {
+            iovecs[i].iov_base = payload + i * kDatagramSize;
+            iovecs[i].iov_len = kDatagramSize;
+            msgs[i].msg_hdr.msg_name = const_cast<struct sockaddr *>(addr.getSockAddr());
+            msgs[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+            msgs[i].msg_hdr.msg_iov = &iovecs[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+        // with GSO, one message carries the whole batch.
+        char control[CMSG_SPACE(sizeof(uint16_t))] = {};
+        struct iovec whole = {payload, sizeof payload};
+        struct msghdr gsoMsg = {};
+        gsoMsg.msg_name = const_cast<struct sockaddr *>(addr.getSockAddr());
+        gsoMsg.msg_namelen = sizeof(struct sockaddr_in);
+        gsoMsg.msg_iov = &whole;
+        gsoMsg.msg_iovlen = 1;
+        gsoMsg.msg_control = control;
+        gsoMsg.msg_controllen = sizeof control;
+        struct cmsghdr *cmsg = CMSG_FIRSTHDR(&gsoMsg);
+        cmsg->cmsg_level = SOL_UDP;
+        cmsg->cmsg_type = UDP_SEGMENT;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+        uint16_t segment = kDatagramSize;
+        memcpy(CMSG_DATA(cmsg), &segment, sizeof segment);
+
+        for (int sent = 0; sent < kDatagrams; sent += kSendBatch) {
+            if (gso) {
+                ::sendmsg(fd, &gsoMsg, 0);
+            } else {
+                ::sendmmsg(fd, msgs, kSendBatch, 0);
+            }
+        }
+        ::close(fd);
+    }
+
+    /// Loopback datagrams received per second, the sender runs in another thread
+    /// and the datagrams the receiver can't keep up with are lost.
+    void runReceive(benchmark::State &state, int recvBatch, bool gro) {
+        Logger::setLogLevel(Logger::WARN);
+        EventLoop loop;
+        auto socket = std::make_shared<UdpSocket>(&loop, InetAddress(0, true));
+        int rcvbuf = 8 * 1024 * 1024;
+        ::setsockopt(socket->fd(), SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof rcvbuf);
+        socket->setRecvBatch(recvBatch, UdpSocket::kDefaultMaxDatagramSize);
+        if (gro && !socket->setGro(true)) {
+            state.SkipWithError("no UDP GRO");
+            return;
+        }
+        int64_t received = 0;
+        socket->setMessageCallback([&received](const UdpSocketPtr &, const UdpDatagram *, int count, Timestamp) {
+            received += count;
+        });
+        socket->start();
+
+        int64_t total = 0;
+        double seconds = 0;
+        for (auto _: state) {
+            received = 0;
+            std::atomic<bool> done(false);
+            int64_t lastReceived = -1;
+            // quits once the sender is done and nothing arrived for a tick.
+            TimerId ticker = loop.runEvery(0.01, [&] {
+                if (done && received == lastReceived) {
+                    loop.quit();
+                }
+                lastReceived = received;
+            });
+            Timestamp start = Timestamp::now();
+            InetAddress addr = socket->localAddress();
+            std::thread sender([&done, addr, gro] {
+                sendAll(addr, gro);
+                done = true;
+            });
+            loop.loop();
+            sender.join();
+            loop.cancel(ticker);
+            seconds += Timestamp::timeDuration(Timestamp::now(), start) - 0.01;
+            total += received;
+        }
+        state.counters["datagrams/s"] = static_cast<double>(total) / seconds;
+        state.counters["received%"] = 100.0 * static_cast<double>(total) / (state.iterations() * kDatagrams);
+        state.counters["datagrams/recv"] = static_cast<double>(socket->numReceived()) / socket->numRecvCalls();
+    }
+}
+
+static void BM_UdpReceiveOneByOne(benchmark::State &state) {
+    runReceive(state, 1, false);
+}
+
+static void BM_UdpReceiveBatched(benchmark::State &state) {
+    runReceive(state, UdpSocket::kDefaultRecvBatch, false);
+}
+
+static void BM_UdpReceiveGsoGro(benchmark::State &state) {
+    runReceive(state, UdpSocket::kDefaultRecvBatch, true);
+}
+
+BENCHMARK(BM_UdpReceiveOneByOne)->Iterations(5)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_UdpReceiveBatched)->Iterations(5)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_UdpReceiveGsoGro)->Iterations(5)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
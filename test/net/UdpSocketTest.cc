@@ -0,0 +1,146 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#include "gg_lib/net/UdpServer.h"
+#include "gg_lib/net/EventLoop.h"
+#include "gg_lib/Logging.h"
+
+#include <atomic>
+
+#include <gtest/gtest.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace gg_lib;
+using namespace gg_lib::net;
+
+TEST(UdpSocketTest, BatchedSendReceive) {
+    Logger::setLogLevel(Logger::WARN);
+    EventLoop loop;
+    auto receiver = std::make_shared<UdpSocket>(&loop, InetAddress(0, true));
+    auto sender = std::make_shared<UdpSocket>(&loop, InetAddress(0, true));
+    constexpr int kDatagrams = 100;
+    std::vector<string> received;
+    receiver->setMessageCallback([&](const UdpSocketPtr &, const UdpDatagram *datagrams, int count, Timestamp) {
+        for (int i = 0; i < count; ++i) {
+            EXPECT_EQ(datagrams[i].peer.port(), sender->localAddress().port());
+            received.emplace_back(datagrams[i].data, datagrams[i].len);
+        }
+        if (received.size() == kDatagrams) {
+            loop.quit();
+        }
+    });
+    receiver->start();
+    sender->start();
+    for (int i = 0; i < kDatagrams; ++i) {
+        string payload = "datagram" + std::to_string(i);
+        EXPECT_TRUE(sender->send(payload.data(), payload.size(), receiver->localAddress()));
+    }
+    sender->flush();
+    loop.runAfter(5.0, [&loop] { loop.quit(); });
+    loop.loop();
+
+    ASSERT_EQ(received.size(), kDatagrams);
+    for (int i = 0; i < kDatagrams; ++i) {
+        EXPECT_EQ(received[i], "datagram" + std::to_string(i));
+    }
+    EXPECT_EQ(sender->numSent(), kDatagrams);
+    // 64 messages per sendmmsg.
+    EXPECT_EQ(sender->numSendCalls(), 2);
+    EXPECT_LT(receiver->numRecvCalls(), kDatagrams);
+}
+
+TEST(UdpSocketTest, GsoGro) {
+    Logger::setLogLevel(Logger::WARN);
+    EventLoop loop;
+    auto receiver = std::make_shared<UdpSocket>(&loop, InetAddress(0, true));
+    auto sender = std::make_shared<UdpSocket>(&loop, InetAddress(0, true));
+    if (!sender->setGso(true) || !receiver->setGro(true)) {
+        GTEST_SKIP() << "no UDP GSO/GRO";
+    }
+    constexpr int kFull = 40;
+    std::vector<string> received;
+    receiver->setMessageCallback([&](const UdpSocketPtr &, const UdpDatagram *datagrams, int count, Timestamp) {
+        for (int i = 0; i < count; ++i) {
+            received.emplace_back(datagrams[i].data, datagrams[i].len);
+        }
+        if (received.size() == kFull + 1) {
+            loop.quit();
+        }
+    });
+    receiver->start();
+    sender->start();
+    for (int i = 0; i < kFull; ++i) {
+        string payload(1000, static_cast<char>('a' + i % 26));
+        sender->send(payload.data(), payload.size(), receiver->localAddress());
+    }
+    // a shorter last segment still shares the message.
+    sender->send("tail", 4, receiver->localAddress());
+    sender->flush();
+    loop.runAfter(5.0, [&loop] { loop.quit(); });
+    loop.loop();
+
+    ASSERT_EQ(received.size(), kFull + 1);
+    for (int i = 0; i < kFull; ++i) {
+        EXPECT_EQ(received[i], string(1000, static_cast<char>('a' + i % 26)));
+    }
+    EXPECT_EQ(received.back(), "tail");
+    EXPECT_EQ(sender->numSendCalls(), 1);
+    EXPECT_EQ(sender->numSent(), kFull + 1);
+}
+
+TEST(UdpSocketTest, SendQueueLimit) {
+    Logger::setLogLevel(Logger::WARN);
+    EventLoop loop;
+    auto socket = std::make_shared<UdpSocket>(&loop, InetAddress(0, true));
+    socket->setSendQueueLimit(100);
+    char payload[60] = {};
+    EXPECT_TRUE(socket->send(payload, sizeof payload, socket->localAddress()));
+    EXPECT_FALSE(socket->send(payload, sizeof payload, socket->localAddress()));
+    EXPECT_EQ(socket->numDropped(), 1);
+    socket->flush();
+    EXPECT_EQ(socket->numSent(), 1);
+    EXPECT_TRUE(socket->send(payload, sizeof payload, socket->localAddress()));
+}
+
+TEST(UdpServerTest, ReusePortPerLoop) {
+    Logger::setLogLevel(Logger::WARN);
+    EventLoop loop;
+    UdpServer server(&loop, InetAddress(0, true), "Echo");
+    server.setThreadNum(2);
+    std::atomic<bool> foreignThread(false);
+    server.setMessageCallback([&](const UdpSocketPtr &socket, const UdpDatagram *datagrams, int count, Timestamp) {
+        if (!socket->getLoop()->isInLoopThread() || socket->getLoop() == &loop) {
+            foreignThread = true;
+        }
+        for (int i = 0; i < count; ++i) {
+            socket->send(datagrams[i].data, datagrams[i].len, datagrams[i].peer);
+        }
+    });
+    server.start();
+    ASSERT_EQ(server.sockets().size(), 2u);
+    EXPECT_EQ(server.sockets()[0]->localAddress().port(), server.sockets()[1]->localAddress().port());
+
+    // flows from many source ports spread over both sockets.
+    constexpr int kClients = 16;
+    const InetAddress serverAddr = server.sockets()[0]->localAddress();
+    int echoed = 0;
+    for (int i = 0; i < kClients; ++i) {
+        int fd = ::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+        struct timeval timeout = {5, 0};
+        ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof timeout);
+        ASSERT_EQ(::sendto(fd, "ping", 4, 0, serverAddr.getSockAddr(), sizeof(struct sockaddr_in)), 4);
+        char buf[16];
+        if (::recv(fd, buf, sizeof buf, 0) == 4) {
+            ++echoed;
+        }
+        ::close(fd);
+    }
+    EXPECT_EQ(echoed, kClients);
+    EXPECT_FALSE(foreignThread);
+    int64_t total = 0;
+    for (auto &socket: server.sockets()) {
+        total += socket->numReceived();
+    }
+    EXPECT_EQ(total, kClients);
+}
@@ -0,0 +1,170 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#include "gg_lib/net/TcpClient.h"
+#include "gg_lib/net/TcpServer.h"
+#include "gg_lib/net/Acceptor.h"
+#include "gg_lib/net/EventLoop.h"
+#include "gg_lib/Logging.h"
+
+#include <gtest/gtest.h>
+#include <fcntl.h>
+#include <stddef.h>
+#include <unistd.h>
+
+using namespace gg_lib;
+using namespace gg_lib::net;
+
+namespace {
+    /// A socket file path for this test process.
+    string socketPath(const char *name) {
+        return fmt::format("/tmp/gg_lib_{}_{}.sock", name, ::getpid());
+    }
+
+    /// Sends message to an echo server at serverAddr and returns what came back.
+    string echo(EventLoop *loop, const InetAddress &serverAddr, int socketType, const string &message) {
+        TcpServer server(loop, serverAddr, "UnixEchoServer", TcpServer::kNoReusePort, socketType);
+        server.setMessageCallback([](const TcpConnectionPtr &conn, Buffer *buf, Timestamp) {
+            conn->send(buf);
+        });
+        server.start();
+
+        TcpClient client(loop, serverAddr, "UnixEchoClient");
+        client.connector()->setSocketType(socketType);
+        string echoed;
+        client.setConnectionCallback([&](const TcpConnectionPtr &conn) {
+            if (conn->connected()) {
+                conn->send(message);
+            } else {
+                loop->quit();
+            }
+        });
+        client.setMessageCallback([&](const TcpConnectionPtr &, Buffer *buf, Timestamp) {
+            echoed += buf->retrieveAllAsString();
+            if (echoed.size() >= message.size()) {
+                client.disconnect();
+            }
+        });
+        client.connect();
+        TimerId timeout = loop->runAfter(5.0, [loop] { loop->quit(); });
+        loop->loop();
+        loop->cancel(timeout);
+        return echoed;
+    }
+}
+
+TEST(UnixSocketTest, Address) {
+    InetAddress path = InetAddress::fromUnixPath("/tmp/gg.sock");
+    EXPECT_EQ(path.family(), AF_UNIX);
+    EXPECT_EQ(path.toIpPort(), "/tmp/gg.sock");
+    EXPECT_EQ(path.port(), 0);
+    EXPECT_EQ(sockets::sockaddrLength(path.getSockAddr()),
+              offsetof(struct sockaddr_un, sun_path) + sizeof "/tmp/gg.sock");
+
+    InetAddress abstract = InetAddress::fromUnixPath("@gg");
+    EXPECT_EQ(abstract.unixPath(), "@gg");
+    // the leading null byte and the name, no terminator.
+    EXPECT_EQ(sockets::sockaddrLength(abstract.getSockAddr()),
+              offsetof(struct sockaddr_un, sun_path) + 3);
+}
+
+TEST(UnixSocketTest, StreamEcho) {
+    Logger::setLogLevel(Logger::WARN);
+    EventLoop loop;
+    const string path = socketPath("stream");
+    InetAddress serverAddr = InetAddress::fromUnixPath(path);
+    {
+        // the file of a server which exited without removing it.
+        Socket stale(sockets::createNonblockingOrDie(AF_UNIX));
+        stale.bindAddress(serverAddr);
+    }
+    ASSERT_EQ(::access(path.c_str(), F_OK), 0);
+
+    EXPECT_EQ(echo(&loop, serverAddr, SOCK_STREAM, "hello unix"), "hello unix");
+    // removed with the server.
+    EXPECT_NE(::access(path.c_str(), F_OK), 0);
+}
+
+TEST(UnixSocketTest, KeepsOtherFiles) {
+    Logger::setLogLevel(Logger::WARN);
+    const string path = socketPath("regular");
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    ASSERT_GE(fd, 0);
+    ::close(fd);
+
+    // refuses connections like a stale socket, but binding over it must fail,
+    // the fatal log goes to stdout.
+    EXPECT_DEATH({
+        EventLoop loop;
+        Acceptor acceptor(&loop, InetAddress::fromUnixPath(path));
+    }, "");
+    EXPECT_EQ(::access(path.c_str(), F_OK), 0);
+    ::unlink(path.c_str());
+}
+
+TEST(UnixSocketTest, SeqPacketEcho) {
+    Logger::setLogLevel(Logger::WARN);
+    EventLoop loop;
+    InetAddress serverAddr = InetAddress::fromUnixPath(fmt::format("@gg_lib_seqpacket_{}", ::getpid()));
+    EXPECT_EQ(echo(&loop, serverAddr, SOCK_SEQPACKET, string(10000, 'r')), string(10000, 'r'));
+}
+
+TEST(UnixSocketTest, PassFds) {
+    Logger::setLogLevel(Logger::WARN);
+    EventLoop loop;
+    InetAddress serverAddr = InetAddress::fromUnixPath(fmt::format("@gg_lib_fds_{}", ::getpid()));
+    TcpServer server(&loop, serverAddr, "FdServer");
+    string received;
+    std::vector<int> fds;
+    server.setConnectionCallback([](const TcpConnectionPtr &conn) {
+        if (conn->connected()) {
+            conn->setReceiveFds(true);
+        }
+    });
+    server.setMessageCallback([&](const TcpConnectionPtr &conn, Buffer *buf, Timestamp) {
+        received += buf->retrieveAllAsString();
+        for (int fd: conn->takeReceivedFds()) {
+            fds.push_back(fd);
+        }
+        if (received == "hello!" && fds.size() == 2) {
+            loop.quit();
+        }
+    });
+    server.start();
+
+    int pipeFds[2];
+    ASSERT_EQ(::pipe(pipeFds), 0);
+    TcpClient client(&loop, serverAddr, "FdClient");
+    client.setConnectionCallback([&](const TcpConnectionPtr &conn) {
+        if (conn->connected()) {
+            conn->send("hello");
+            // sent after the queued bytes, duplicated, so the pipe may be closed.
+            conn->sendFds(pipeFds, 2, "!");
+            ::close(pipeFds[0]);
+            ::close(pipeFds[1]);
+        } else {
+            loop.quit();
+        }
+    });
+    client.connect();
+    TimerId timeout = loop.runAfter(5.0, [&loop] { loop.quit(); });
+    loop.loop();
+    client.disconnect();
+    loop.loop();
+    loop.cancel(timeout);
+    // the connection is destroyed by a functor queued after the disconnect callback.
+    loop.runAfter(0.05, [&loop] { loop.quit(); });
+    loop.loop();
+    EXPECT_FALSE(client.connection());
+
+    ASSERT_EQ(received, "hello!");
+    ASSERT_EQ(fds.size(), 2u);
+    // the passed pipe still works.
+    ASSERT_EQ(::write(fds[1], "ok", 2), 2);
+    char buf[2];
+    ASSERT_EQ(::read(fds[0], buf, sizeof buf), 2);
+    EXPECT_EQ(string(buf, 2), "ok");
+    EXPECT_NE(::fcntl(fds[0], F_GETFD) & FD_CLOEXEC, 0);
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
@@ -0,0 +1,78 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#include "gg_lib/net/EventLoop.h"
+#include "gg_lib/Logging.h"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+using namespace gg_lib;
+using namespace gg_lib::net;
+
+namespace {
+    /// Delays in ms which fall into the first three levels of the wheel.
+    const std::vector<int> kDelays = {5, 1, 30, 100, 70, 300, 65, 4100};
+
+    std::vector<int> runInOrder(TimerQueueType type) {
+        Logger::setLogLevel(Logger::WARN);
+        EventLoop loop(type);
+        std::vector<int> fired;
+        for (int delay: kDelays) {
+            loop.runAfter(delay / 1000.0, [&fired, delay] { fired.push_back(delay); });
+        }
+        loop.runAfter(4.15, [&loop] { loop.quit(); });
+        loop.loop();
+        return fired;
+    }
+}
+
+TEST(WheelTimerQueueTest, Order) {
+    std::vector<int> expected = kDelays;
+    std::sort(expected.begin(), expected.end());
+    EXPECT_EQ(runInOrder(kWheelTimerQueue), expected);
+    EXPECT_EQ(runInOrder(kHeapTimerQueue), expected);
+}
+
+TEST(WheelTimerQueueTest, Cancel) {
+    EventLoop loop(kWheelTimerQueue);
+    bool cancelledFired = false;
+    bool reusedFired = false;
+    TimerId cancelled = loop.runAfter(0.01, [&cancelledFired] { cancelledFired = true; });
+    loop.cancel(cancelled);
+    // the node of the cancelled timer is reused, the stale id must not cancel it.
+    TimerId reused = loop.runAfter(0.02, [&reusedFired] { reusedFired = true; });
+    EXPECT_NE(reused, cancelled);
+    loop.cancel(cancelled);
+
+    int repeats = 0;
+    TimerId every = 0;
+    every = loop.runEvery(0.005, [&] {
+        if (++repeats == 3) {
+            loop.cancel(every);
+        }
+    });
+    loop.runAfter(0.1, [&loop] { loop.quit(); });
+    loop.loop();
+    EXPECT_FALSE(cancelledFired);
+    EXPECT_TRUE(reusedFired);
+    EXPECT_EQ(repeats, 3);
+}
+
+TEST(WheelTimerQueueTest, OtherThread) {
+    EventLoop loop(kWheelTimerQueue);
+    bool cancelledFired = false;
+    bool fired = false;
+    std::thread thread([&] {
+        TimerId timerId = loop.runAfter(0.01, [&cancelledFired] { cancelledFired = true; });
+        loop.cancel(timerId);
+        loop.runAfter(0.02, [&fired] { fired = true; });
+        loop.runAfter(0.05, [&loop] { loop.quit(); });
+    });
+    thread.join();
+    loop.loop();
+    EXPECT_FALSE(cancelledFired);
+    EXPECT_TRUE(fired);
+}
@@ -0,0 +1,138 @@
+// Copyright (c) 2022 shr-go. All rights reserved.
+// Author: shr-go
+
+#include <benchmark/benchmark.h>
+#include "gg_lib/net/SocketsHelper.h"
+#include "gg_lib/Logging.h"
+
+#include <fcntl.h>
+#include <linux/errqueue.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace gg_lib;
+using namespace gg_lib::net;
+
+namespace {
+    /// A connected TCP pair over loopback, the peer drains everything it receives.
+    class LoopbackPair : noncopyable {
+    public:
+        LoopbackPair() {
+            InetAddress listenAddr(0, true);
+            Socket listener(sockets::createNonblockingOrDie(listenAddr.family()));
+            listener.bindAddress(listenAddr);
+            listener.listen();
+            struct sockaddr_in6 addr = sockets::getLocalAddr(listener.fd());
+            sender_ = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+            if (::connect(sender_, sockets::sockaddr_cast(&addr), sizeof addr) < 0) {
+                LOG_SYSFATAL << "connect";
+            }
+            struct pollfd pfd = {listener.fd(), POLLIN, 0};
+            ::poll(&pfd, 1, -1);
+            InetAddress peerAddr;
+            receiver_ = listener.accept(&peerAddr);
+            // the drainer blocks in read instead of spinning.
+            ::fcntl(receiver_, F_SETFL, ::fcntl(receiver_, F_GETFL) & ~O_NONBLOCK);
+            drainer_ = std::thread([this] {
+                char buf[1024 * 1024];
+                while (sockets::read(receiver_, buf, sizeof buf) != 0) {
+                }
+            });
+        }
+
+        ~LoopbackPair() {
+            ::close(sender_);
+            drainer_.join();
+            ::close(receiver_);
+        }
+
+        int sender() const { return sender_; }
+
+    private:
+        int sender_;
+        int receiver_;
+        std::thread drainer_;
+    };
+
+    /// Reaps zero-copy notifications, returns the number of sends reported.
+    uint32_t reap(int fd, bool wait, bool *copied) {
+        uint32_t reported = 0;
+        if (wait) {
+            struct pollfd pfd = {fd, 0, 0};
+            ::poll(&pfd, 1, -1);
+        }
+        while (true) {
+            char control[128];
+            struct msghdr msg{};
+            msg.msg_control = control;
+            msg.msg_controllen = sizeof control;
+            if (::recvmsg(fd, &msg, MSG_ERRQUEUE | MSG_DONTWAIT) < 0) {
+                return reported;
+            }
+            for (struct cmsghdr *cm = CMSG_FIRSTHDR(&msg); cm; cm = CMSG_NXTHDR(&msg, cm)) {
+                auto *err = reinterpret_cast<const struct sock_extended_err *>(CMSG_DATA(cm));
+                if (err->ee_origin == SO_EE_ORIGIN_ZEROCOPY) {
+                    reported += err->ee_data - err->ee_info + 1;
+                    *copied = *copied || (err->ee_code & SO_EE_CODE_ZEROCOPY_COPIED);
+                }
+            }
+        }
+    }
+
+    /// One iteration sends a frame of state.range(0) bytes on a blocking socket.
+    void runSend(benchmark::State &state, bool zeroCopy) {
+        Logger::setLogLevel(Logger::WARN);
+        const auto frameSize = static_cast<size_t>(state.range(0));
+        const string frame(frameSize, 'z');
+        LoopbackPair pair;
+        int fd = pair.sender();
+        int on = 1;
+        if (zeroCopy && ::setsockopt(fd, SOL_SOCKET, SO_ZEROCOPY, &on, sizeof on) < 0) {
+            state.SkipWithError("SO_ZEROCOPY is not supported");
+            return;
+        }
+        uint32_t sent = 0;
+        uint32_t reported = 0;
+        bool copied = false;
+        for (auto _: state) {
+            size_t offset = 0;
+            while (offset < frameSize) {
+                ssize_t n = ::send(fd, frame.data() + offset, frameSize - offset,
+                                   zeroCopy ? MSG_ZEROCOPY : 0);
+                if (n > 0) {
+                    offset += static_cast<size_t>(n);
+                    sent += zeroCopy ? 1 : 0;
+                } else if (errno == ENOBUFS) {
+                    reported += reap(fd, true, &copied);
+                } else {
+                    LOG_SYSFATAL << "send";
+                }
+            }
+            if (zeroCopy) {
+                reported += reap(fd, false, &copied);
+            }
+        }
+        while (reported < sent) {
+            reported += reap(fd, true, &copied);
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * frameSize));
+        if (zeroCopy) {
+            state.counters["kernel_copied"] = copied ? 1 : 0;
+        }
+    }
+}
+
+static void BM_CopySend(benchmark::State &state) {
+    runSend(state, false);
+}
+
+static void BM_ZeroCopySend(benchmark::State &state) {
+    runSend(state, true);
+}
+
+BENCHMARK(BM_CopySend)->RangeMultiplier(4)->Range(4 << 10, 4 << 20);
+BENCHMARK(BM_ZeroCopySend)->RangeMultiplier(4)->Range(4 << 10, 4 << 20);
+
+BENCHMARK_MAIN();